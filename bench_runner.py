@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+C++ Mastery Benchmark Runner
+Usage: python3 bench_runner.py [options] <benchmark executable>...
+
+Runs google-benchmark executables, merges their results into
+<out-dir>/results.json and compares each benchmark's median real time
+against a saved baseline. Exits 1 when any benchmark is slower than the
+baseline by more than --threshold (a fraction, 0.10 = 10%).
+
+Normally invoked through the `bench` / `bench-baseline` CMake targets.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+from datetime import datetime
+
+TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def run_executable(exe, out_dir, repetitions, benchmark_filter):
+    """Run one benchmark binary, return {name: {"real_time_ns", "cpu_time_ns"}}"""
+    name = os.path.splitext(os.path.basename(exe))[0]
+    raw_path = os.path.join(out_dir, name + ".json")
+    cmd = [
+        exe,
+        "--benchmark_out=" + raw_path,
+        "--benchmark_out_format=json",
+        "--benchmark_repetitions=%d" % repetitions,
+        "--benchmark_report_aggregates_only=true",
+    ]
+    if benchmark_filter:
+        cmd.append("--benchmark_filter=" + benchmark_filter)
+    print("==> " + " ".join(cmd), flush=True)
+    subprocess.run(cmd, check=True)
+
+    with open(raw_path, "r") as f:
+        raw = json.load(f)
+
+    results = {}
+    for entry in raw.get("benchmarks", []):
+        # With repetitions > 1 only aggregates are reported; keep the median.
+        if entry.get("run_type") == "aggregate" and entry.get("aggregate_name") != "median":
+            continue
+        scale = TIME_UNIT_NS.get(entry.get("time_unit", "ns"), 1.0)
+        key = name + "/" + entry.get("run_name", entry["name"])
+        results[key] = {
+            "real_time_ns": entry["real_time"] * scale,
+            "cpu_time_ns": entry["cpu_time"] * scale,
+        }
+    return results
+
+
+def compare(current, baseline, threshold):
+    """Print a comparison table, return the list of regressed benchmark names"""
+    regressions = []
+    width = max([len(k) for k in current] + [9])
+    print("\n%-*s %14s %14s %9s" % (width, "benchmark", "baseline(ns)", "current(ns)", "change"))
+    for key in sorted(current):
+        now = current[key]["real_time_ns"]
+        if key not in baseline:
+            print("%-*s %14s %14.1f %9s" % (width, key, "-", now, "new"))
+            continue
+        before = baseline[key]["real_time_ns"]
+        change = (now - before) / before if before > 0 else 0.0
+        flag = ""
+        if change > threshold:
+            flag = "  REGRESSION"
+            regressions.append(key)
+        print("%-*s %14.1f %14.1f %+8.1f%%%s" % (width, key, before, now, change * 100, flag))
+    for key in sorted(set(baseline) - set(current)):
+        print("%-*s %14.1f %14s %9s" % (width, key, baseline[key]["real_time_ns"], "-", "missing"))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run benchmarks and check for regressions")
+    parser.add_argument("executables", nargs="+")
+    parser.add_argument("--out-dir", default="bench-results")
+    parser.add_argument("--baseline", default="benchmarks/baseline.json")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="allowed slowdown as a fraction (default 0.10)")
+    parser.add_argument("--repetitions", type=int, default=5)
+    parser.add_argument("--filter", default="", help="passed as --benchmark_filter")
+    parser.add_argument("--update-baseline", action="store_true",
+                        help="save this run as the new baseline instead of comparing")
+    args = parser.parse_args()
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    current = {}
+    for exe in args.executables:
+        current.update(run_executable(exe, args.out_dir, args.repetitions, args.filter))
+
+    report = {
+        "date": datetime.now().isoformat(timespec="seconds"),
+        "repetitions": args.repetitions,
+        "benchmarks": current,
+    }
+    results_path = os.path.join(args.out_dir, "results.json")
+    with open(results_path, "w") as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+    print("\nResults written to " + results_path)
+
+    if args.update_baseline:
+        os.makedirs(os.path.dirname(os.path.abspath(args.baseline)), exist_ok=True)
+        with open(args.baseline, "w") as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+        print("Baseline saved to " + args.baseline)
+        return 0
+
+    if not os.path.exists(args.baseline):
+        print("No baseline at %s; run the bench-baseline target to create one" % args.baseline)
+        return 0
+
+    with open(args.baseline, "r") as f:
+        baseline = json.load(f).get("benchmarks", {})
+
+    regressions = compare(current, baseline, args.threshold)
+    if regressions:
+        print("\n%d benchmark(s) regressed by more than %.1f%%:" %
+              (len(regressions), args.threshold * 100))
+        for key in regressions:
+            print("  " + key)
+        return 1
+    print("\nNo regressions above %.1f%%" % (args.threshold * 100))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
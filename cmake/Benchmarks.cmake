@@ -0,0 +1,63 @@
+# Benchmark registration and regression runner.
+#
+# Each week registers its google-benchmark executables with
+# register_benchmark(<target>). add_bench_runner_targets() then defines:
+#   bench           - build every registered benchmark, run it through
+#                     bench_runner.py, store JSON results and fail when a
+#                     benchmark is slower than the baseline by more than
+#                     BENCH_THRESHOLD
+#   bench-baseline  - same run, but save the results as the new baseline
+#
+# Included from the top-level CMakeLists.txt and from each week's
+# CMakeLists.txt so standalone week builds get the same targets.
+
+include_guard(GLOBAL)
+
+set(BENCH_BASELINE "${CMAKE_CURRENT_LIST_DIR}/../benchmarks/baseline.json"
+    CACHE FILEPATH "Saved benchmark results that bench compares against")
+set(BENCH_THRESHOLD "0.10"
+    CACHE STRING "Allowed slowdown vs baseline before bench fails (0.10 = 10%)")
+set(BENCH_REPETITIONS "5"
+    CACHE STRING "Repetitions per benchmark; the median is compared")
+
+set(BENCH_RUNNER "${CMAKE_CURRENT_LIST_DIR}/../bench_runner.py")
+
+function(register_benchmark target)
+  set_property(GLOBAL APPEND PROPERTY CPP_MASTERY_BENCHMARKS ${target})
+endfunction()
+
+function(add_bench_runner_targets)
+  if(TARGET bench)
+    return()
+  endif()
+  get_property(bench_targets GLOBAL PROPERTY CPP_MASTERY_BENCHMARKS)
+  if(NOT bench_targets)
+    return()
+  endif()
+  find_package(Python3 COMPONENTS Interpreter REQUIRED)
+
+  set(bench_exes "")
+  foreach(bench_target ${bench_targets})
+    list(APPEND bench_exes "$<TARGET_FILE:${bench_target}>")
+  endforeach()
+
+  set(runner_args
+    --out-dir ${CMAKE_BINARY_DIR}/bench-results
+    --baseline ${BENCH_BASELINE}
+    --threshold ${BENCH_THRESHOLD}
+    --repetitions ${BENCH_REPETITIONS}
+  )
+
+  add_custom_target(bench
+    COMMAND ${Python3_EXECUTABLE} ${BENCH_RUNNER} ${runner_args} ${bench_exes}
+    DEPENDS ${bench_targets}
+    USES_TERMINAL
+    COMMENT "Running benchmarks and comparing against ${BENCH_BASELINE}"
+  )
+  add_custom_target(bench-baseline
+    COMMAND ${Python3_EXECUTABLE} ${BENCH_RUNNER} ${runner_args} --update-baseline ${bench_exes}
+    DEPENDS ${bench_targets}
+    USES_TERMINAL
+    COMMENT "Running benchmarks and saving ${BENCH_BASELINE}"
+  )
+endfunction()
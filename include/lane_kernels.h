@@ -0,0 +1,248 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Lane-generic exp / log / erfc kernels (double precision)
+ *
+ * Shared by week-3/src/simd_math.cpp and quant-interview/medium (through
+ * lane_math.h); builds as C++17.
+ *
+ * - Every function is a template over its lane type: plain double, or a
+ *   GCC vector of 2 / 4 / 8 doubles (one SSE2 / AVX2 / AVX-512 register)
+ * - Everything is always_inline and carries no target attribute, so it
+ *   compiles to the ISA of the kernel that inlines it
+ * - Helpers pass wide vectors by value but are always inlined, so the
+ *   vector calling convention never applies. GCC's -Wpsabi note about it
+ *   comes from the instantiating source, out of reach of a pragma here, so
+ *   those sources build with -Wno-psabi
+ *
+ * Algorithms (coefficients are Chebyshev fits computed with mpmath at 50
+ * digits; fit errors are below 1e-17 relative):
+ * - exp: x = n ln2 + r with a two-part ln2 (Cody-Waite), |r| <= ln2/2,
+ *   degree-11 polynomial, then 2^n applied as two halves so that
+ *   subnormal results round correctly
+ * - log: x = 2^e m with m in [sqrt(2)/2, sqrt(2)), f = m - 1, s = f/(2+f),
+ *   log(1+f) = f - f^2/2 + s (f^2/2 + R(s^2)) (fdlibm's reduction and
+ *   coefficients)
+ * - erfc (y >= 0.5): exp(-y^2) Q(y) with Q a polynomial in y on [0.5, 1),
+ *   [1, 2) and [2, 3) and (1/y) R(1/y^2) beyond. y^2 is split into an
+ *   exact head and tail (Dekker), so exp(-y^2) does not inherit the
+ *   rounding error of y*y; ERF_SMALL covers erf below that range
+ */
+
+namespace lane_math {
+
+#define LANE_INLINE inline __attribute__((always_inline))
+
+typedef double Double2 __attribute__((vector_size(16)));
+typedef double Double4 __attribute__((vector_size(32)));
+typedef double Double8 __attribute__((vector_size(64)));
+typedef int64_t Int2 __attribute__((vector_size(16)));
+typedef int64_t Int4 __attribute__((vector_size(32)));
+typedef int64_t Int8 __attribute__((vector_size(64)));
+typedef uint64_t UInt2 __attribute__((vector_size(16)));
+typedef uint64_t UInt4 __attribute__((vector_size(32)));
+typedef uint64_t UInt8 __attribute__((vector_size(64)));
+
+// Integer lanes matching a double lane type.
+template <typename D>
+struct LaneInts;
+template <>
+struct LaneInts<double> {
+  using Int = int64_t;
+  using UInt = uint64_t;
+};
+template <>
+struct LaneInts<Double2> {
+  using Int = Int2;
+  using UInt = UInt2;
+};
+template <>
+struct LaneInts<Double4> {
+  using Int = Int4;
+  using UInt = UInt4;
+};
+template <>
+struct LaneInts<Double8> {
+  using Int = Int8;
+  using UInt = UInt8;
+};
+
+template <typename D>
+LANE_INLINE D splat(double c) {
+  return D{} + c;
+}
+
+template <typename To, typename From>
+LANE_INLINE To bitsAs(From from) {
+  static_assert(sizeof(To) == sizeof(From), "lane types must have the same width");
+  To to;
+  std::memcpy(&to, &from, sizeof(to));
+  return to;
+}
+
+template <typename D, size_t N>
+LANE_INLINE D horner(const double (&c)[N], D x) {
+  D acc = splat<D>(c[0]);
+  for (size_t k = 1; k < N; ++k) acc = acc * x + c[k];
+  return acc;
+}
+
+template <typename D>
+LANE_INLINE D copySign(D magnitude, D sign) {
+  using Int = typename LaneInts<D>::Int;
+  constexpr int64_t SIGN = INT64_MIN;
+  return bitsAs<D>((bitsAs<Int>(magnitude) & ~SIGN) | (bitsAs<Int>(sign) & SIGN));
+}
+
+// Non-negative integer-valued lanes (< 2^52) to double.
+template <typename D, typename I>
+LANE_INLINE D smallIntToDouble(I i) {
+  constexpr double TWO52 = 0x1p52;
+  return bitsAs<D>(i | bitsAs<I>(splat<D>(TWO52))) - TWO52;
+}
+
+// ------------------------------------------------------------------- exp
+
+constexpr double LOG2E = 1.4426950408889634;
+constexpr double LN2_HI = 6.93147180369123816490e-01;  // Trailing zeros: n * LN2_HI is exact
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double EXP_OVERFLOW = 709.782712893384;     // Above: +inf
+constexpr double EXP_UNDERFLOW = -745.1332191019412;  // Below: 0
+
+constexpr double EXP_POLY[12] = {
+    2.5110037605963777e-08, 2.763263963904103e-07, 2.755724091857897e-06, 2.4801485482328494e-05,
+    0.00019841269890047113, 0.0013888888952314775, 0.008333333333319601,  0.0416666666664881,
+    0.1666666666666668,     0.5000000000000019,    1.0,                   1.0};
+
+template <typename D>
+LANE_INLINE D expLanes(D x) {
+  using UInt = typename LaneInts<D>::UInt;
+  constexpr double SHIFTER = 0x1.8p52;  // Adding it rounds to an integer
+  const D clamped = x < EXP_UNDERFLOW - 1 ? splat<D>(EXP_UNDERFLOW - 1)
+                                          : (x > EXP_OVERFLOW + 1 ? splat<D>(EXP_OVERFLOW + 1) : x);
+  const D t = clamped * LOG2E + SHIFTER;
+  const D n = t - SHIFTER;
+  // Integer arithmetic on the exponent bits is done unsigned (wraps
+  // harmlessly for the NaN lanes that are discarded at the end).
+  const UInt ni = bitsAs<UInt>(t) - bitsAs<UInt>(splat<D>(SHIFTER));
+  D r = clamped - n * LN2_HI;
+  r = r - n * LN2_LO;
+  const D p = horner(EXP_POLY, r);
+  // n is in [-1077, 1025]; split it into two halves within the normal
+  // exponent range (the bias keeps the shifted value non-negative).
+  const UInt half = ((ni + 1100) >> 1) - 550;
+  const D scale1 = bitsAs<D>((half + 1023) << 52);
+  const D scale2 = bitsAs<D>((ni - half + 1023) << 52);
+  const D result = p * scale1 * scale2;
+  const D inf = splat<D>(__builtin_inf());
+  return x > EXP_OVERFLOW ? inf : (x < EXP_UNDERFLOW ? splat<D>(0.0) : result);
+}
+
+// ------------------------------------------------------------------- log
+
+constexpr double LG[7] = {1.479819860511658591e-01, 1.531383769920937332e-01,
+                          1.818357216161805012e-01, 2.222219843214978396e-01,
+                          2.857142874366239149e-01, 3.999999999940941908e-01,
+                          6.666666666666735130e-01};
+
+template <typename D>
+LANE_INLINE D logLanes(D x) {
+  using Int = typename LaneInts<D>::Int;
+  using UInt = typename LaneInts<D>::UInt;
+  constexpr double MIN_NORMAL = 0x1p-1022;
+  constexpr int64_t MANTISSA = (int64_t{1} << 52) - 1;
+  // Subnormals: scale into the normal range first.
+  const auto subnormal = x < MIN_NORMAL;
+  const D scaled = subnormal ? x * 0x1p54 : x;
+  const Int bits = bitsAs<Int>(scaled);
+  const Int biased = bitsAs<Int>(bitsAs<UInt>(bits) >> 52) & 0x7ff;
+  D m = bitsAs<D>((bits & MANTISSA) | bitsAs<Int>(splat<D>(1.0)));  // [1, 2)
+  const auto above = m > 1.4142135623730951;
+  m = above ? m * 0.5 : m;
+  const D e = smallIntToDouble<D>(biased) - 1023 + (above ? splat<D>(1.0) : splat<D>(0.0)) -
+              (subnormal ? splat<D>(54.0) : splat<D>(0.0));
+
+  const D f = m - 1.0;
+  const D s = f / (f + 2.0);
+  const D z = s * s;
+  const D w = z * z;
+  // R(z) = LG[6] z + LG[5] z^2 + ... split into even and odd powers of z.
+  const D t1 = w * (LG[5] + w * (LG[3] + w * LG[1]));
+  const D t2 = z * (LG[6] + w * (LG[4] + w * (LG[2] + w * LG[0])));
+  const D hfsq = 0.5 * f * f;
+  const D result = e * LN2_HI - ((hfsq - (s * (hfsq + t1 + t2) + e * LN2_LO)) - f);
+
+  const D nan = splat<D>(__builtin_nan(""));
+  const D inf = splat<D>(__builtin_inf());
+  // x < 0 and NaN give NaN, 0 gives -inf, +inf stays. (Nested selects:
+  // GCC scalarizes a & of two 512-bit masks.)
+  const D positive = x == inf ? inf : result;
+  return x > 0.0 ? positive : (x == 0.0 ? -inf : nan);
+}
+
+// ------------------------------------------------------------ erf / erfc
+
+// erf(x) / x as a polynomial in x^2, for |x| < 1.
+constexpr double ERF_SMALL[12] = {
+    -7.795898827002142e-10, 1.3720064546777686e-08, -1.6208483801871705e-07,
+    1.6447424703317362e-06, -1.492473690741966e-05, 0.00012055294904839707,
+    -0.0008548325975389692, 0.0052239776071164225,  -0.02686617064323777,
+    0.11283791670945006,    -0.37612638903183543,   1.1283791670955126};
+
+// erfc(y) exp(y^2) as polynomials in y - 0.75 on [0.5, 1), y - 1.5 on
+// [1, 2) and y - 2.5 on [2, 3).
+constexpr double ERFC_HALF_1[14] = {
+    -1.440376961255891e-05, 4.337915907561481e-05,  -0.00012332717214560827,
+    0.00034666379283020214, -0.000938513222881505,  0.002437641069942269,
+    -0.006051532271776434,  0.01428919858470859,    -0.031897262039946896,
+    0.06679054252841538,    -0.12983606199488007,   0.23095813155129497,
+    -0.3679726916557954,    0.5069376502931449};
+constexpr double ERFC_1_2[17] = {
+    1.3242541506849586e-08,  -4.9545807838901603e-08, 1.6714292901928126e-07,
+    -5.944961119917664e-07,  2.0670657912156654e-06,  -6.97536222785843e-06,
+    2.2864299608127746e-05,  -7.265887301589559e-05,  0.0002233099453004411,
+    -0.0006619300701084315,  0.0018861348769919975,   -0.0051459575478377826,
+    0.013377340953067394,    -0.03293090529956527,    0.0761510398554774,
+    -0.16362291773256005,    0.3215854164543175};
+constexpr double ERFC_2_3[15] = {
+    4.010268793982498e-09,  -1.7022233265672403e-08, 6.706690790495327e-08,
+    -2.7262986241901926e-07, 1.0852366992052668e-06, -4.214357879841587e-06,
+    1.5961851696601105e-05, -5.8868958345706055e-05, 0.00021101982436023977,
+    -0.0007335909374729658, 0.002467036815699688,    -0.008001569382093874,
+    0.024937997086656914,   -0.07434734678979472,    0.2108063640611436};
+// erfc(y) y exp(y^2) as a polynomial in 1/y^2, for y >= 3.
+constexpr double ERFC_TAIL[18] = {
+    -2187824120.8682837, 2391412202.8141727, -1226724879.014636, 395006556.3193973,
+    -90476065.71151927,  15947391.998864112, -2309900.428897324, 294235.6458614024,
+    -35543.16392491497,  4397.372622136059,  -594.0973365400058, 91.61154221934697,
+    -16.660931007573087, 3.702491860506737,  -1.0578554582070976, 0.4231421876328595,
+    -0.2820947917738496, 0.5641895835477563};
+
+// x * x as hi + lo exactly (Dekker; needs no FMA).
+template <typename D>
+LANE_INLINE void squareExact(D x, D& hi, D& lo) {
+  const D c = x * 134217729.0;  // 2^27 + 1
+  const D xh = c - (c - x);
+  const D xl = x - xh;
+  hi = x * x;
+  lo = ((xh * xh - hi) + 2.0 * xh * xl) + xl * xl;
+}
+
+// erfc(y) for y >= 0.5, given y^2 = sq_hi + sq_lo. Lanes with smaller y
+// are evaluated too (and discarded by the caller).
+template <typename D>
+LANE_INLINE D erfcTail(D y, D sq_hi, D sq_lo) {
+  const D q01 = horner(ERFC_HALF_1, y - 0.75);
+  const D q12 = horner(ERFC_1_2, y - 1.5);
+  const D q23 = horner(ERFC_2_3, y - 2.5);
+  const D inv = 1.0 / y;
+  const D tail = inv * horner(ERFC_TAIL, inv * inv);
+  const D q = y < 1.0 ? q01 : (y < 2.0 ? q12 : (y < 3.0 ? q23 : tail));
+  // exp(-(hi + lo)) = exp(-hi) (1 - lo) since |lo| <= ulp(hi) / 2.
+  return expLanes(-sq_hi) * (1.0 - sq_lo) * q;
+}
+
+}  // namespace lane_math
@@ -0,0 +1,186 @@
+#include "../include/batch_pricing.h"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+/**
+ * Options per second for full-chain repricing. Each iteration prices the
+ * call, the put and all ten outputs for every option in the chain
+ * (items_per_second = options/sec).
+ * - BM_PriceChain: priceChain, args {chain size, threads}; wall time, so
+ *   thread scaling shows directly
+ * - BM_ScalarLoop: the same outputs one option at a time with libm
+ *   (std::erfc / exp / log), the per-call baseline
+ * - BM_ImpliedVolChain: impliedVolChain on the out-of-the-money side of
+ *   the same chain priced at its own vols, args {chain size, threads};
+ *   latency is wall time per option, iters_per_option and converged come
+ *   from ImpliedVolStats
+ * - BM_ImpliedVolScalar: plain Newton on price / vega from a flat 0.2
+ *   guess with libm, one quote at a time, the per-call baseline
+ * Chains mix strikes, vols, rates and expiries so no lane takes a
+ * uniform branch.
+ */
+
+static OptionChain makeChain(size_t size) {
+  OptionChain chain;
+  for (size_t i = 0; i < size; ++i) {
+    chain.spot.push_back(100.0);
+    chain.strike.push_back(50.0 + 0.5 * static_cast<double>(i % 201));
+    chain.rate.push_back(0.01 + 0.005 * static_cast<double>(i % 7));
+    chain.vol.push_back(0.1 + 0.03 * static_cast<double>(i % 13));
+    chain.expiry.push_back(0.02 + 0.2 * static_cast<double>(i % 11));
+  }
+  return chain;
+}
+
+static void BM_PriceChain(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  const auto threads = static_cast<unsigned>(state.range(1));
+  if (threads > std::thread::hardware_concurrency()) {
+    state.SkipWithError("more threads than hardware threads");
+    return;
+  }
+  const OptionChain chain = makeChain(size);
+  ChainGreeks out;
+  for (auto _ : state) {
+    priceChain(chain, out, threads);
+    benchmark::DoNotOptimize(out.call.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_PriceChain)
+    ->ArgsProduct({{1 << 10, 100000, 1000000}, {1, 2, 4, 8}})
+    ->UseRealTime();
+
+static void BM_ScalarLoop(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  const OptionChain chain = makeChain(size);
+  ChainGreeks out;
+  for (std::vector<double>* column :
+       {&out.call, &out.put, &out.callDelta, &out.putDelta, &out.gamma, &out.vega, &out.callTheta,
+        &out.putTheta, &out.callRho, &out.putRho}) {
+    column->resize(size);
+  }
+  const auto cdf = [](double x) { return 0.5 * std::erfc(-x * M_SQRT1_2); };
+  for (auto _ : state) {
+    for (size_t i = 0; i < size; ++i) {
+      const double s = chain.spot[i], k = chain.strike[i], r = chain.rate[i];
+      const double vol = chain.vol[i], t = chain.expiry[i];
+      const double sqrt_t = std::sqrt(t);
+      const double vol_sqrt_t = vol * sqrt_t;
+      const double kd = k * std::exp(-r * t);
+      const double d1 = (std::log(s / k) + (r + 0.5 * vol * vol) * t) / vol_sqrt_t;
+      const double d2 = d1 - vol_sqrt_t;
+      const double n_d1 = cdf(d1), n_minus_d1 = cdf(-d1), n_d2 = cdf(d2), n_minus_d2 = cdf(-d2);
+      const double s_pdf = s * std::exp(-0.5 * d1 * d1) * 0.3989422804014327;
+      const double decay = -0.5 * s_pdf * vol / sqrt_t;
+      out.call[i] = s * n_d1 - kd * n_d2;
+      out.put[i] = kd * n_minus_d2 - s * n_minus_d1;
+      out.callDelta[i] = n_d1;
+      out.putDelta[i] = -n_minus_d1;
+      out.gamma[i] = s_pdf / (s * s * vol_sqrt_t);
+      out.vega[i] = s_pdf * sqrt_t;
+      out.callTheta[i] = decay - r * kd * n_d2;
+      out.putTheta[i] = decay + r * kd * n_minus_d2;
+      out.callRho[i] = t * kd * n_d2;
+      out.putRho[i] = -t * kd * n_minus_d2;
+    }
+    benchmark::DoNotOptimize(out.call.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+BENCHMARK(BM_ScalarLoop)->Arg(1 << 10)->Arg(100000);
+
+// Out-of-the-money quotes (the side a surface is fitted from) at the
+// chain's own vols.
+static std::vector<double> makeQuotes(const OptionChain& chain, std::vector<uint8_t>& isCall) {
+  ChainGreeks out;
+  priceChain(chain, out);
+  std::vector<double> prices(chain.size());
+  isCall.resize(chain.size());
+  for (size_t i = 0; i < chain.size(); ++i) {
+    isCall[i] = chain.strike[i] >= chain.spot[i] * std::exp(chain.rate[i] * chain.expiry[i]);
+    prices[i] = isCall[i] ? out.call[i] : out.put[i];
+  }
+  return prices;
+}
+
+static void BM_ImpliedVolChain(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  const auto threads = static_cast<unsigned>(state.range(1));
+  if (threads > std::thread::hardware_concurrency()) {
+    state.SkipWithError("more threads than hardware threads");
+    return;
+  }
+  const OptionChain chain = makeChain(size);
+  std::vector<uint8_t> is_call;
+  const std::vector<double> prices = makeQuotes(chain, is_call);
+  std::vector<double> vols;
+  ImpliedVolStats stats;
+  for (auto _ : state) {
+    impliedVolChain(chain, prices, is_call, vols, threads, &stats);
+    benchmark::DoNotOptimize(vols.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+  state.counters["latency"] = benchmark::Counter(
+      static_cast<double>(size),
+      benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+  state.counters["iters_per_option"] =
+      static_cast<double>(stats.iterations) / static_cast<double>(stats.options);
+  state.counters["converged"] =
+      static_cast<double>(stats.converged) / static_cast<double>(stats.options);
+}
+BENCHMARK(BM_ImpliedVolChain)
+    ->ArgsProduct({{1 << 10, 100000}, {1, 2, 4, 8}})
+    ->UseRealTime();
+
+static void BM_ImpliedVolScalar(benchmark::State& state) {
+  const auto size = static_cast<size_t>(state.range(0));
+  const OptionChain chain = makeChain(size);
+  std::vector<uint8_t> is_call;
+  const std::vector<double> prices = makeQuotes(chain, is_call);
+  std::vector<double> vols(size);
+  const auto cdf = [](double x) { return 0.5 * std::erfc(-x * M_SQRT1_2); };
+  size_t iterations = 0, converged = 0;
+  for (auto _ : state) {
+    iterations = converged = 0;
+    for (size_t i = 0; i < size; ++i) {
+      const double s = chain.spot[i], k = chain.strike[i], r = chain.rate[i];
+      const double t = chain.expiry[i], sqrt_t = std::sqrt(t);
+      const double kd = k * std::exp(-r * t);
+      double vol = 0.2;
+      for (int n = 0; n < IMPLIED_VOL_MAX_ITERATIONS; ++n) {
+        ++iterations;
+        const double d1 = (std::log(s / k) + (r + 0.5 * vol * vol) * t) / (vol * sqrt_t);
+        const double d2 = d1 - vol * sqrt_t;
+        const double price =
+            is_call[i] ? s * cdf(d1) - kd * cdf(d2) : kd * cdf(-d2) - s * cdf(-d1);
+        const double vega = s * std::exp(-0.5 * d1 * d1) * 0.3989422804014327 * sqrt_t;
+        const double step = (price - prices[i]) / vega;
+        vol -= step;
+        if (!(vol > 0.0)) vol = 1e-4;  // Overshoot below 0: restart small
+        if (std::fabs(step) <= 1e-12 * vol) {
+          ++converged;
+          break;
+        }
+      }
+      vols[i] = vol;
+    }
+    benchmark::DoNotOptimize(vols.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+  state.counters["latency"] = benchmark::Counter(
+      static_cast<double>(size),
+      benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+  state.counters["iters_per_option"] =
+      static_cast<double>(iterations) / static_cast<double>(size);
+  state.counters["converged"] = static_cast<double>(converged) / static_cast<double>(size);
+}
+BENCHMARK(BM_ImpliedVolScalar)->Arg(1 << 10)->Arg(100000);
+
+BENCHMARK_MAIN();
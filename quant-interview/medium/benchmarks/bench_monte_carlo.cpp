@@ -0,0 +1,70 @@
+#include "../include/monte_carlo.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
+/**
+ * Paths per second for the Monte Carlo engine (items_per_second = paths/sec)
+ * - BM_MonteCarloEuropean: one step per path, args {paths, threads};
+ *   wall time, so thread scaling shows directly
+ * - BM_MonteCarloAsian: 64 monitoring dates, args {paths, threads};
+ *   path_steps is simulated steps per second
+ * - BM_ScalarEuropean: std::mt19937_64 + std::normal_distribution and
+ *   libm, one path at a time, the single-threaded baseline
+ */
+
+static const GbmModel MODEL{100.0, 0.05, 0.2, 1.0};
+
+static void runEngine(benchmark::State& state, const Payoff& payoff, int steps) {
+  const auto threads = static_cast<unsigned>(state.range(1));
+  if (threads > std::thread::hardware_concurrency()) {
+    state.SkipWithError("more threads than hardware threads");
+    return;
+  }
+  MonteCarloConfig config;
+  config.paths = static_cast<size_t>(state.range(0));
+  config.steps = steps;
+  config.threads = threads;
+  MonteCarloResult result;
+  for (auto _ : state) {
+    monteCarloPrice(MODEL, config, payoff, result);
+    benchmark::DoNotOptimize(result.price);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["path_steps"] =
+      benchmark::Counter(static_cast<double>(config.paths) * steps,
+                         benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["std_error"] = result.standardError;
+}
+
+static void BM_MonteCarloEuropean(benchmark::State& state) {
+  runEngine(state, europeanPayoff(100.0, true), 1);
+}
+BENCHMARK(BM_MonteCarloEuropean)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+
+static void BM_MonteCarloAsian(benchmark::State& state) {
+  runEngine(state, asianPayoff(100.0, true), 64);
+}
+BENCHMARK(BM_MonteCarloAsian)->ArgsProduct({{1 << 16}, {1, 2, 4, 8}})->UseRealTime();
+
+static void BM_ScalarEuropean(benchmark::State& state) {
+  const auto paths = static_cast<size_t>(state.range(0));
+  const double drift = (MODEL.rate - 0.5 * MODEL.vol * MODEL.vol) * MODEL.expiry;
+  const double diffusion = MODEL.vol * std::sqrt(MODEL.expiry);
+  std::mt19937_64 engine(42);
+  std::normal_distribution<double> normal;
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (size_t i = 0; i < paths; ++i) {
+      const double spot = MODEL.spot * std::exp(drift + diffusion * normal(engine));
+      sum += std::max(spot - 100.0, 0.0);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScalarEuropean)->Arg(1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Batch Black-Scholes over option chains (struct of arrays)
+ *
+ * - One pass prices the call and the put and every first-order greek;
+ *   d1, d2, the discount factor and N'(d1) are computed once per option
+ * - Kernels run 8 / 4 / 2 options per step (AVX-512 / AVX2 / SSE2),
+ *   picked at run time; chains above PARALLEL_GRAIN options are split
+ *   across threads
+ * - N(d) and N(-d) are both evaluated directly, so deep out-of-the-money
+ *   prices and put deltas keep their relative accuracy (no 1 - N(d))
+ * - Accuracy matches the scalar closed form on libm: errors against long
+ *   double stay near 1e-15 x spot for prices and greeks (relative error
+ *   only grows where the formula itself cancels, as for any double code)
+ * - Inputs must be positive (rate may be any sign); vol in annual units,
+ *   expiry in years. Results for other inputs are unspecified
+ * - Outputs are resized to the chain size; reusing the same ChainGreeks
+ *   on every tick does not allocate
+ */
+
+struct OptionChain {
+  std::vector<double> spot;
+  std::vector<double> strike;
+  std::vector<double> rate;    // Continuously compounded
+  std::vector<double> vol;
+  std::vector<double> expiry;  // Years
+
+  size_t size() const { return spot.size(); }
+};
+
+// Greeks are per unit of the input: vega per 1.0 vol, rho per 1.0 rate,
+// theta per year (dV/dt, negative for long options).
+struct ChainGreeks {
+  std::vector<double> call;
+  std::vector<double> put;
+  std::vector<double> callDelta;
+  std::vector<double> putDelta;
+  std::vector<double> gamma;
+  std::vector<double> vega;
+  std::vector<double> callTheta;
+  std::vector<double> putTheta;
+  std::vector<double> callRho;
+  std::vector<double> putRho;
+};
+
+// Options per thread chunk; smaller chains are priced on the caller.
+constexpr size_t PARALLEL_GRAIN = 16384;
+
+// False (out untouched) if the chain's arrays differ in length.
+// threads == 0 uses every hardware thread.
+bool priceChain(const OptionChain& chain, ChainGreeks& out, unsigned threads = 0);
+
+/**
+ * Batch implied volatility
+ *
+ * - Each quote is reduced to Jaeckel's normalized out-of-the-money call
+ *   b(x, s) with x = ln(F/K) <= 0 and s = vol sqrt(T) (in-the-money quotes
+ *   go through put-call parity first), so one solver covers both types
+ * - Initial guess: Corrado-Miller near the money, the small-price
+ *   asymptote s = |x| / sqrt(-2 ln b) deep out of the money (the larger
+ *   of the two)
+ * - Iteration: Halley on ln b(s), 8 / 4 / 2 quotes per step with a
+ *   per-lane convergence mask; the vector stops when its last lane has
+ *   converged
+ * - Safeguard: every lane keeps a bracket [lo, hi] around the root; a
+ *   step that leaves it (or is not finite, e.g. when b underflows deep
+ *   out of the money) is replaced by bisection, or doubling while hi is
+ *   still unbounded
+ * - A lane has converged once its step falls below 1e-12 s (a handful of
+ *   ulps in the repriced quote); at most IMPLIED_VOL_MAX_ITERATIONS
+ *   iterations, typically 3 to 5
+ * - Quotes outside the no-arbitrage bounds (below intrinsic, above spot
+ *   for calls or discounted strike for puts) give NaN; a quote within
+ *   rounding of intrinsic (time value below ~4 ulps of the price) gives 0
+ */
+
+constexpr int IMPLIED_VOL_MAX_ITERATIONS = 64;
+// Quotes per thread chunk (each costs roughly 20x a pricing pass).
+constexpr size_t IMPLIED_VOL_GRAIN = 2048;
+
+struct ImpliedVolStats {
+  size_t options = 0;
+  // Each option is converged, atIntrinsic, rejected, or else hit
+  // IMPLIED_VOL_MAX_ITERATIONS.
+  size_t converged = 0;       // Solved to the step tolerance
+  size_t atIntrinsic = 0;     // Vol 0 without iterating
+  size_t rejected = 0;        // NaN: outside the no-arbitrage bounds (or NaN input)
+  size_t safeguardSteps = 0;  // Bisection / doubling steps, all options
+  size_t iterations = 0;      // Summed over options
+  int maxIterations = 0;
+};
+
+// vols[i] reprices prices[i] (isCall[i] != 0: call, else put); chain.vol
+// is ignored. False (vols untouched) if any input length differs from
+// chain.spot.
+bool impliedVolChain(const OptionChain& chain, const std::vector<double>& prices,
+                     const std::vector<uint8_t>& isCall, std::vector<double>& vols,
+                     unsigned threads = 0, ImpliedVolStats* stats = nullptr);
@@ -0,0 +1,232 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "lane_kernels.h"
+
+/**
+ * Lane-generic double math for the batch pricers
+ *
+ * - Every function is a template over its lane type: plain double, or a
+ *   GCC vector of 2 / 4 / 8 doubles (one SSE2 / AVX2 / AVX-512 register)
+ * - Everything is always_inline and carries no target attribute, so it
+ *   compiles to the ISA of the kernel that inlines it. Batch kernels are
+ *   instantiated once per width inside target("avx2,fma") /
+ *   target("avx512f") functions and picked at run time with
+ *   bestLaneWidth(), which checks exactly those features
+ * - sqrtLanes only becomes vsqrtpd when the including file is built with
+ *   -fno-math-errno (otherwise GCC keeps a scalar call per lane for errno)
+ * - Accuracy against long double: exp 1.3 ulp, log 1 ulp, normal CDF
+ *   6 ulp relative in both tails (exp(-x^2/2) is computed from an exact
+ *   split of x^2, so the tail does not inherit the rounding of x*x)
+ * - Coefficients are Chebyshev fits (50-digit mpmath); log uses fdlibm's
+ *   reduction and coefficients, Box-Muller fdlibm's sin / cos kernels
+ * - The lane types, exp, log and erfc come from the repo-level
+ *   include/lane_kernels.h, shared with week-3/src/simd_math.cpp; the
+ *   sources instantiating them build with -Wno-psabi (see CMakeLists.txt)
+ * - threefry4x64 is counter based: the bits for any (key, counter) are
+ *   computed directly, so Monte Carlo paths need no generator state
+ */
+
+namespace lane_math {
+
+template <typename D>
+constexpr size_t LANES = sizeof(D) / sizeof(double);
+
+// Widest lane count the CPU (and OS) supports: 8, 4, 2, or 1 off x86.
+inline size_t bestLaneWidth() {
+#if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("avx512f")) return 8;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return 4;
+  return 2;
+#else
+  return 1;
+#endif
+}
+
+// Loads / stores count (<= LANES) values; missing lanes are filled with pad.
+template <typename D>
+LANE_INLINE D load(const double* p, size_t count = LANES<D>, double pad = 1.0) {
+  D v = splat<D>(pad);
+  std::memcpy(&v, p, count * sizeof(double));
+  return v;
+}
+
+// count (<= LANES) byte flags as 1.0 (non-zero) / 0.0; missing lanes are 1.0.
+template <typename D>
+LANE_INLINE D loadFlags(const uint8_t* p, size_t count = LANES<D>) {
+  double lanes[LANES<D>];
+  for (size_t j = 0; j < LANES<D>; ++j) lanes[j] = j >= count || p[j] != 0 ? 1.0 : 0.0;
+  return load<D>(lanes);
+}
+
+template <typename D>
+LANE_INLINE void store(double* p, D v, size_t count = LANES<D>) {
+  std::memcpy(p, &v, count * sizeof(double));
+}
+
+// Returns v unchanged but hides where it came from, so GCC cannot fold
+// arithmetic on 0.0 / 1.0 lane flags back into comparison masks (GCC 12
+// expands 512-bit selects on such masks lane by lane). Costs nothing.
+template <typename D>
+LANE_INLINE D opaque(D v) {
+#if defined(__x86_64__) || defined(__i386__)
+  asm("" : "+v"(v));
+#endif
+  return v;
+}
+
+// True if any lane of v is non-zero (or NaN).
+template <typename D>
+LANE_INLINE bool anyNonZero(D v) {
+  double lanes[LANES<D>];
+  store(lanes, v);
+  for (double lane : lanes) {
+    if (lane != 0.0) return true;
+  }
+  return false;
+}
+
+template <typename D>
+LANE_INLINE D sqrtLanes(D x) {
+  if constexpr (sizeof(D) == sizeof(double)) {
+    return __builtin_sqrt(x);
+  } else {
+    for (size_t i = 0; i < LANES<D>; ++i) x[i] = __builtin_sqrt(x[i]);
+    return x;
+  }
+}
+
+template <typename D>
+LANE_INLINE D absLanes(D x) {
+  return copySign(x, splat<D>(1.0));
+}
+
+// ------------------------------------------------------------ normal CDF
+
+// Phi(x) and Phi(-x) together, each accurate in its own tail (so 1 - Phi
+// never cancels). NaN propagates to both.
+template <typename D>
+LANE_INLINE void normalCdfPair(D x, D& lower, D& upper) {
+  constexpr double FRAC_1_SQRT2 = 0.70710678118654752;
+  // Past |x| = 40 the small tail is below the smallest subnormal.
+  const D abs_x = absLanes(x);
+  const D clamped = abs_x < 40.0 ? abs_x : splat<D>(40.0);
+  const D a = clamped * FRAC_1_SQRT2;
+  D sq_hi, sq_lo;
+  squareExact(clamped, sq_hi, sq_lo);  // a^2 = x^2 / 2, halved exactly below
+  const D tail = 0.5 * erfcTail(a, 0.5 * sq_hi, 0.5 * sq_lo);  // Phi(-|x|)
+  const D half_erf = 0.5 * copySign(a * horner(ERF_SMALL, a * a), x);
+  const auto central = a < 0.5;
+  const auto negative = x < 0.0;
+  const auto nan = x != x;
+  lower = central ? 0.5 + half_erf : (negative ? tail : 1.0 - tail);
+  upper = central ? 0.5 - half_erf : (negative ? 1.0 - tail : tail);
+  lower = nan ? x : lower;
+  upper = nan ? x : upper;
+}
+
+template <typename D>
+LANE_INLINE D normalCdf(D x) {
+  D lower, upper;
+  normalCdfPair(x, lower, upper);
+  return lower;
+}
+
+// Standard normal density.
+template <typename D>
+LANE_INLINE D normalPdf(D x) {
+  constexpr double FRAC_1_SQRT_2PI = 0.39894228040143268;
+  return FRAC_1_SQRT_2PI * expLanes(-0.5 * x * x);
+}
+
+// ------------------------------------------------- counter-based random bits
+
+// Threefry-4x64-20 (Salmon et al., "Parallel random numbers: as easy as 1,
+// 2, 3", SC 2011): 20 add / rotate / xor rounds over a 256-bit counter
+// under a 256-bit key; the counter words are replaced by the output. Only
+// 64-bit adds, shifts and xors, so every lane width vectorizes it fully
+// (Philox's 32 x 32 -> 64 multiply does not map onto GCC vector types).
+constexpr uint64_t THREEFRY_PARITY = 0x1BD11BDAA9FC1A22;
+
+template <int A, int B, typename U>
+LANE_INLINE void threefryMix(U& x0, U& x1, U& x2, U& x3) {
+  x0 += x1;
+  x1 = ((x1 << A) | (x1 >> (64 - A))) ^ x0;
+  x2 += x3;
+  x3 = ((x3 << B) | (x3 >> (64 - B))) ^ x2;
+}
+
+// The rounds run on locals rather than through x: GCC 12 otherwise loses
+// track of the array across the unrolled rounds and reports the caller's
+// counter as maybe-uninitialized.
+template <typename U>
+LANE_INLINE void threefry4x64(U (&x)[4], const uint64_t (&key)[4]) {
+  const uint64_t schedule[5] = {key[0], key[1], key[2], key[3],
+                                THREEFRY_PARITY ^ key[0] ^ key[1] ^ key[2] ^ key[3]};
+  U x0 = x[0] + schedule[0];
+  U x1 = x[1] + schedule[1];
+  U x2 = x[2] + schedule[2];
+  U x3 = x[3] + schedule[3];
+  for (uint64_t injection = 1; injection <= 5; ++injection) {
+    if (injection % 2 == 1) {
+      threefryMix<14, 16>(x0, x1, x2, x3);
+      threefryMix<52, 57>(x0, x3, x2, x1);
+      threefryMix<23, 40>(x0, x1, x2, x3);
+      threefryMix<5, 37>(x0, x3, x2, x1);
+    } else {
+      threefryMix<25, 33>(x0, x1, x2, x3);
+      threefryMix<46, 12>(x0, x3, x2, x1);
+      threefryMix<58, 22>(x0, x1, x2, x3);
+      threefryMix<32, 32>(x0, x3, x2, x1);
+    }
+    x0 += schedule[injection % 5];
+    x1 += schedule[(injection + 1) % 5];
+    x2 += schedule[(injection + 2) % 5];
+    x3 += schedule[(injection + 3) % 5];
+    x3 += injection;
+  }
+  x[0] = x0;
+  x[1] = x1;
+  x[2] = x2;
+  x[3] = x3;
+}
+
+// -------------------------------------------------------- normal variates
+
+// fdlibm __kernel_sin / __kernel_cos, valid on |x| <= pi/4 (~1 ulp).
+constexpr double SIN_POLY[6] = {1.58969099521155010221e-10,  -2.50507602534068634195e-08,
+                                2.75573137070700676789e-06,  -1.98412698298579493134e-04,
+                                8.33333333332248946124e-03,  -1.66666666666666324348e-01};
+constexpr double COS_POLY[6] = {-1.13596475577881948265e-11, 2.08757232129817482790e-09,
+                                -2.75573143513906633035e-07, 2.48015872894767294178e-05,
+                                -1.38888888888741095749e-03, 4.16666666666666019037e-02};
+
+// Box-Muller on two 64-bit words per lane: radius from u0, angle from u1.
+// The angle never needs range reduction: the low 52 bits of u1 give
+// phi in (0, pi/4) and its top three bits reflect (cos phi, sin phi) into
+// one of the eight octants. Outputs are independent N(0, 1) up to the
+// 2^-52 resolution of u0, which caps |z| at 8.49.
+template <typename D, typename U>
+LANE_INLINE void boxMuller(U u0, U u1, D& z0, D& z1) {
+  constexpr uint64_t SIGN = uint64_t{1} << 63;
+  constexpr uint64_t LOW_52 = (uint64_t{1} << 52) - 1;
+  constexpr double PHI_SCALE = 0.78539816339744831 * 0x1p-52;  // pi/4 per 2^52
+  const D uniform = (smallIntToDouble<D>(u0 >> 12) + 0.5) * 0x1p-52;  // (0, 1)
+  const D radius = sqrtLanes(-2.0 * logLanes(uniform));
+  const D phi = (smallIntToDouble<D>(u1 & LOW_52) + 0.5) * PHI_SCALE;
+  const D z = phi * phi;
+  const D sin_phi = phi + phi * z * horner(SIN_POLY, z);
+  const D half_z = 0.5 * z;
+  const D w = 1.0 - half_z;
+  const D cos_phi = w + (((1.0 - w) - half_z) + z * z * horner(COS_POLY, z));
+  // Swap as 0.0 / 1.0 arithmetic (exact), signs straight into the sign bit.
+  const D swap = smallIntToDouble<D>((u1 >> 61) & 1);
+  const D x = radius * (swap * sin_phi + (1.0 - swap) * cos_phi);
+  const D y = radius * (swap * cos_phi + (1.0 - swap) * sin_phi);
+  z0 = bitsAs<D>(bitsAs<U>(x) ^ (u1 & SIGN));
+  z1 = bitsAs<D>(bitsAs<U>(y) ^ ((u1 << 1) & SIGN));
+}
+
+}  // namespace lane_math
@@ -0,0 +1,35 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * Static-chunk parallel loop for the batch pricers
+ *
+ * - [0, size) is cut into contiguous chunks of at least grain elements,
+ *   one per thread; chunk boundaries are multiples of grain so vector
+ *   kernels only see a partial tail in the last chunk
+ * - threads == 0 uses std::thread::hardware_concurrency()
+ * - Ranges that fit in one chunk run on the calling thread (no spawn)
+ * - fn(begin, end) must be safe to run concurrently on disjoint ranges
+ */
+template <typename Fn>
+void parallelFor(size_t size, size_t grain, unsigned threads, Fn&& fn) {
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  grain = std::max<size_t>(grain, 1);
+  const size_t grains = (size + grain - 1) / grain;
+  const size_t chunks = std::min<size_t>(threads, grains);
+  if (chunks <= 1) {
+    if (size > 0) fn(size_t{0}, size);
+    return;
+  }
+  const size_t per_chunk = (grains + chunks - 1) / chunks * grain;
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  for (size_t begin = per_chunk; begin < size; begin += per_chunk) {
+    workers.emplace_back([&fn, begin, end = std::min(size, begin + per_chunk)] { fn(begin, end); });
+  }
+  fn(size_t{0}, std::min(size, per_chunk));
+  for (std::thread& worker : workers) worker.join();
+}
@@ -0,0 +1,354 @@
+#include "../include/batch_pricing.h"
+#include "../include/lane_math.h"
+#include "../include/parallel.h"
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+using namespace lane_math;
+
+struct ChainPointers {
+  const double* spot;
+  const double* strike;
+  const double* rate;
+  const double* vol;
+  const double* expiry;
+  double* call;
+  double* put;
+  double* callDelta;
+  double* putDelta;
+  double* gamma;
+  double* vega;
+  double* callTheta;
+  double* putTheta;
+  double* callRho;
+  double* putRho;
+};
+
+// Prices count (<= LANES) options starting at i. Padding lanes price a
+// harmless unit option and are never stored.
+template <typename D>
+LANE_INLINE void priceLanes(const ChainPointers& p, size_t i, size_t count) {
+  const D s = load<D>(p.spot + i, count);
+  const D k = load<D>(p.strike + i, count);
+  const D r = load<D>(p.rate + i, count);
+  const D vol = load<D>(p.vol + i, count);
+  const D t = load<D>(p.expiry + i, count);
+
+  const D sqrt_t = sqrtLanes(t);
+  const D vol_sqrt_t = vol * sqrt_t;
+  const D k_discounted = k * expLanes(-r * t);
+  const D d1 = (logLanes(s / k) + (r + 0.5 * vol * vol) * t) / vol_sqrt_t;
+  const D d2 = d1 - vol_sqrt_t;
+  D n_d1, n_minus_d1, n_d2, n_minus_d2;
+  normalCdfPair(d1, n_d1, n_minus_d1);
+  normalCdfPair(d2, n_d2, n_minus_d2);
+  const D s_pdf = s * normalPdf(d1);
+  const D decay = -0.5 * s_pdf * vol / sqrt_t;
+
+  store(p.call + i, s * n_d1 - k_discounted * n_d2, count);
+  store(p.put + i, k_discounted * n_minus_d2 - s * n_minus_d1, count);
+  store(p.callDelta + i, n_d1, count);
+  store(p.putDelta + i, -n_minus_d1, count);
+  store(p.gamma + i, s_pdf / (s * s * vol_sqrt_t), count);
+  store(p.vega + i, s_pdf * sqrt_t, count);
+  store(p.callTheta + i, decay - r * k_discounted * n_d2, count);
+  store(p.putTheta + i, decay + r * k_discounted * n_minus_d2, count);
+  store(p.callRho + i, t * k_discounted * n_d2, count);
+  store(p.putRho + i, -t * k_discounted * n_minus_d2, count);
+}
+
+template <typename D>
+LANE_INLINE void priceRange(const ChainPointers& p, size_t begin, size_t end) {
+  size_t i = begin;
+  for (; i + LANES<D> <= end; i += LANES<D>) priceLanes<D>(p, i, LANES<D>);
+  if (i < end) priceLanes<D>(p, i, end - i);
+}
+
+using PriceKernel = void (*)(const ChainPointers&, size_t, size_t);
+
+void priceScalar(const ChainPointers& p, size_t begin, size_t end) {
+  priceRange<double>(p, begin, end);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2"))) void priceSse2(const ChainPointers& p, size_t begin, size_t end) {
+  priceRange<Double2>(p, begin, end);
+}
+
+__attribute__((target("avx2,fma"))) void priceAvx2(const ChainPointers& p, size_t begin,
+                                                   size_t end) {
+  priceRange<Double4>(p, begin, end);
+}
+
+__attribute__((target("avx512f"))) void priceAvx512(const ChainPointers& p, size_t begin,
+                                                    size_t end) {
+  priceRange<Double8>(p, begin, end);
+}
+#endif
+
+PriceKernel priceKernel() {
+  switch (bestLaneWidth()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case 8:
+      return &priceAvx512;
+    case 4:
+      return &priceAvx2;
+    case 2:
+      return &priceSse2;
+#endif
+    default:
+      return &priceScalar;
+  }
+}
+
+// ------------------------------------------------------- implied volatility
+
+struct QuotePointers {
+  const double* spot;
+  const double* strike;
+  const double* rate;
+  const double* expiry;
+  const double* price;
+  const uint8_t* isCall;
+  double* vol;
+};
+
+struct SolveCounts {
+  size_t converged = 0;
+  size_t atIntrinsic = 0;
+  size_t rejected = 0;
+  size_t safeguardSteps = 0;
+  size_t iterations = 0;
+  int maxIterations = 0;
+};
+
+template <typename D>
+LANE_INLINE D positivePart(D x) {
+  return x > 0.0 ? x : splat<D>(0.0);
+}
+
+// Solves count (<= LANES) quotes starting at i. Padding lanes hold an
+// at-the-money call worth 0.1 that converges in a few steps and is
+// neither stored nor counted.
+//
+// Lane state (valid, active, counters) is kept as 0.0 / 1.0 doubles behind
+// opaque() and combined arithmetically, so every comparison feeds exactly
+// one select (see opaque()).
+template <typename D>
+LANE_INLINE void solveLanes(const QuotePointers& p, size_t i, size_t count, SolveCounts& counts) {
+  constexpr double FRAC_1_SQRT_2PI = 0.39894228040143268;
+  constexpr double SQRT_2PI = 2.5066282746310002;
+  constexpr double FRAC_1_PI = 0.31830988618379067;
+  constexpr double UNBOUNDED = __DBL_MAX__;  // Finite, so 0 * hi stays 0
+  constexpr double STEP_TOLERANCE = 1e-12;  // Relative to s
+  const D s = load<D>(p.spot + i, count);
+  const D k = load<D>(p.strike + i, count);
+  const D r = load<D>(p.rate + i, count, 0.0);
+  const D t = load<D>(p.expiry + i, count);
+  const D price = load<D>(p.price + i, count, 0.1);
+  const D call = loadFlags<D>(p.isCall + i, count);
+  const D one = splat<D>(1.0);
+  const D zero = splat<D>(0.0);
+
+  // Normalize: price / sqrt(F K) / df, then subtract the intrinsic value
+  // (parity) and mirror puts, leaving an out-of-the-money call at x <= 0.
+  const D rt = r * t;
+  const D x = logLanes(s / k) + rt;
+  const D e_half = expLanes(0.5 * x);
+  const D intrinsic = call != 0.0 ? positivePart(e_half - 1.0 / e_half)
+                                  : positivePart(1.0 / e_half - e_half);
+  const D normalized = price / sqrtLanes(s * k * expLanes(-rt));
+  const D beta = normalized - intrinsic;
+  // Time value lost in the rounding of the parity subtraction: priced as
+  // intrinsic (vol 0) rather than solved from noise.
+  const D at_intrinsic = opaque(absLanes(beta) <= 4.0 * __DBL_EPSILON__ * normalized ? one : zero);
+  const D xn = -absLanes(x);
+  const D upper = expLanes(0.5 * xn);  // b(x, s) -> e^(x/2) as s -> infinity
+  const D lower = 1.0 / upper;
+  const D log_beta = logLanes(beta);
+  // 0 < beta < upper; NaN fails both.
+  const D valid = opaque(log_beta > -UNBOUNDED ? one : zero) *
+                  opaque(log_beta < 0.5 * xn ? one : zero) * (1.0 - at_intrinsic);
+
+  // Corrado-Miller in normalized units (spot e^(x/2), discounted strike
+  // e^(-x/2)), and the deep out-of-the-money asymptote ln b ~ -x^2 / 2s^2.
+  const D half_gap = 0.5 * (upper - lower);
+  const D excess = beta - half_gap;
+  const D disc = positivePart(excess * excess - 4.0 * half_gap * half_gap * FRAC_1_PI);
+  const D corrado_miller = SQRT_2PI / (upper + lower) * (excess + sqrtLanes(disc));
+  const D asymptote = -xn / sqrtLanes(-2.0 * log_beta);
+  D sigma = corrado_miller > asymptote ? corrado_miller : asymptote;
+  sigma = sigma > 1e-8 ? sigma : splat<D>(1e-8);  // NaN (invalid lanes) too
+
+  D lo = zero;
+  D hi = splat<D>(UNBOUNDED);
+  D active = valid;
+  D iterations = zero;
+  D safeguards = zero;
+  for (int iteration = 0; iteration < IMPLIED_VOL_MAX_ITERATIONS && anyNonZero(active);
+       ++iteration) {
+    const D x_over_s = xn / sigma;
+    const D b =
+        upper * normalCdf(x_over_s + 0.5 * sigma) - lower * normalCdf(x_over_s - 0.5 * sigma);
+    const D db = FRAC_1_SQRT_2PI * expLanes(-0.5 * (x_over_s * x_over_s + 0.25 * sigma * sigma));
+    // Halley on g = ln b - ln beta: g' = b'/b, g'' = g' (b''/b') - g'^2.
+    const D g = logLanes(b) - log_beta;
+    const D dg = db / b;
+    const D d2g = dg * (x_over_s * x_over_s / sigma - 0.25 * sigma) - dg * dg;
+    const D newton = g / dg;
+    // Far from the root the Halley factor can flip or stall the step; fall
+    // back to Newton outside [0.5, 2].
+    D halley = 1.0 - 0.5 * newton * d2g / dg;
+    halley = halley > 0.5 ? halley : one;
+    halley = halley < 2.0 ? halley : one;
+    const D candidate = sigma - newton / halley;
+
+    // Inactive lanes update their bracket too; it is never read again.
+    const D below = opaque(g < 0.0 ? one : zero);
+    lo = below * sigma + (1.0 - below) * lo;
+    hi = below * hi + (1.0 - below) * sigma;
+    // Strict bounds: a Newton step that lands back on lo or hi is the
+    // rounding-noise ping-pong near the root, so it bisects instead.
+    const D in_bracket =
+        opaque(opaque(candidate > lo ? one : zero) * opaque(candidate < hi ? one : zero));
+    const D fallback = hi < UNBOUNDED ? 0.5 * (lo + hi) : 2.0 * sigma;
+    const D stepped = in_bracket != 0.0 ? candidate : fallback;
+    // An exact root also collapses the bracket onto sigma; stay there.
+    const D next = g == 0.0 ? sigma : stepped;
+
+    const D done = opaque(absLanes(next - sigma) <= STEP_TOLERANCE * sigma ? one : zero);
+    sigma = active != 0.0 ? next : sigma;
+    iterations += active;
+    safeguards += active * (1.0 - in_bracket);
+    active *= 1.0 - done;
+  }
+
+  const D invalid = at_intrinsic != 0.0 ? zero : splat<D>(__builtin_nan(""));
+  const D vol = valid != 0.0 ? sigma / sqrtLanes(t) : invalid;
+  store(p.vol + i, vol, count);
+
+  double lane_valid[LANES<D>], lane_at_intrinsic[LANES<D>], lane_active[LANES<D>],
+      lane_iterations[LANES<D>], lane_safeguards[LANES<D>];
+  store(lane_valid, valid);
+  store(lane_at_intrinsic, at_intrinsic);
+  store(lane_active, active);
+  store(lane_iterations, iterations);
+  store(lane_safeguards, safeguards);
+  for (size_t j = 0; j < count; ++j) {
+    counts.converged += lane_valid[j] != 0.0 && lane_active[j] == 0.0;
+    counts.atIntrinsic += lane_at_intrinsic[j] != 0.0;
+    counts.rejected += lane_valid[j] == 0.0 && lane_at_intrinsic[j] == 0.0;
+    counts.iterations += static_cast<size_t>(lane_iterations[j]);
+    counts.safeguardSteps += static_cast<size_t>(lane_safeguards[j]);
+    counts.maxIterations = std::max(counts.maxIterations, static_cast<int>(lane_iterations[j]));
+  }
+}
+
+template <typename D>
+LANE_INLINE void solveRange(const QuotePointers& p, size_t begin, size_t end, SolveCounts& counts) {
+  size_t i = begin;
+  for (; i + LANES<D> <= end; i += LANES<D>) solveLanes<D>(p, i, LANES<D>, counts);
+  if (i < end) solveLanes<D>(p, i, end - i, counts);
+}
+
+using SolveKernel = void (*)(const QuotePointers&, size_t, size_t, SolveCounts&);
+
+void solveScalar(const QuotePointers& p, size_t begin, size_t end, SolveCounts& counts) {
+  solveRange<double>(p, begin, end, counts);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2"))) void solveSse2(const QuotePointers& p, size_t begin, size_t end,
+                                               SolveCounts& counts) {
+  solveRange<Double2>(p, begin, end, counts);
+}
+
+__attribute__((target("avx2,fma"))) void solveAvx2(const QuotePointers& p, size_t begin,
+                                                   size_t end, SolveCounts& counts) {
+  solveRange<Double4>(p, begin, end, counts);
+}
+
+__attribute__((target("avx512f"))) void solveAvx512(const QuotePointers& p, size_t begin,
+                                                    size_t end, SolveCounts& counts) {
+  solveRange<Double8>(p, begin, end, counts);
+}
+#endif
+
+SolveKernel solveKernel() {
+  switch (bestLaneWidth()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case 8:
+      return &solveAvx512;
+    case 4:
+      return &solveAvx2;
+    case 2:
+      return &solveSse2;
+#endif
+    default:
+      return &solveScalar;
+  }
+}
+
+}  // namespace
+
+bool priceChain(const OptionChain& chain, ChainGreeks& out, unsigned threads) {
+  const size_t size = chain.size();
+  if (chain.strike.size() != size || chain.rate.size() != size || chain.vol.size() != size ||
+      chain.expiry.size() != size) {
+    return false;
+  }
+  for (std::vector<double>* column :
+       {&out.call, &out.put, &out.callDelta, &out.putDelta, &out.gamma, &out.vega, &out.callTheta,
+        &out.putTheta, &out.callRho, &out.putRho}) {
+    column->resize(size);
+  }
+  const ChainPointers p{chain.spot.data(),    chain.strike.data(),   chain.rate.data(),
+                        chain.vol.data(),     chain.expiry.data(),   out.call.data(),
+                        out.put.data(),       out.callDelta.data(),  out.putDelta.data(),
+                        out.gamma.data(),     out.vega.data(),       out.callTheta.data(),
+                        out.putTheta.data(),  out.callRho.data(),    out.putRho.data()};
+  static const PriceKernel kernel = priceKernel();
+  parallelFor(size, PARALLEL_GRAIN, threads,
+              [&p](size_t begin, size_t end) { kernel(p, begin, end); });
+  return true;
+}
+
+bool impliedVolChain(const OptionChain& chain, const std::vector<double>& prices,
+                     const std::vector<uint8_t>& isCall, std::vector<double>& vols,
+                     unsigned threads, ImpliedVolStats* stats) {
+  const size_t size = chain.size();
+  if (chain.strike.size() != size || chain.rate.size() != size || chain.expiry.size() != size ||
+      prices.size() != size || isCall.size() != size) {
+    return false;
+  }
+  vols.resize(size);
+  const QuotePointers p{chain.spot.data(), chain.strike.data(), chain.rate.data(),
+                        chain.expiry.data(), prices.data(),      isCall.data(),
+                        vols.data()};
+  static const SolveKernel kernel = solveKernel();
+  std::mutex mutex;
+  SolveCounts total;
+  parallelFor(size, IMPLIED_VOL_GRAIN, threads, [&](size_t begin, size_t end) {
+    SolveCounts counts;
+    kernel(p, begin, end, counts);
+    std::lock_guard<std::mutex> lock(mutex);
+    total.converged += counts.converged;
+    total.atIntrinsic += counts.atIntrinsic;
+    total.rejected += counts.rejected;
+    total.safeguardSteps += counts.safeguardSteps;
+    total.iterations += counts.iterations;
+    total.maxIterations = std::max(total.maxIterations, counts.maxIterations);
+  });
+  if (stats != nullptr) {
+    stats->options = size;
+    stats->converged = total.converged;
+    stats->atIntrinsic = total.atIntrinsic;
+    stats->rejected = total.rejected;
+    stats->safeguardSteps = total.safeguardSteps;
+    stats->iterations = total.iterations;
+    stats->maxIterations = total.maxIterations;
+  }
+  return true;
+}
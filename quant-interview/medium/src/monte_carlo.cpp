@@ -0,0 +1,217 @@
+#include "../include/monte_carlo.h"
+#include "../include/lane_math.h"
+#include "../include/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using namespace lane_math;
+
+struct PathSpec {
+  double spot;
+  double drift;      // (r - vol^2 / 2) dt
+  double diffusion;  // vol sqrt(dt)
+  int steps;
+  uint64_t key[4];  // {seed, 0, 0, 0}
+};
+
+// Simulates paths first .. first + count - 1 (count <= LANES) into
+// spots[step * MC_BLOCK_PATHS]. Path p draws its normals four steps at a
+// time from counter (step / 4, p, 0, 0); padding lanes run paths past the
+// block and are never stored.
+template <typename D>
+LANE_INLINE void simulateLanes(const PathSpec& spec, uint64_t first, size_t count, double* spots) {
+  using UInt = typename LaneInts<D>::UInt;
+  uint64_t lane_paths[LANES<D>];
+  for (size_t j = 0; j < LANES<D>; ++j) lane_paths[j] = first + j;
+  UInt path;
+  std::memcpy(&path, lane_paths, sizeof(path));
+
+  D log_spot{};
+  for (int step = 0; step < spec.steps; step += 4) {
+    UInt ctr[4] = {UInt{} + static_cast<uint64_t>(step / 4), path, UInt{}, UInt{}};
+    threefry4x64(ctr, spec.key);
+    D z[4] = {};
+    boxMuller(ctr[0], ctr[1], z[0], z[1]);
+    // Uniform across lanes: every path has the same number of steps.
+    if (spec.steps - step > 2) boxMuller(ctr[2], ctr[3], z[2], z[3]);
+    for (int j = 0; j < 4 && step + j < spec.steps; ++j) {
+      log_spot += spec.drift + spec.diffusion * z[j];
+      store(spots + static_cast<size_t>(step + j) * MC_BLOCK_PATHS, spec.spot * expLanes(log_spot),
+            count);
+    }
+  }
+}
+
+template <typename D>
+LANE_INLINE void simulateBlock(const PathSpec& spec, uint64_t first, size_t count, double* spots) {
+  size_t i = 0;
+  for (; i + LANES<D> <= count; i += LANES<D>) {
+    simulateLanes<D>(spec, first + i, LANES<D>, spots + i);
+  }
+  if (i < count) simulateLanes<D>(spec, first + i, count - i, spots + i);
+}
+
+using SimulateKernel = void (*)(const PathSpec&, uint64_t, size_t, double*);
+
+void simulateScalar(const PathSpec& spec, uint64_t first, size_t count, double* spots) {
+  simulateBlock<double>(spec, first, count, spots);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2"))) void simulateSse2(const PathSpec& spec, uint64_t first,
+                                                  size_t count, double* spots) {
+  simulateBlock<Double2>(spec, first, count, spots);
+}
+
+__attribute__((target("avx2,fma"))) void simulateAvx2(const PathSpec& spec, uint64_t first,
+                                                      size_t count, double* spots) {
+  simulateBlock<Double4>(spec, first, count, spots);
+}
+
+__attribute__((target("avx512f"))) void simulateAvx512(const PathSpec& spec, uint64_t first,
+                                                      size_t count, double* spots) {
+  simulateBlock<Double8>(spec, first, count, spots);
+}
+#endif
+
+SimulateKernel simulateKernel() {
+  switch (bestLaneWidth()) {
+#if defined(__x86_64__) || defined(__i386__)
+    case 8:
+      return &simulateAvx512;
+    case 4:
+      return &simulateAvx2;
+    case 2:
+      return &simulateSse2;
+#endif
+    default:
+      return &simulateScalar;
+  }
+}
+
+// Running mean and sum of squared deviations (Chan et al. pairwise merge).
+struct PayoffStats {
+  double count = 0.0;
+  double mean = 0.0;
+  double m2 = 0.0;
+
+  void merge(const PayoffStats& other) {
+    const double total = count + other.count;
+    if (total == 0.0) return;
+    const double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count = total;
+  }
+};
+
+PayoffStats blockStats(const double* payoffs, size_t count) {
+  double sum = 0.0;
+  for (size_t i = 0; i < count; ++i) sum += payoffs[i];
+  PayoffStats stats;
+  stats.count = static_cast<double>(count);
+  stats.mean = sum / stats.count;
+  for (size_t i = 0; i < count; ++i) {
+    const double deviation = payoffs[i] - stats.mean;
+    stats.m2 += deviation * deviation;
+  }
+  return stats;
+}
+
+double intrinsic(double spot, double strike, bool is_call) {
+  return std::max(0.0, is_call ? spot - strike : strike - spot);
+}
+
+}  // namespace
+
+Payoff europeanPayoff(double strike, bool isCall) {
+  return [strike, isCall](const PathBlock& block, double* payoffs) {
+    for (size_t i = 0; i < block.paths; ++i) {
+      payoffs[i] = intrinsic(block.spot(block.steps - 1, i), strike, isCall);
+    }
+  };
+}
+
+Payoff asianPayoff(double strike, bool isCall) {
+  return [strike, isCall](const PathBlock& block, double* payoffs) {
+    double sums[MC_BLOCK_PATHS] = {};
+    for (int step = 0; step < block.steps; ++step) {
+      for (size_t i = 0; i < block.paths; ++i) sums[i] += block.spot(step, i);
+    }
+    for (size_t i = 0; i < block.paths; ++i) {
+      payoffs[i] = intrinsic(sums[i] / block.steps, strike, isCall);
+    }
+  };
+}
+
+Payoff barrierPayoff(double strike, double barrier, bool isCall, bool isUp, bool isIn) {
+  return [strike, barrier, isCall, isUp, isIn](const PathBlock& block, double* payoffs) {
+    // Extreme on the monitoring dates, on the barrier's side.
+    double extremes[MC_BLOCK_PATHS];
+    for (size_t i = 0; i < block.paths; ++i) extremes[i] = block.spot(0, i);
+    for (int step = 1; step < block.steps; ++step) {
+      for (size_t i = 0; i < block.paths; ++i) {
+        extremes[i] = isUp ? std::max(extremes[i], block.spot(step, i))
+                           : std::min(extremes[i], block.spot(step, i));
+      }
+    }
+    for (size_t i = 0; i < block.paths; ++i) {
+      const bool knocked = isUp ? extremes[i] >= barrier : extremes[i] <= barrier;
+      const double vanilla = intrinsic(block.spot(block.steps - 1, i), strike, isCall);
+      payoffs[i] = knocked == isIn ? vanilla : 0.0;
+    }
+  };
+}
+
+Payoff lookbackPayoff(double strike, bool isCall) {
+  return [strike, isCall](const PathBlock& block, double* payoffs) {
+    double extremes[MC_BLOCK_PATHS];
+    std::fill(extremes, extremes + block.paths, block.initialSpot);
+    for (int step = 0; step < block.steps; ++step) {
+      for (size_t i = 0; i < block.paths; ++i) {
+        extremes[i] = isCall ? std::max(extremes[i], block.spot(step, i))
+                             : std::min(extremes[i], block.spot(step, i));
+      }
+    }
+    for (size_t i = 0; i < block.paths; ++i) payoffs[i] = intrinsic(extremes[i], strike, isCall);
+  };
+}
+
+bool monteCarloPrice(const GbmModel& model, const MonteCarloConfig& config, const Payoff& payoff,
+                     MonteCarloResult& result) {
+  if (config.paths < 2 || config.steps < 1 || !payoff) return false;
+  const double dt = model.expiry / config.steps;
+  const PathSpec spec{model.spot,
+                      (model.rate - 0.5 * model.vol * model.vol) * dt,
+                      model.vol * std::sqrt(dt),
+                      config.steps,
+                      {config.seed, 0, 0, 0}};
+  static const SimulateKernel kernel = simulateKernel();
+
+  const size_t batches = (config.paths + MC_BATCH_PATHS - 1) / MC_BATCH_PATHS;
+  std::vector<PayoffStats> partial(batches);
+  parallelFor(batches, 1, config.threads, [&](size_t begin, size_t end) {
+    std::vector<double> spots(MC_BLOCK_PATHS * static_cast<size_t>(config.steps));
+    double payoffs[MC_BLOCK_PATHS];
+    for (size_t batch = begin; batch < end; ++batch) {
+      const size_t batch_end = std::min(config.paths, (batch + 1) * MC_BATCH_PATHS);
+      for (size_t first = batch * MC_BATCH_PATHS; first < batch_end; first += MC_BLOCK_PATHS) {
+        const size_t count = std::min(MC_BLOCK_PATHS, batch_end - first);
+        kernel(spec, first, count, spots.data());
+        payoff(PathBlock{spots.data(), count, MC_BLOCK_PATHS, config.steps, model.spot}, payoffs);
+        partial[batch].merge(blockStats(payoffs, count));
+      }
+    }
+  });
+
+  PayoffStats total;
+  for (const PayoffStats& stats : partial) total.merge(stats);
+  const double discount = std::exp(-model.rate * model.expiry);
+  result.price = discount * total.mean;
+  result.standardError = discount * std::sqrt(total.m2 / (total.count - 1.0) / total.count);
+  result.paths = config.paths;
+  return true;
+}
@@ -1,5 +1,9 @@
 #include "../include/problems.h"
+#include "../include/batch_pricing.h"
+#include "../include/lane_math.h"
+#include "../include/monte_carlo.h"
 #include <gtest/gtest.h>
+#include <cmath>
 
 TEST(BlackScholes, Call) { EXPECT_GT(blackScholesCall(100,100,0.05,0.2,1), 5); }
 TEST(BlackScholes, Put) { EXPECT_GT(blackScholesPut(100,100,0.05,0.2,1), 3); }
@@ -11,3 +15,349 @@ TEST(Volatility, Historical) { EXPECT_GT(historicalVolatility({100,101,99,102,98
 TEST(InterestRate, Vasicek) { EXPECT_GT(vasicekRate(0.05,0.1,0.05,0.01,1,100), 0); }
 TEST(Exotic, Asian) { EXPECT_GT(asianOption(100,100,0.05,0.2,1,10,true), 0); }
 TEST(Credit, Survival) { EXPECT_LT(survivalProbability(0.01,1), 1); }
+
+// ---- Batch Black-Scholes (batch_pricing.h) ----
+
+namespace {
+
+struct ReferenceGreeks {
+  long double call, put, callDelta, putDelta, gamma, vega, callTheta, putTheta, callRho, putRho;
+};
+
+ReferenceGreeks referenceGreeks(long double s, long double k, long double r, long double vol,
+                                long double t) {
+  const auto cdf = [](long double x) { return 0.5L * std::erfc(-x / std::sqrt(2.0L)); };
+  const long double vol_sqrt_t = vol * std::sqrt(t);
+  const long double d1 = (std::log(s / k) + (r + 0.5L * vol * vol) * t) / vol_sqrt_t;
+  const long double d2 = d1 - vol_sqrt_t;
+  const long double kd = k * std::exp(-r * t);
+  const long double pdf = std::exp(-0.5L * d1 * d1) / std::sqrt(2.0L * M_PIl);
+  const long double decay = -s * pdf * vol / (2.0L * std::sqrt(t));
+  return {s * cdf(d1) - kd * cdf(d2),
+          kd * cdf(-d2) - s * cdf(-d1),
+          cdf(d1),
+          -cdf(-d1),
+          pdf / (s * vol_sqrt_t),
+          s * pdf * std::sqrt(t),
+          decay - r * kd * cdf(d2),
+          decay + r * kd * cdf(-d2),
+          t * kd * cdf(d2),
+          -t * kd * cdf(-d2)};
+}
+
+OptionChain testChain(size_t size) {
+  OptionChain chain;
+  for (size_t i = 0; i < size; ++i) {
+    chain.spot.push_back(100.0);
+    chain.strike.push_back(40.0 + 0.7 * static_cast<double>(i % 181));   // 40 .. 166
+    chain.rate.push_back(-0.01 + 0.01 * static_cast<double>(i % 7));     // -1% .. 5%
+    chain.vol.push_back(0.05 + 0.05 * static_cast<double>(i % 13));      // 5% .. 65%
+    chain.expiry.push_back(0.01 + 0.25 * static_cast<double>(i % 11));   // 4 days .. 2.5 years
+  }
+  return chain;
+}
+
+}  // namespace
+
+TEST(BatchPricing, MatchesClosedFormAcrossChain) {
+  const OptionChain chain = testChain(2003);  // Not a multiple of any lane count
+  ChainGreeks out;
+  ASSERT_TRUE(priceChain(chain, out, 1));
+  ASSERT_EQ(out.call.size(), chain.size());
+  for (size_t i = 0; i < chain.size(); ++i) {
+    const ReferenceGreeks ref = referenceGreeks(chain.spot[i], chain.strike[i], chain.rate[i],
+                                                chain.vol[i], chain.expiry[i]);
+    // Absolute error scaled by spot: relative error is unbounded where the
+    // formula itself cancels (deep out-of-the-money prices).
+    const double tol = 1e-14 * chain.spot[i];
+    EXPECT_NEAR(out.call[i], static_cast<double>(ref.call), tol) << i;
+    EXPECT_NEAR(out.put[i], static_cast<double>(ref.put), tol) << i;
+    EXPECT_NEAR(out.callDelta[i], static_cast<double>(ref.callDelta), 1e-14) << i;
+    EXPECT_NEAR(out.putDelta[i], static_cast<double>(ref.putDelta), 1e-14) << i;
+    EXPECT_NEAR(out.gamma[i], static_cast<double>(ref.gamma), 1e-12 * std::fabs(ref.gamma) + 1e-18)
+        << i;
+    EXPECT_NEAR(out.vega[i], static_cast<double>(ref.vega), tol) << i;
+    EXPECT_NEAR(out.callTheta[i], static_cast<double>(ref.callTheta), tol) << i;
+    EXPECT_NEAR(out.putTheta[i], static_cast<double>(ref.putTheta), tol) << i;
+    EXPECT_NEAR(out.callRho[i], static_cast<double>(ref.callRho), tol) << i;
+    EXPECT_NEAR(out.putRho[i], static_cast<double>(ref.putRho), tol) << i;
+  }
+}
+
+TEST(BatchPricing, KnownValuesAndParity) {
+  OptionChain chain{{100, 100, 100}, {100, 150, 50}, {0.05, 0.05, 0.05}, {0.2, 0.2, 0.2},
+                    {1, 0.1, 0.1}};
+  ChainGreeks out;
+  ASSERT_TRUE(priceChain(chain, out));
+  EXPECT_NEAR(out.call[0], 10.450583572185565, 1e-12);
+  EXPECT_NEAR(out.put[0], 5.573526022256971, 1e-12);
+  EXPECT_NEAR(out.callDelta[0], 0.6368306511756191, 1e-14);
+  for (size_t i = 0; i < chain.size(); ++i) {
+    const double forward_gap = chain.spot[i] - chain.strike[i] * std::exp(-chain.rate[i] *
+                                                                          chain.expiry[i]);
+    EXPECT_NEAR(out.call[i] - out.put[i], forward_gap, 1e-12);
+    EXPECT_NEAR(out.callDelta[i] - out.putDelta[i], 1.0, 1e-15);
+  }
+  // Deep out of the money: tiny but positive and relatively accurate.
+  const double otm_call = static_cast<double>(referenceGreeks(100, 150, 0.05, 0.2, 0.1).call);
+  EXPECT_GT(out.call[1], 0.0);
+  EXPECT_NEAR(out.call[1], otm_call, 1e-6 * otm_call);
+  EXPECT_NEAR(out.putDelta[2], static_cast<double>(referenceGreeks(100, 50, 0.05, 0.2, 0.1)
+                                                       .putDelta),
+              1e-12 * std::fabs(out.putDelta[2]));
+}
+
+TEST(BatchPricing, RejectsMismatchedColumns) {
+  OptionChain chain = testChain(10);
+  chain.vol.pop_back();
+  ChainGreeks out;
+  EXPECT_FALSE(priceChain(chain, out));
+  EXPECT_TRUE(out.call.empty());
+}
+
+TEST(BatchPricing, ThreadCountDoesNotChangeResults) {
+  const OptionChain chain = testChain(3 * PARALLEL_GRAIN + 5);
+  ChainGreeks single, multi;
+  ASSERT_TRUE(priceChain(chain, single, 1));
+  ASSERT_TRUE(priceChain(chain, multi, 4));
+  EXPECT_EQ(single.call, multi.call);
+  EXPECT_EQ(single.putTheta, multi.putTheta);
+  EXPECT_EQ(single.gamma, multi.gamma);
+}
+
+// ---- Batch implied volatility (batch_pricing.h) ----
+
+namespace {
+
+// Long double reference prices for chain.vol; the out-of-the-money side
+// when otm, else the in-the-money side.
+std::vector<double> referenceQuotes(const OptionChain& chain, bool otm,
+                                    std::vector<uint8_t>& isCall) {
+  std::vector<double> prices;
+  isCall.clear();
+  for (size_t i = 0; i < chain.size(); ++i) {
+    const ReferenceGreeks ref = referenceGreeks(chain.spot[i], chain.strike[i], chain.rate[i],
+                                                chain.vol[i], chain.expiry[i]);
+    const double forward = chain.spot[i] * std::exp(chain.rate[i] * chain.expiry[i]);
+    const bool call = (chain.strike[i] >= forward) == otm;
+    isCall.push_back(call);
+    prices.push_back(static_cast<double>(call ? ref.call : ref.put));
+  }
+  return prices;
+}
+
+}  // namespace
+
+TEST(ImpliedVol, RecoversVolFromOutOfTheMoneyQuotes) {
+  const OptionChain chain = testChain(2003);
+  std::vector<uint8_t> is_call;
+  const std::vector<double> prices = referenceQuotes(chain, true, is_call);
+  std::vector<double> vols;
+  ASSERT_TRUE(impliedVolChain(chain, prices, is_call, vols, 1));
+  ASSERT_EQ(vols.size(), chain.size());
+  size_t checked = 0;
+  for (size_t i = 0; i < chain.size(); ++i) {
+    // Prices this small carry only a few digits of vol.
+    if (prices[i] < 1e-10 * chain.spot[i]) continue;
+    EXPECT_NEAR(vols[i], chain.vol[i], 1e-10 * chain.vol[i]) << i;
+    ++checked;
+  }
+  EXPECT_GT(checked, chain.size() * 3 / 4);
+}
+
+TEST(ImpliedVol, InTheMoneyQuotesReprice) {
+  // The time value is a small difference of large numbers, so the check is
+  // on the repriced quote rather than on the vol.
+  OptionChain chain = testChain(2003);
+  std::vector<uint8_t> is_call, otm_is_call;
+  const std::vector<double> prices = referenceQuotes(chain, false, is_call);
+  const std::vector<double> time_values = referenceQuotes(chain, true, otm_is_call);
+  ASSERT_TRUE(impliedVolChain(chain, prices, is_call, chain.vol));
+  ChainGreeks out;
+  ASSERT_TRUE(priceChain(chain, out));
+  for (size_t i = 0; i < chain.size(); ++i) {
+    // Time value under the quote's rounding: the solver returns 0 or NaN.
+    if (time_values[i] < 1e-10 * chain.spot[i]) continue;
+    ASSERT_GT(chain.vol[i], 0.0) << i;
+    EXPECT_NEAR(is_call[i] ? out.call[i] : out.put[i], prices[i], 1e-13 * chain.spot[i]) << i;
+  }
+}
+
+TEST(ImpliedVol, NoArbitrageBounds) {
+  const double df = std::exp(-0.05);
+  const OptionChain chain{{100, 100, 100, 100, 100, 100},
+                          {90, 90, 110, 110, 110, 100},
+                          {0.05, 0.05, 0.05, 0.05, 0.05, 0.05},
+                          {},
+                          {1, 1, 1, 1, 1, 1}};
+  const std::vector<double> prices{100 - 90 * df - 1e-6,  // Call below intrinsic
+                                   100.5,                 // Call above spot
+                                   110 * df - 100,        // Put at intrinsic
+                                   110 * df + 1e-6,       // Put above discounted strike
+                                   0.0,                   // Out-of-the-money call at 0
+                                   -1.0};
+  const std::vector<uint8_t> is_call{1, 1, 0, 0, 1, 0};
+  std::vector<double> vols;
+  ImpliedVolStats stats;
+  ASSERT_TRUE(impliedVolChain(chain, prices, is_call, vols, 0, &stats));
+  EXPECT_TRUE(std::isnan(vols[0]));
+  EXPECT_TRUE(std::isnan(vols[1]));
+  EXPECT_EQ(vols[2], 0.0);
+  EXPECT_TRUE(std::isnan(vols[3]));
+  EXPECT_EQ(vols[4], 0.0);
+  EXPECT_TRUE(std::isnan(vols[5]));
+  EXPECT_EQ(stats.converged, 0u);
+  EXPECT_EQ(stats.atIntrinsic, 2u);
+  EXPECT_EQ(stats.rejected, 4u);
+  EXPECT_EQ(stats.iterations, 0u);
+}
+
+TEST(ImpliedVol, RejectsMismatchedInputs) {
+  const OptionChain chain = testChain(10);
+  std::vector<uint8_t> is_call;
+  std::vector<double> prices = referenceQuotes(chain, true, is_call);
+  std::vector<double> vols;
+  is_call.pop_back();
+  EXPECT_FALSE(impliedVolChain(chain, prices, is_call, vols));
+  is_call.push_back(1);
+  prices.pop_back();
+  EXPECT_FALSE(impliedVolChain(chain, prices, is_call, vols));
+  EXPECT_TRUE(vols.empty());
+}
+
+TEST(ImpliedVol, ThreadCountDoesNotChangeResults) {
+  const OptionChain chain = testChain(3 * IMPLIED_VOL_GRAIN + 5);
+  std::vector<uint8_t> is_call;
+  const std::vector<double> prices = referenceQuotes(chain, true, is_call);
+  std::vector<double> single, multi;
+  ImpliedVolStats single_stats, multi_stats;
+  ASSERT_TRUE(impliedVolChain(chain, prices, is_call, single, 1, &single_stats));
+  ASSERT_TRUE(impliedVolChain(chain, prices, is_call, multi, 4, &multi_stats));
+  EXPECT_EQ(single, multi);
+  EXPECT_EQ(single_stats.options, chain.size());
+  EXPECT_EQ(single_stats.iterations, multi_stats.iterations);
+  EXPECT_EQ(single_stats.converged, multi_stats.converged);
+  EXPECT_EQ(single_stats.converged + single_stats.atIntrinsic + single_stats.rejected,
+            single_stats.options);  // None hit the iteration cap
+  EXPECT_EQ(single_stats.maxIterations, multi_stats.maxIterations);
+  EXPECT_LE(single_stats.maxIterations, IMPLIED_VOL_MAX_ITERATIONS);
+  EXPECT_LT(single_stats.iterations, 8 * single_stats.options);
+}
+
+// ---- Monte Carlo engine (monte_carlo.h) ----
+
+TEST(MonteCarloEngine, ThreefryKnownAnswers) {
+  // Random123 known-answer vectors for Threefry-4x64-20.
+  uint64_t zeros[4] = {0, 0, 0, 0};
+  lane_math::threefry4x64(zeros, {0, 0, 0, 0});
+  EXPECT_EQ(zeros[0], 0x09218ebde6c85537u);
+  EXPECT_EQ(zeros[1], 0x55941f5266d86105u);
+  EXPECT_EQ(zeros[2], 0x4bd25e16282434dcu);
+  EXPECT_EQ(zeros[3], 0xee29ec846bd2e40bu);
+  constexpr uint64_t ONES = ~uint64_t{0};
+  uint64_t ones[4] = {ONES, ONES, ONES, ONES};
+  lane_math::threefry4x64(ones, {ONES, ONES, ONES, ONES});
+  EXPECT_EQ(ones[0], 0x29c24097942bba1bu);
+  EXPECT_EQ(ones[1], 0x0371bbfb0f6f4e11u);
+  EXPECT_EQ(ones[2], 0x3c231ffa33f83a1cu);
+  EXPECT_EQ(ones[3], 0xcd29113fde32d168u);
+}
+
+TEST(MonteCarloEngine, EuropeanMatchesClosedForm) {
+  const GbmModel model{100, 0.05, 0.2, 1};
+  MonteCarloConfig config;
+  config.paths = 400000;
+  config.seed = 42;
+  MonteCarloResult call, put;
+  ASSERT_TRUE(monteCarloPrice(model, config, europeanPayoff(100, true), call));
+  ASSERT_TRUE(monteCarloPrice(model, config, europeanPayoff(100, false), put));
+  EXPECT_EQ(call.paths, config.paths);
+  // sd(discounted payoff) is about 14.7: standard error ~0.023.
+  EXPECT_GT(call.standardError, 0.015);
+  EXPECT_LT(call.standardError, 0.03);
+  EXPECT_NEAR(call.price, 10.450583572185565, 4 * call.standardError);
+  EXPECT_NEAR(put.price, 5.573526022256971, 4 * put.standardError);
+}
+
+TEST(MonteCarloEngine, CustomPayoffsSeeTheRiskNeutralMeasure) {
+  const GbmModel model{100, 0.03, 0.3, 2};
+  MonteCarloConfig config;
+  config.paths = 200000;
+  config.steps = 24;
+  const auto terminal = [](const PathBlock& block, double* payoffs) {
+    for (size_t i = 0; i < block.paths; ++i) payoffs[i] = block.spot(block.steps - 1, i);
+  };
+  MonteCarloResult forward, digital;
+  ASSERT_TRUE(monteCarloPrice(model, config, terminal, forward));
+  EXPECT_NEAR(forward.price, 100.0, 4 * forward.standardError);  // Discounted spot: a martingale
+  const auto digital_call = [](const PathBlock& block, double* payoffs) {
+    for (size_t i = 0; i < block.paths; ++i) payoffs[i] = block.spot(block.steps - 1, i) > 110;
+  };
+  ASSERT_TRUE(monteCarloPrice(model, config, digital_call, digital));
+  const double d2 = (std::log(100.0 / 110) + (0.03 - 0.5 * 0.09) * 2) / (0.3 * std::sqrt(2.0));
+  EXPECT_NEAR(digital.price, std::exp(-0.06) * 0.5 * std::erfc(-d2 / std::sqrt(2.0)),
+              4 * digital.standardError);
+}
+
+TEST(MonteCarloEngine, PathDependentPayoffsAreConsistent) {
+  const GbmModel model{100, 0.05, 0.25, 1};
+  MonteCarloConfig config;
+  config.paths = 50000;
+  config.steps = 52;
+  MonteCarloResult european, asian, up_in, up_out, lookback;
+  ASSERT_TRUE(monteCarloPrice(model, config, europeanPayoff(100, true), european));
+  ASSERT_TRUE(monteCarloPrice(model, config, asianPayoff(100, true), asian));
+  ASSERT_TRUE(monteCarloPrice(model, config, barrierPayoff(100, 120, true, true, true), up_in));
+  ASSERT_TRUE(monteCarloPrice(model, config, barrierPayoff(100, 120, true, true, false), up_out));
+  ASSERT_TRUE(monteCarloPrice(model, config, lookbackPayoff(100, true), lookback));
+  // Same paths for every payoff: in + out is the European path by path.
+  EXPECT_NEAR(up_in.price + up_out.price, european.price, 1e-12 * european.price);
+  EXPECT_GT(up_in.price, 0.0);
+  EXPECT_GT(up_out.price, 0.0);
+  EXPECT_LT(asian.price, european.price);  // Averaging lowers the variance
+  EXPECT_GT(asian.price, 0.0);
+  EXPECT_GT(lookback.price, european.price);  // max S >= S_T on every path
+
+  // One monitoring date: the Asian is the European.
+  config.steps = 1;
+  MonteCarloResult single_european, single_asian;
+  ASSERT_TRUE(monteCarloPrice(model, config, europeanPayoff(100, true), single_european));
+  ASSERT_TRUE(monteCarloPrice(model, config, asianPayoff(100, true), single_asian));
+  EXPECT_EQ(single_asian.price, single_european.price);
+}
+
+TEST(MonteCarloEngine, ThreadCountDoesNotChangeResults) {
+  const GbmModel model{100, 0.01, 0.4, 0.5};
+  MonteCarloConfig config;
+  config.paths = 3 * MC_BATCH_PATHS + 77;  // Partial batch and partial block
+  config.steps = 7;
+  config.seed = 0x123456789abcdefull;
+  MonteCarloResult single, multi;
+  config.threads = 1;
+  ASSERT_TRUE(monteCarloPrice(model, config, asianPayoff(95, false), single));
+  config.threads = 4;
+  ASSERT_TRUE(monteCarloPrice(model, config, asianPayoff(95, false), multi));
+  EXPECT_EQ(single.price, multi.price);
+  EXPECT_EQ(single.standardError, multi.standardError);
+
+  // A different seed gives different paths.
+  config.seed += 1;
+  MonteCarloResult reseeded;
+  ASSERT_TRUE(monteCarloPrice(model, config, asianPayoff(95, false), reseeded));
+  EXPECT_NE(reseeded.price, single.price);
+  EXPECT_NEAR(reseeded.price, single.price, 6 * single.standardError);
+}
+
+TEST(MonteCarloEngine, RejectsInvalidConfig) {
+  const GbmModel model{100, 0.05, 0.2, 1};
+  MonteCarloConfig config;
+  MonteCarloResult result;
+  config.paths = 1;
+  EXPECT_FALSE(monteCarloPrice(model, config, europeanPayoff(100, true), result));
+  config.paths = 1000;
+  config.steps = 0;
+  EXPECT_FALSE(monteCarloPrice(model, config, europeanPayoff(100, true), result));
+  config.steps = 1;
+  EXPECT_FALSE(monteCarloPrice(model, config, Payoff{}, result));
+  EXPECT_EQ(result.paths, 0u);
+}
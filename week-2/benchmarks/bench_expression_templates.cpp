@@ -0,0 +1,76 @@
+#include "containers.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+/**
+ * r = a + b * c - d over N doubles, three ways:
+ * - Naive: every operator materializes a temporary vector
+ * - ExpressionTemplate: Vector<T> fuses the tree into one loop
+ * - HandWritten: the fused loop written out over raw pointers
+ */
+
+static Vector<double> filled(size_t n, double seed) {
+  Vector<double> v(n);
+  for (size_t i = 0; i < n; ++i) v[i] = seed + 0.001 * static_cast<double>(i);
+  return v;
+}
+
+static std::vector<double> naiveMul(const std::vector<double>& x, const std::vector<double>& y) {
+  std::vector<double> out(x.size());
+  for (size_t i = 0; i < x.size(); ++i) out[i] = x[i] * y[i];
+  return out;
+}
+
+static std::vector<double> naiveAdd(const std::vector<double>& x, const std::vector<double>& y) {
+  std::vector<double> out(x.size());
+  for (size_t i = 0; i < x.size(); ++i) out[i] = x[i] + y[i];
+  return out;
+}
+
+static std::vector<double> naiveSub(const std::vector<double>& x, const std::vector<double>& y) {
+  std::vector<double> out(x.size());
+  for (size_t i = 0; i < x.size(); ++i) out[i] = x[i] - y[i];
+  return out;
+}
+
+static void BM_Naive(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0), d(n, 4.0), r;
+  for (auto _ : state) {
+    r = naiveSub(naiveAdd(a, naiveMul(b, c)), d);
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(5 * n * sizeof(double)));
+}
+
+static void BM_ExpressionTemplate(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  Vector<double> a = filled(n, 1.0), b = filled(n, 2.0), c = filled(n, 3.0), d = filled(n, 4.0);
+  Vector<double> r(n);
+  for (auto _ : state) {
+    r = a + b * c - d;
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(5 * n * sizeof(double)));
+}
+
+static void BM_HandWritten(benchmark::State& state) {
+  const auto n = static_cast<size_t>(state.range(0));
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0), d(n, 4.0), r(n);
+  for (auto _ : state) {
+    const double* __restrict pa = a.data();
+    const double* __restrict pb = b.data();
+    const double* __restrict pc = c.data();
+    const double* __restrict pd = d.data();
+    double* __restrict pr = r.data();
+    for (size_t i = 0; i < n; ++i) pr[i] = pa[i] + pb[i] * pc[i] - pd[i];
+    benchmark::DoNotOptimize(r.data());
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(5 * n * sizeof(double)));
+}
+
+BENCHMARK(BM_Naive)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_ExpressionTemplate)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+BENCHMARK(BM_HandWritten)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,107 @@
+#include "templates.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+/**
+ * Array<T, N> (unrolled ops, tree reductions, sorting networks) against
+ * std::array with generic loops and std::sort, for 4/8/16-element ladders.
+ * Each iteration processes a batch of ladders so the work is not dominated
+ * by loop overhead.
+ */
+
+constexpr size_t LADDERS = 1024;
+
+template <size_t N>
+static std::vector<Array<double, N>> makeLadders() {
+  std::mt19937_64 rng(1);
+  std::uniform_real_distribution<double> dist(99.0, 101.0);
+  std::vector<Array<double, N>> ladders(LADDERS);
+  for (auto& l : ladders) {
+    for (auto& px : l) px = dist(rng);
+  }
+  return ladders;
+}
+
+template <size_t N>
+static std::vector<std::array<double, N>> makeStdLadders() {
+  auto src = makeLadders<N>();
+  std::vector<std::array<double, N>> ladders(LADDERS);
+  for (size_t i = 0; i < LADDERS; ++i) std::copy(src[i].begin(), src[i].end(), ladders[i].begin());
+  return ladders;
+}
+
+// Weighted mid: sum(px * qty) over the ladder.
+template <size_t N>
+static void BM_ArrayDot(benchmark::State& state) {
+  auto px = makeLadders<N>();
+  const auto qty = Array<double, N>::filled(2.0);
+  for (auto _ : state) {
+    double total = 0;
+    for (const auto& l : px) total += dot(l, qty);
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * LADDERS);
+}
+
+template <size_t N>
+static void BM_StdArrayDot(benchmark::State& state) {
+  auto px = makeStdLadders<N>();
+  std::array<double, N> qty;
+  qty.fill(2.0);
+  for (auto _ : state) {
+    double total = 0;
+    for (const auto& l : px) {
+      double s = 0;
+      for (size_t i = 0; i < N; ++i) s += l[i] * qty[i];
+      total += s;
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(state.iterations() * LADDERS);
+}
+
+template <size_t N>
+static void BM_ArraySort(benchmark::State& state) {
+  const auto src = makeLadders<N>();
+  auto work = src;
+  for (auto _ : state) {
+    state.PauseTiming();
+    work = src;
+    state.ResumeTiming();
+    for (auto& l : work) l.sort();
+    benchmark::DoNotOptimize(work.data());
+  }
+  state.SetItemsProcessed(state.iterations() * LADDERS);
+}
+
+template <size_t N>
+static void BM_StdArraySort(benchmark::State& state) {
+  const auto src = makeStdLadders<N>();
+  auto work = src;
+  for (auto _ : state) {
+    state.PauseTiming();
+    work = src;
+    state.ResumeTiming();
+    for (auto& l : work) std::sort(l.begin(), l.end());
+    benchmark::DoNotOptimize(work.data());
+  }
+  state.SetItemsProcessed(state.iterations() * LADDERS);
+}
+
+BENCHMARK_TEMPLATE(BM_ArrayDot, 4);
+BENCHMARK_TEMPLATE(BM_StdArrayDot, 4);
+BENCHMARK_TEMPLATE(BM_ArrayDot, 8);
+BENCHMARK_TEMPLATE(BM_StdArrayDot, 8);
+BENCHMARK_TEMPLATE(BM_ArrayDot, 16);
+BENCHMARK_TEMPLATE(BM_StdArrayDot, 16);
+BENCHMARK_TEMPLATE(BM_ArraySort, 4);
+BENCHMARK_TEMPLATE(BM_StdArraySort, 4);
+BENCHMARK_TEMPLATE(BM_ArraySort, 8);
+BENCHMARK_TEMPLATE(BM_StdArraySort, 8);
+BENCHMARK_TEMPLATE(BM_ArraySort, 16);
+BENCHMARK_TEMPLATE(BM_StdArraySort, 16);
+
+BENCHMARK_MAIN();
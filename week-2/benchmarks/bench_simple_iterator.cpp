@@ -0,0 +1,109 @@
+#include "simple_iterator.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * Algorithm cost through SimpleIterator before and after it became a
+ * contiguous iterator. "Before" is ForwardOnlyIterator, the original
+ * ++/==/!= interface: std::distance walks every element, std::copy is an
+ * element-by-element loop, and std::sort does not compile at all, so raw
+ * pointers stand in as the reference for sort.
+ */
+
+template <typename T>
+class ForwardOnlyIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  ForwardOnlyIterator() : ptr_(nullptr) {}
+  explicit ForwardOnlyIterator(pointer ptr) : ptr_(ptr) {}
+  reference operator*() const { return *ptr_; }
+  ForwardOnlyIterator& operator++() { ++ptr_; return *this; }
+  ForwardOnlyIterator operator++(int) { ForwardOnlyIterator t(*this); ++ptr_; return t; }
+  bool operator==(const ForwardOnlyIterator& o) const { return ptr_ == o.ptr_; }
+  bool operator!=(const ForwardOnlyIterator& o) const { return ptr_ != o.ptr_; }
+
+ private:
+  pointer ptr_;
+};
+
+template <template <typename> class It>
+static void BM_Distance(benchmark::State& state) {
+  std::vector<int> v(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    auto d = std::distance(It<int>(v.data()), It<int>(v.data() + v.size()));
+    benchmark::DoNotOptimize(d);
+  }
+}
+
+template <template <typename> class It>
+static void BM_Copy(benchmark::State& state) {
+  std::vector<int> src(static_cast<size_t>(state.range(0)));
+  std::iota(src.begin(), src.end(), 0);
+  std::vector<int> dst(src.size());
+  for (auto _ : state) {
+    std::copy(It<int>(src.data()), It<int>(src.data() + src.size()), dst.data());
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(int)));
+}
+
+template <template <typename> class It>
+static void BM_LowerBound(benchmark::State& state) {
+  std::vector<int> v(static_cast<size_t>(state.range(0)));
+  std::iota(v.begin(), v.end(), 0);
+  int key = 0;
+  for (auto _ : state) {
+    auto it = std::lower_bound(It<int>(v.data()), It<int>(v.data() + v.size()), key);
+    benchmark::DoNotOptimize(it);
+    key = (key + 7919) % static_cast<int>(v.size());
+  }
+}
+
+static void BM_SortSimpleIterator(benchmark::State& state) {
+  std::vector<int> src(static_cast<size_t>(state.range(0)));
+  std::mt19937 rng(3);
+  for (auto& x : src) x = static_cast<int>(rng());
+  std::vector<int> work;
+  for (auto _ : state) {
+    state.PauseTiming();
+    work = src;
+    state.ResumeTiming();
+    std::sort(SimpleIterator<int>(work.data()), SimpleIterator<int>(work.data() + work.size()));
+    benchmark::DoNotOptimize(work.data());
+  }
+}
+
+static void BM_SortRawPointer(benchmark::State& state) {
+  std::vector<int> src(static_cast<size_t>(state.range(0)));
+  std::mt19937 rng(3);
+  for (auto& x : src) x = static_cast<int>(rng());
+  std::vector<int> work;
+  for (auto _ : state) {
+    state.PauseTiming();
+    work = src;
+    state.ResumeTiming();
+    std::sort(work.data(), work.data() + work.size());
+    benchmark::DoNotOptimize(work.data());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Distance, ForwardOnlyIterator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Distance, SimpleIterator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Copy, ForwardOnlyIterator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Copy, SimpleIterator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LowerBound, ForwardOnlyIterator)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_LowerBound, SimpleIterator)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SortSimpleIterator)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_SortRawPointer)->Range(1 << 10, 1 << 16);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+#include "containers.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+/**
+ * Short-lived small collections: each iteration builds a fresh container,
+ * pushes a handful of elements (like an operator stack while parsing one
+ * expression) and drains it again.
+ */
+
+constexpr size_t INLINE_CAPACITY = 16;
+
+template <typename Container>
+static void pushPopVectorLike(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container c;
+    for (int i = 0; i < count; ++i) c.push_back(i);
+    benchmark::DoNotOptimize(c.data());
+    while (!c.empty()) c.pop_back();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename Container>
+static void pushPopStackLike(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    Container c;
+    for (int i = 0; i < count; ++i) c.push(i);
+    benchmark::DoNotOptimize(c.top());
+    while (!c.empty()) c.pop();
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void BM_StdVector(benchmark::State& state) { pushPopVectorLike<std::vector<int>>(state); }
+static void BM_SmallVector(benchmark::State& state) {
+  pushPopVectorLike<SmallVector<int, INLINE_CAPACITY>>(state);
+}
+static void BM_Stack(benchmark::State& state) { pushPopStackLike<Stack<int>>(state); }
+static void BM_StaticStack(benchmark::State& state) {
+  pushPopStackLike<StaticStack<int, 64>>(state);
+}
+
+// Non-trivial element type: relocation goes through move constructors.
+static void BM_StdVectorString(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    std::vector<std::string> c;
+    for (int i = 0; i < count; ++i) c.emplace_back("op");
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+
+static void BM_SmallVectorString(benchmark::State& state) {
+  const auto count = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    SmallVector<std::string, INLINE_CAPACITY> c;
+    for (int i = 0; i < count; ++i) c.emplace_back("op");
+    benchmark::DoNotOptimize(c.data());
+  }
+}
+
+// 4 and 16 stay inline; 64 forces SmallVector to spill.
+BENCHMARK(BM_StdVector)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_SmallVector)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_Stack)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_StaticStack)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK(BM_StdVectorString)->Arg(4)->Arg(16);
+BENCHMARK(BM_SmallVectorString)->Arg(4)->Arg(16);
+
+BENCHMARK_MAIN();
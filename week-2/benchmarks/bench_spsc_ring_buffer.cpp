@@ -0,0 +1,118 @@
+#include "spsc_ring_buffer.h"
+#include <benchmark/benchmark.h>
+#include <pthread.h>
+#include <sched.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * SPSC ring buffer latency and throughput with the producer and consumer
+ * pinned to separate cores (cores 0 and 1 by default). When the machine has
+ * a single core, pinning is skipped and the "pinned" counter reports 0.
+ */
+
+constexpr int PRODUCER_CORE = 0;
+constexpr int CONSUMER_CORE = 1;
+constexpr size_t QUEUE_CAPACITY = 1024;
+
+// Pins the calling thread to core; if previous is given, it receives the
+// affinity mask to hand back to restoreAffinity() afterwards.
+static bool pinCurrentThread(int core, cpu_set_t* previous = nullptr) {
+  if (core >= static_cast<int>(std::thread::hardware_concurrency())) return false;
+  if (previous != nullptr &&
+      pthread_getaffinity_np(pthread_self(), sizeof(*previous), previous) != 0) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+static void restoreAffinity(const cpu_set_t& previous) {
+  pthread_setaffinity_np(pthread_self(), sizeof(previous), &previous);
+}
+
+// Items per second moving a stream of integers producer -> consumer.
+static void BM_Throughput(benchmark::State& state) {
+  const auto batch = static_cast<size_t>(state.range(0));
+  constexpr int64_t ITEMS = 1 << 20;
+  cpu_set_t previous;
+  const bool pinned = pinCurrentThread(CONSUMER_CORE, &previous);
+  std::vector<uint64_t> in(batch), out(batch);
+
+  for (auto _ : state) {
+    SpscRingBuffer<uint64_t> queue(QUEUE_CAPACITY);
+    std::thread producer([&] {
+      pinCurrentThread(PRODUCER_CORE);
+      int64_t sent = 0;
+      while (sent < ITEMS) {
+        const size_t want = static_cast<size_t>(std::min<int64_t>(batch, ITEMS - sent));
+        size_t n = batch == 1 ? (queue.tryPush(static_cast<uint64_t>(sent)) ? 1 : 0)
+                              : queue.tryPushBatch(in.data(), want);
+        if (n == 0) std::this_thread::yield();
+        sent += static_cast<int64_t>(n);
+      }
+    });
+    int64_t received = 0;
+    uint64_t sink = 0;
+    while (received < ITEMS) {
+      size_t n = 0;
+      if (batch == 1) {
+        n = queue.tryPop(out[0]) ? 1 : 0;
+      } else {
+        n = queue.tryPopBatch(out.data(), batch);
+      }
+      if (n == 0) std::this_thread::yield();
+      sink += out[0];
+      received += static_cast<int64_t>(n);
+    }
+    benchmark::DoNotOptimize(sink);
+    producer.join();
+  }
+  if (pinned) restoreAffinity(previous);
+  state.SetItemsProcessed(state.iterations() * ITEMS);
+  state.counters["pinned"] = pinned ? 1 : 0;
+}
+
+// Round-trip ping-pong over two queues; reports one-way latency.
+static void BM_PingPongLatency(benchmark::State& state) {
+  constexpr int ROUND_TRIPS = 1 << 14;
+  cpu_set_t previous;
+  const bool pinned = pinCurrentThread(CONSUMER_CORE, &previous);
+  double total_seconds = 0.0;
+
+  for (auto _ : state) {
+    SpscRingBuffer<int> ping(QUEUE_CAPACITY), pong(QUEUE_CAPACITY);
+    std::thread echo([&] {
+      pinCurrentThread(PRODUCER_CORE);
+      int val;
+      for (int i = 0; i < ROUND_TRIPS; ++i) {
+        while (!ping.tryPop(val)) std::this_thread::yield();
+        while (!pong.tryPush(val)) std::this_thread::yield();
+      }
+    });
+    const auto start = std::chrono::steady_clock::now();
+    int val;
+    for (int i = 0; i < ROUND_TRIPS; ++i) {
+      while (!ping.tryPush(i)) std::this_thread::yield();
+      while (!pong.tryPop(val)) std::this_thread::yield();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    echo.join();
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    state.SetIterationTime(seconds);
+    total_seconds += seconds;
+  }
+  if (pinned) restoreAffinity(previous);
+  state.counters["one_way_ns"] = benchmark::Counter(total_seconds * 1e9 / (2.0 * ROUND_TRIPS),
+                                                    benchmark::Counter::kAvgIterations);
+  state.counters["pinned"] = pinned ? 1 : 0;
+}
+
+BENCHMARK(BM_Throughput)->Arg(1)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PingPongLatency)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
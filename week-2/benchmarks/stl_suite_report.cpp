@@ -0,0 +1,40 @@
+#include "containers.h"
+#include "stl_benchmark.h"
+#include <deque>
+#include <iostream>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Runs STLBenchmark over the standard and project containers and writes
+ * the results to <prefix>.csv and <prefix>.json.
+ *
+ * Usage: stl_suite_report [prefix=stl_benchmark] [size=10000]
+ */
+
+int main(int argc, char** argv) {
+  const std::string prefix = argc > 1 ? argv[1] : "stl_benchmark";
+  const size_t size = argc > 2 ? std::stoul(argv[2]) : 10000;
+
+  STLBenchmark bench;
+  bench.runAll<std::vector<int>>("std::vector", size);
+  bench.runAll<std::list<int>>("std::list", size);
+  bench.runAll<std::deque<int>>("std::deque", size);
+  bench.runAll<std::map<int, int>>("std::map", size);
+  bench.runAll<std::unordered_map<int, int>>("std::unordered_map", size);
+  bench.runAll<SmallVector<int, 64>>("SmallVector<64>", size);
+  bench.runAll<Stack<int>>("Stack", size);
+  // HashTable joins once src/hash_table_impl.cpp is implemented: today its
+  // insert/find are no-op stubs, and their timings would sit next to the
+  // real containers' in the exports as if they were comparable.
+
+  bench.toCsv(std::cout);
+  if (!bench.writeCsv(prefix + ".csv") || !bench.writeJson(prefix + ".json")) {
+    std::cerr << "failed to write " << prefix << ".csv/.json\n";
+    return 1;
+  }
+  return 0;
+}
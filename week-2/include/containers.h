@@ -1,6 +1,15 @@
 #pragma once
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "expression_template.h"
+
 /**
  * TODO: Implement Template Container Classes
  * 
@@ -15,14 +24,45 @@
  * - empty(), size()
  */
 
+/**
+ * Vector<T> takes part in expression templates (see expression_template.h):
+ * `Vector<double> r = a + b * c;` runs one fused, vectorizable loop with no
+ * intermediate Vector. Operands must have equal sizes.
+ */
 template <typename T>
-class Vector {
+class Vector : public VecExpr<Vector<T>> {
  public:
+  static constexpr bool IS_EXPR_LEAF = true;
+
   explicit Vector(size_t size) : data_(size) {}
+
+  template <typename E>
+  Vector(const VecExpr<E>& expr) : data_(expr.size()) {  // NOLINT: implicit by design
+    assign(expr.self());
+  }
+
+  template <typename E>
+  Vector& operator=(const VecExpr<E>& expr) {
+    data_.resize(expr.size());
+    assign(expr.self());
+    return *this;
+  }
+
   T& operator[](size_t i) { return data_[i]; }
   const T& operator[](size_t i) const { return data_[i]; }
   size_t size() const { return data_.size(); }
+  T* data() { return data_.data(); }
+  const T* data() const { return data_.data(); }
+
  private:
+  // Element i only reads element i of each operand, so `a = a + b` is safe.
+  template <typename E>
+  void assign(const E& expr) {
+    T* out = data_.data();
+    const size_t n = data_.size();
+    for (size_t i = 0; i < n; ++i) out[i] = static_cast<T>(expr[i]);
+  }
+
   std::vector<T> data_;
 };
 
@@ -37,3 +77,298 @@ class Stack {
  private:
   std::vector<T> data_;
 };
+
+/**
+ * Trivial relocation trait
+ *
+ * A type is trivially relocatable when moving it to a new address and
+ * ending the old object's lifetime is equivalent to a memcpy. Every
+ * trivially copyable type qualifies; specialize for types such as
+ * std::unique_ptr-like handles that are not trivially copyable but do
+ * not care about their own address.
+ */
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool IS_TRIVIALLY_RELOCATABLE = IsTriviallyRelocatable<T>::value;
+
+namespace container_detail {
+
+template <typename T>
+void destroy(T* first, size_t count) {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (size_t i = 0; i < count; ++i) first[i].~T();
+  }
+}
+
+// Move-construct count elements from src into raw storage at dst and destroy
+// the sources. Falls back to memcpy for trivially relocatable types. Types
+// whose move may throw are copied; if a copy throws, the elements already
+// built in dst are destroyed and src is left untouched.
+template <typename T>
+void relocate(T* src, size_t count, T* dst) {
+  if constexpr (IS_TRIVIALLY_RELOCATABLE<T>) {
+    if (count > 0) {
+      std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+    }
+  } else {
+    size_t built = 0;
+    try {
+      for (; built < count; ++built) {
+        ::new (static_cast<void*>(dst + built)) T(std::move_if_noexcept(src[built]));
+      }
+    } catch (...) {
+      destroy(dst, built);
+      throw;
+    }
+    destroy(src, count);
+  }
+}
+
+template <typename T>
+inline constexpr bool IS_NOTHROW_RELOCATABLE =
+    IS_TRIVIALLY_RELOCATABLE<T> || std::is_nothrow_move_constructible_v<T>;
+
+}  // namespace container_detail
+
+/**
+ * SmallVector<T, N> - vector with inline storage for N elements
+ *
+ * - Stores up to N elements inside the object, no heap allocation
+ * - Spills to the heap (doubling growth) once size exceeds N
+ * - Moving a heap-backed vector steals the buffer; moving an inline one
+ *   relocates the elements (memcpy when T is trivially relocatable)
+ * - isInline() reports whether the elements currently live in the object
+ *
+ * Typical use: short-lived scratch collections such as operator stacks,
+ * where the common case fits in N and never touches the allocator.
+ */
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs at least one inline slot");
+
+ public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  SmallVector() : data_(inlineData()), size_(0), capacity_(N) {}
+
+  SmallVector(std::initializer_list<T> init) : SmallVector() {
+    reserve(init.size());
+    for (const auto& val : init) push_back(val);
+  }
+
+  SmallVector(const SmallVector& other) : SmallVector() {
+    reserve(other.size_);
+    std::uninitialized_copy(other.begin(), other.end(), data_);
+    size_ = other.size_;
+  }
+
+  SmallVector(SmallVector&& other) noexcept(container_detail::IS_NOTHROW_RELOCATABLE<T>)
+      : SmallVector() {
+    takeFrom(other);
+  }
+
+  ~SmallVector() { release(); }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other) {
+      SmallVector copy(other);
+      resetToInline();
+      takeFrom(copy);
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept(
+      container_detail::IS_NOTHROW_RELOCATABLE<T>) {
+    if (this != &other) {
+      resetToInline();
+      takeFrom(other);
+    }
+    return *this;
+  }
+
+  void push_back(const T& val) { emplace_back(val); }
+  void push_back(T&& val) { emplace_back(std::move(val)); }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ == capacity_) {
+      // Construct first: args may alias an element that grow() relocates.
+      T tmp(std::forward<Args>(args)...);
+      grow(capacity_ * 2);
+      ::new (static_cast<void*>(data_ + size_)) T(std::move(tmp));
+    } else {
+      ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+    }
+    return data_[size_++];
+  }
+
+  void pop_back() { data_[--size_].~T(); }
+
+  void clear() {
+    container_detail::destroy(data_, size_);
+    size_ = 0;
+  }
+
+  void reserve(size_t new_capacity) {
+    if (new_capacity > capacity_) grow(new_capacity);
+  }
+
+  T& operator[](size_t i) { return data_[i]; }
+  const T& operator[](size_t i) const { return data_[i]; }
+  T& back() { return data_[size_ - 1]; }
+  const T& back() const { return data_[size_ - 1]; }
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  bool empty() const { return size_ == 0; }
+  bool isInline() const { return data_ == inlineData(); }
+
+ private:
+  T* inlineData() { return std::launder(reinterpret_cast<T*>(inline_)); }
+  const T* inlineData() const { return std::launder(reinterpret_cast<const T*>(inline_)); }
+
+  struct Deallocate {
+    void operator()(T* p) const { ::operator delete(p, std::align_val_t{alignof(T)}); }
+  };
+
+  // Strong guarantee: if relocating throws, the new buffer is freed and
+  // *this keeps its elements.
+  void grow(size_t new_capacity) {
+    std::unique_ptr<T, Deallocate> fresh(static_cast<T*>(
+        ::operator new(new_capacity * sizeof(T), std::align_val_t{alignof(T)})));
+    container_detail::relocate(data_, size_, fresh.get());
+    if (!isInline()) Deallocate{}(data_);
+    data_ = fresh.release();
+    capacity_ = new_capacity;
+  }
+
+  void release() {
+    container_detail::destroy(data_, size_);
+    if (!isInline()) Deallocate{}(data_);
+  }
+
+  // Destroys the elements and frees a heap buffer, leaving *this empty and
+  // inline (the precondition of takeFrom).
+  void resetToInline() {
+    release();
+    data_ = inlineData();
+    size_ = 0;
+    capacity_ = N;
+  }
+
+  // Precondition: *this is empty and inline.
+  void takeFrom(SmallVector& other) noexcept(container_detail::IS_NOTHROW_RELOCATABLE<T>) {
+    if (other.isInline()) {
+      container_detail::relocate(other.data_, other.size_, data_);
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.data_ = other.inlineData();
+      other.capacity_ = N;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  alignas(T) unsigned char inline_[N * sizeof(T)];
+  T* data_;
+  size_t size_;
+  size_t capacity_;
+};
+
+/**
+ * StaticStack<T, N> - LIFO stack with fixed inline capacity
+ *
+ * - Never allocates; all N slots live inside the object
+ * - push()/emplace() return false when the stack is full
+ * - Copies and moves are element-wise (memcpy when T is trivially
+ *   relocatable), so the stack is cheap to return by value
+ */
+template <typename T, size_t N>
+class StaticStack {
+  static_assert(N > 0, "StaticStack needs at least one slot");
+
+ public:
+  StaticStack() : size_(0) {}
+
+  StaticStack(const StaticStack& other) : size_(0) {
+    std::uninitialized_copy(other.slots(), other.slots() + other.size_, slots());
+    size_ = other.size_;
+  }
+
+  StaticStack(StaticStack&& other) noexcept(container_detail::IS_NOTHROW_RELOCATABLE<T>)
+      : size_(0) {
+    takeFrom(other);
+  }
+
+  ~StaticStack() { clear(); }
+
+  StaticStack& operator=(const StaticStack& other) {
+    if (this != &other) {
+      StaticStack copy(other);
+      clear();
+      takeFrom(copy);
+    }
+    return *this;
+  }
+
+  StaticStack& operator=(StaticStack&& other) noexcept(
+      container_detail::IS_NOTHROW_RELOCATABLE<T>) {
+    if (this != &other) {
+      clear();
+      takeFrom(other);
+    }
+    return *this;
+  }
+
+  bool push(const T& val) { return emplace(val); }
+  bool push(T&& val) { return emplace(std::move(val)); }
+
+  template <typename... Args>
+  bool emplace(Args&&... args) {
+    if (size_ == N) return false;
+    ::new (static_cast<void*>(slots() + size_)) T(std::forward<Args>(args)...);
+    ++size_;
+    return true;
+  }
+
+  void pop() { slots()[--size_].~T(); }
+  T& top() { return slots()[size_ - 1]; }
+  const T& top() const { return slots()[size_ - 1]; }
+
+  void clear() {
+    container_detail::destroy(slots(), size_);
+    size_ = 0;
+  }
+
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ == N; }
+  size_t size() const { return size_; }
+  static constexpr size_t capacity() { return N; }
+
+ private:
+  T* slots() { return std::launder(reinterpret_cast<T*>(storage_)); }
+  const T* slots() const { return std::launder(reinterpret_cast<const T*>(storage_)); }
+
+  // Precondition: *this is empty.
+  void takeFrom(StaticStack& other) noexcept(container_detail::IS_NOTHROW_RELOCATABLE<T>) {
+    container_detail::relocate(other.slots(), other.size_, slots());
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  alignas(T) unsigned char storage_[N * sizeof(T)];
+  size_t size_;
+};
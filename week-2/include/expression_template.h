@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+/**
+ * Expression Templates for element-wise vector arithmetic
+ *
+ * - VecExpr<E> is the CRTP base every expression derives from
+ * - Operators (+, -, *, /) build lightweight VecBinary nodes instead of
+ *   computing anything; scalars are broadcast through VecScalar
+ * - A container evaluates the whole tree in one loop when it is assigned
+ *   or constructed from an expression: no temporaries, no allocation
+ *
+ * Leaf containers opt in with `static constexpr bool IS_EXPR_LEAF = true;`
+ * and are captured by reference; interior nodes are captured by value.
+ * An expression must therefore not outlive the containers it refers to
+ * (don't store `auto e = a + b;` past the lifetime of a or b).
+ */
+
+template <typename E>
+class VecExpr {
+ public:
+  const E& self() const { return static_cast<const E&>(*this); }
+  size_t size() const { return self().size(); }
+  decltype(auto) operator[](size_t i) const { return self()[i]; }
+};
+
+// Leaves by const reference, interior nodes by value.
+template <typename E>
+using ExprHold = std::conditional_t<E::IS_EXPR_LEAF, const E&, const E>;
+
+template <typename S>
+class VecScalar : public VecExpr<VecScalar<S>> {
+ public:
+  static constexpr bool IS_EXPR_LEAF = false;
+  explicit VecScalar(S value) : value_(value) {}
+  // A scalar has no extent of its own; the sibling operand supplies it.
+  size_t size() const { return 0; }
+  S operator[](size_t) const { return value_; }
+ private:
+  S value_;
+};
+
+template <typename L, typename R, typename Op>
+class VecBinary : public VecExpr<VecBinary<L, R, Op>> {
+ public:
+  static constexpr bool IS_EXPR_LEAF = false;
+  VecBinary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {}
+  size_t size() const { return lhs_.size() != 0 ? lhs_.size() : rhs_.size(); }
+  auto operator[](size_t i) const { return Op{}(lhs_[i], rhs_[i]); }
+ private:
+  ExprHold<L> lhs_;
+  ExprHold<R> rhs_;
+};
+
+template <typename T>
+inline constexpr bool IS_EXPR_SCALAR = std::is_arithmetic_v<T>;
+
+#define EXPRESSION_TEMPLATE_BINARY_OP(OP, FUNCTOR)                                         \
+  template <typename L, typename R>                                                        \
+  VecBinary<L, R, FUNCTOR> operator OP(const VecExpr<L>& lhs, const VecExpr<R>& rhs) {     \
+    return {lhs.self(), rhs.self()};                                                       \
+  }                                                                                        \
+  template <typename L, typename S, std::enable_if_t<IS_EXPR_SCALAR<S>, int> = 0>          \
+  VecBinary<L, VecScalar<S>, FUNCTOR> operator OP(const VecExpr<L>& lhs, S rhs) {          \
+    return {lhs.self(), VecScalar<S>(rhs)};                                                \
+  }                                                                                        \
+  template <typename S, typename R, std::enable_if_t<IS_EXPR_SCALAR<S>, int> = 0>          \
+  VecBinary<VecScalar<S>, R, FUNCTOR> operator OP(S lhs, const VecExpr<R>& rhs) {          \
+    return {VecScalar<S>(lhs), rhs.self()};                                                \
+  }
+
+EXPRESSION_TEMPLATE_BINARY_OP(+, std::plus<>)
+EXPRESSION_TEMPLATE_BINARY_OP(-, std::minus<>)
+EXPRESSION_TEMPLATE_BINARY_OP(*, std::multiplies<>)
+EXPRESSION_TEMPLATE_BINARY_OP(/, std::divides<>)
+
+#undef EXPRESSION_TEMPLATE_BINARY_OP
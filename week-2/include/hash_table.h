@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 #include <map>
 
 /**
@@ -16,6 +17,9 @@
 template <typename K, typename V>
 class HashTable {
  public:
+  using key_type = K;
+  using mapped_type = V;
+
   void insert(const K& key, const V& val);
   bool find(const K& key, V& val) const;
   size_t size() const;
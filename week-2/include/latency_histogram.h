@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * LatencyHistogram - HDR-style log-bucketed histogram of uint64 values
+ *
+ * - Values below 2^SUB_BUCKET_BITS are counted exactly
+ * - Above that, every power-of-two range is split into 2^(SUB_BUCKET_BITS-1)
+ *   linear sub-buckets, so any recorded value is reported within
+ *   1 / 2^(SUB_BUCKET_BITS-1) (~1.6%) relative error
+ * - record() is O(1) with no allocation; the whole uint64 range fits in a
+ *   fixed ~30KB count array
+ * - min()/max() are tracked exactly; percentile() returns the highest value
+ *   equivalent to the bucket holding that rank
+ */
+
+class LatencyHistogram {
+ public:
+  static constexpr unsigned SUB_BUCKET_BITS = 7;
+
+  LatencyHistogram();
+
+  void record(uint64_t value);
+  void reset();
+
+  uint64_t count() const { return count_; }
+  uint64_t min() const { return count_ == 0 ? 0 : min_; }
+  uint64_t max() const { return max_; }
+  double mean() const;
+  // p in [0, 100]; percentile(50) is the median.
+  uint64_t percentile(double p) const;
+
+ private:
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t highestEquivalentValue(size_t index);
+
+  std::vector<uint64_t> counts_;
+  uint64_t count_;
+  uint64_t min_;
+  uint64_t max_;
+  long double sum_;
+};
@@ -1,27 +1,210 @@
 #pragma once
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+#include "latency_histogram.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PERFORMANCE_ANALYZER_HAS_TSC 1
+#endif
 
 /**
- * TODO: Implement Performance Measurement Tool
+ * Performance Measurement Tool
  * 
  * Requirements:
  * - measure(func) - Execute function and return time in microseconds
  * - Works with any callable (function, lambda, functor)
  * 
  * Use std::chrono for high-resolution timing
+ *
+ * Hardware counters:
+ * - measureWithCounters(func, operations) - wall time plus Linux
+ *   perf_event_open counters (cycles, instructions, cache misses, branch
+ *   misses, dTLB misses) around the callable
+ * - Reports IPC and misses per operation
+ * - Each counter is opened on its own, so a counter the kernel/VM does not
+ *   expose is simply marked unavailable; when none can be opened (non-Linux,
+ *   perf_event_paranoid, containers) only wall time is reported
+ *
+ * Latency distributions:
+ * - measureLatency(func, iterations) - times every call with TscClock and
+ *   records nanoseconds into a LatencyHistogram
+ * - Timer overhead (cost of an empty start/stop pair) is measured first and
+ *   subtracted from each sample
+ * - Reports p50/p90/p99/p99.9/max
+ */
+
+enum class HardwareEvent { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, DTLB_MISSES };
+
+inline constexpr size_t HARDWARE_EVENT_COUNT = 5;
+
+const char* hardwareEventName(HardwareEvent e);
+
+struct HardwareCounters {
+  uint64_t values[HARDWARE_EVENT_COUNT] = {};
+  bool valid[HARDWARE_EVENT_COUNT] = {};
+
+  bool has(HardwareEvent e) const { return valid[static_cast<size_t>(e)]; }
+  uint64_t get(HardwareEvent e) const { return values[static_cast<size_t>(e)]; }
+  bool anyAvailable() const;
+};
+
+struct PerfMeasurement {
+  long long wall_us = 0;
+  size_t operations = 1;
+  HardwareCounters counters;
+
+  // Instructions per cycle; 0 when either counter is unavailable.
+  double ipc() const;
+  // Counter value divided by operations; -1 when the counter is unavailable.
+  double perOperation(HardwareEvent e) const;
+  // One line: wall time, IPC and per-operation counters ("n/a" if missing).
+  void report(std::ostream& out) const;
+};
+
+/**
+ * RAII set of perf_event_open file descriptors counting the calling thread
+ * (user space only). Values are scaled for multiplexing.
+ */
+class PerfCounterSet {
+ public:
+  PerfCounterSet();
+  ~PerfCounterSet();
+  PerfCounterSet(const PerfCounterSet&) = delete;
+  PerfCounterSet& operator=(const PerfCounterSet&) = delete;
+
+  bool available() const;
+  void start();
+  HardwareCounters stop();
+
+ private:
+  int fds_[HARDWARE_EVENT_COUNT];
+};
+
+/**
+ * TscClock - cycle-resolution timestamps
+ *
+ * - x86 with an invariant TSC: lfence+rdtsc to start, rdtscp+lfence to stop,
+ *   so the measured code cannot be reordered around the reads
+ * - Anywhere else: falls back to steady_clock, one tick per nanosecond
+ * - nsPerTick() is calibrated once against steady_clock (~10ms) and cached
  */
+class TscClock {
+ public:
+  static uint64_t start();
+  static uint64_t stop();
+  static bool usesTsc();
+  static double nsPerTick();
+  static double toNanoseconds(uint64_t ticks) { return static_cast<double>(ticks) * nsPerTick(); }
+};
+
+struct LatencyReport {
+  uint64_t iterations = 0;
+  double timer_overhead_ns = 0;
+  uint64_t min_ns = 0;
+  uint64_t p50_ns = 0;
+  uint64_t p90_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t p999_ns = 0;
+  uint64_t max_ns = 0;
+  double mean_ns = 0;
+  LatencyHistogram histogram;
+};
 
 class PerformanceAnalyzer {
  public:
   template <typename Func>
   long long measure(Func f);
+
+  template <typename Func>
+  PerfMeasurement measureWithCounters(Func f, size_t operations = 1);
+
+  template <typename Func>
+  LatencyReport measureLatency(Func f, size_t iterations, size_t warmup = 100);
+
+  // True when at least one hardware counter can be read on this machine.
+  static bool countersAvailable();
+
+  // Minimum cost, in ticks, of an empty TscClock::start()/stop() pair.
+  static uint64_t timerOverheadTicks();
 };
 
+inline uint64_t TscClock::start() {
+#ifdef PERFORMANCE_ANALYZER_HAS_TSC
+  if (usesTsc()) {
+    _mm_lfence();
+    return __rdtsc();
+  }
+#endif
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+inline uint64_t TscClock::stop() {
+#ifdef PERFORMANCE_ANALYZER_HAS_TSC
+  if (usesTsc()) {
+    unsigned aux;
+    const uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+  }
+#endif
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
 template <typename Func>
 long long PerformanceAnalyzer::measure(Func f) {
-  // TODO: Measure execution time of function f
   auto start = std::chrono::high_resolution_clock::now();
   f();
   auto end = std::chrono::high_resolution_clock::now();
   return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 }
+
+template <typename Func>
+PerfMeasurement PerformanceAnalyzer::measureWithCounters(Func f, size_t operations) {
+  PerfMeasurement result;
+  result.operations = operations == 0 ? 1 : operations;
+  PerfCounterSet counters;
+  auto start = std::chrono::high_resolution_clock::now();
+  counters.start();
+  f();
+  result.counters = counters.stop();
+  auto end = std::chrono::high_resolution_clock::now();
+  result.wall_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  return result;
+}
+
+template <typename Func>
+LatencyReport PerformanceAnalyzer::measureLatency(Func f, size_t iterations, size_t warmup) {
+  for (size_t i = 0; i < warmup; ++i) f();
+
+  const uint64_t overhead = timerOverheadTicks();
+  const double ns_per_tick = TscClock::nsPerTick();
+  LatencyReport report;
+  report.iterations = iterations;
+  report.timer_overhead_ns = static_cast<double>(overhead) * ns_per_tick;
+
+  for (size_t i = 0; i < iterations; ++i) {
+    const uint64_t t0 = TscClock::start();
+    f();
+    const uint64_t t1 = TscClock::stop();
+    const uint64_t ticks = t1 - t0 > overhead ? t1 - t0 - overhead : 0;
+    report.histogram.record(static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick + 0.5));
+  }
+
+  const LatencyHistogram& h = report.histogram;
+  report.min_ns = h.min();
+  report.p50_ns = h.percentile(50.0);
+  report.p90_ns = h.percentile(90.0);
+  report.p99_ns = h.percentile(99.0);
+  report.p999_ns = h.percentile(99.9);
+  report.max_ns = h.max();
+  report.mean_ns = h.mean();
+  return report;
+}
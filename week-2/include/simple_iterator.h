@@ -1,7 +1,11 @@
 #pragma once
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
 
 /**
- * TODO: Implement Custom Iterator
+ * Custom Iterator
  * 
  * Requirements:
  * - operator* - Dereference
@@ -10,23 +14,63 @@
  * - operator== and operator!= - Comparison
  * 
  * Iterator should work with raw pointers/arrays
+ *
+ * Conformance:
+ * - Models std::contiguous_iterator (iterator_concept) and advertises
+ *   random_access_iterator_tag (iterator_category) for pre-C++20 code
+ * - Full arithmetic (+=, -=, +, -, difference, []) and three-way
+ *   comparison, so std::distance is O(1), std::sort accepts it, and
+ *   std::copy takes the counted random-access loop, which GCC vectorizes;
+ *   libraries that unwrap contiguous iterators through std::to_address
+ *   (libc++, std::ranges with pointers) call memmove directly
+ * - SimpleIterator<T> converts to SimpleIterator<const T>
  */
 
 template <typename T>
 class SimpleIterator {
  public:
-  using value_type = T;
+  using iterator_concept = std::contiguous_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_cv_t<T>;
+  using element_type = T;
+  using difference_type = std::ptrdiff_t;
   using pointer = T*;
   using reference = T&;
-  
+
+  SimpleIterator() : ptr_(nullptr) {}
   explicit SimpleIterator(pointer ptr) : ptr_(ptr) {}
-  
+
+  template <typename U, std::enable_if_t<std::is_convertible_v<U*, T*>, int> = 0>
+  SimpleIterator(const SimpleIterator<U>& other) : ptr_(other.operator->()) {}  // NOLINT
+
   reference operator*() const { return *ptr_; }
-  pointer operator->() { return ptr_; }
+  pointer operator->() const { return ptr_; }
+  reference operator[](difference_type n) const { return ptr_[n]; }
+
   SimpleIterator& operator++() { ++ptr_; return *this; }
+  SimpleIterator operator++(int) { SimpleIterator tmp(*this); ++ptr_; return tmp; }
+  SimpleIterator& operator--() { --ptr_; return *this; }
+  SimpleIterator operator--(int) { SimpleIterator tmp(*this); --ptr_; return tmp; }
+
+  SimpleIterator& operator+=(difference_type n) { ptr_ += n; return *this; }
+  SimpleIterator& operator-=(difference_type n) { ptr_ -= n; return *this; }
+
+  friend SimpleIterator operator+(SimpleIterator it, difference_type n) { return it += n; }
+  friend SimpleIterator operator+(difference_type n, SimpleIterator it) { return it += n; }
+  friend SimpleIterator operator-(SimpleIterator it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const SimpleIterator& a, const SimpleIterator& b) {
+    return a.ptr_ - b.ptr_;
+  }
+
   bool operator==(const SimpleIterator& other) const { return ptr_ == other.ptr_; }
   bool operator!=(const SimpleIterator& other) const { return ptr_ != other.ptr_; }
-  
+  std::strong_ordering operator<=>(const SimpleIterator& other) const {
+    return ptr_ <=> other.ptr_;
+  }
+
  private:
   pointer ptr_;
 };
+
+static_assert(std::contiguous_iterator<SimpleIterator<int>>);
+static_assert(std::contiguous_iterator<SimpleIterator<const int>>);
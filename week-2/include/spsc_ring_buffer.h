@@ -0,0 +1,146 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * SpscRingBuffer<T> - bounded single-producer/single-consumer queue
+ *
+ * - Lock-free and wait-free: exactly one thread may push, exactly one
+ *   (other) thread may pop
+ * - Capacity is rounded up to a power of two so indices wrap with a mask
+ * - The consumer's head and the producer's tail live on separate cache lines
+ * - Each side keeps a cached copy of the opposite index and only reloads
+ *   the shared atomic when the cache says full/empty, so the common case
+ *   touches no cache line owned by the other thread
+ * - tryPushBatch()/tryPopBatch() publish many elements with a single
+ *   release store
+ *
+ * Indices are free-running counters; size = tail - head.
+ */
+
+template <typename T>
+class SpscRingBuffer {
+ public:
+  explicit SpscRingBuffer(size_t capacity)
+      : capacity_(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)),
+        mask_(capacity_ - 1),
+        slots_(static_cast<T*>(
+            ::operator new(capacity_ * sizeof(T), std::align_val_t{alignof(T)}))) {}
+
+  ~SpscRingBuffer() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      size_t head = consumer_.head.load(std::memory_order_relaxed);
+      const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+      for (; head != tail; ++head) slots_[head & mask_].~T();
+    }
+    ::operator delete(slots_, std::align_val_t{alignof(T)});
+  }
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  // Producer side. Returns false when the buffer is full.
+  template <typename... Args>
+  bool tryEmplace(Args&&... args) {
+    const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+    if (tail - producer_.cached_head == capacity_) {
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      if (tail - producer_.cached_head == capacity_) return false;
+    }
+    ::new (static_cast<void*>(&slots_[tail & mask_])) T(std::forward<Args>(args)...);
+    producer_.tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPush(const T& value) { return tryEmplace(value); }
+  bool tryPush(T&& value) { return tryEmplace(std::move(value)); }
+
+  // Producer side. Pushes up to count items, returns how many were pushed.
+  size_t tryPushBatch(const T* items, size_t count) {
+    const size_t tail = producer_.tail.load(std::memory_order_relaxed);
+    size_t free_slots = capacity_ - (tail - producer_.cached_head);
+    if (free_slots < count) {
+      producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+      free_slots = capacity_ - (tail - producer_.cached_head);
+    }
+    const size_t n = count < free_slots ? count : free_slots;
+    for (size_t i = 0; i < n; ++i) {
+      ::new (static_cast<void*>(&slots_[(tail + i) & mask_])) T(items[i]);
+    }
+    if (n > 0) producer_.tail.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  // Consumer side. Returns false when the buffer is empty.
+  bool tryPop(T& out) {
+    const size_t head = consumer_.head.load(std::memory_order_relaxed);
+    if (head == consumer_.cached_tail) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      if (head == consumer_.cached_tail) return false;
+    }
+    T& slot = slots_[head & mask_];
+    out = std::move(slot);
+    slot.~T();
+    consumer_.head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Pops up to max_count items into out, returns how many.
+  size_t tryPopBatch(T* out, size_t max_count) {
+    const size_t head = consumer_.head.load(std::memory_order_relaxed);
+    size_t available = consumer_.cached_tail - head;
+    if (available < max_count) {
+      consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+      available = consumer_.cached_tail - head;
+    }
+    const size_t n = max_count < available ? max_count : available;
+    for (size_t i = 0; i < n; ++i) {
+      T& slot = slots_[(head + i) & mask_];
+      out[i] = std::move(slot);
+      slot.~T();
+    }
+    if (n > 0) consumer_.head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  // Exact only when called from a quiescent state; otherwise a snapshot.
+  size_t size() const {
+    const size_t head = consumer_.head.load(std::memory_order_acquire);
+    const size_t tail = producer_.tail.load(std::memory_order_acquire);
+    return tail - head;
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return capacity_; }
+
+ private:
+  static constexpr size_t CACHE_LINE_SIZE = 64;
+
+  static size_t roundUpToPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+  }
+
+  // Written by the producer; the consumer only reads tail.
+  struct alignas(CACHE_LINE_SIZE) ProducerSide {
+    std::atomic<size_t> tail{0};
+    size_t cached_head = 0;
+  };
+
+  // Written by the consumer; the producer only reads head.
+  struct alignas(CACHE_LINE_SIZE) ConsumerSide {
+    std::atomic<size_t> head{0};
+    size_t cached_tail = 0;
+  };
+
+  const size_t capacity_;
+  const size_t mask_;
+  T* const slots_;
+
+  ProducerSide producer_;
+  ConsumerSide consumer_;
+};
@@ -1,33 +1,418 @@
 #pragma once
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
- * TODO: Implement STL Container Benchmarking
- * 
- * Requirements:
- * - benchmarkInsert<Container>(count) - Measure insertion time
- * - Test with std::vector, std::list, std::deque
- * - Return time in microseconds
- * 
- * Implementation:
- * - Use std::chrono for timing
- * - Template function to work with any container
- * - Push count elements and measure time
+ * STL Container Benchmark Suite
+ *
+ * - benchmarkInsert<Container>(count) - time one insert run, microseconds
+ * - run<Container>(name, op, size) - warmup + repeated timed runs of one
+ *   operation, summarized as min/median/mean/p99/max/stddev in nanoseconds
+ * - runAll<Container>(name, size) - every operation the container supports
+ * - writeCsv()/writeJson() - export all collected results
+ *
+ * Operations: insert, random access, iteration, erase-middle, find, sort.
+ * Support is detected from the container's interface, so std::vector,
+ * std::list, std::deque, std::map, std::unordered_map and the project's own
+ * containers (SmallVector, Stack, HashTable, ...) all work; unsupported
+ * operations are skipped. Container setup is never part of the timed region.
  */
 
+/**
+ * Optimization barriers (same technique as google benchmark): force value
+ * to be materialized, and force pending memory writes to be visible.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobberMemory() { asm volatile("" : : : "memory"); }
+
+enum class BenchmarkOp { INSERT, RANDOM_ACCESS, ITERATE, ERASE_MIDDLE, FIND, SORT };
+
+inline const char* benchmarkOpName(BenchmarkOp op) {
+  switch (op) {
+    case BenchmarkOp::INSERT: return "insert";
+    case BenchmarkOp::RANDOM_ACCESS: return "random_access";
+    case BenchmarkOp::ITERATE: return "iterate";
+    case BenchmarkOp::ERASE_MIDDLE: return "erase_middle";
+    case BenchmarkOp::FIND: return "find";
+    case BenchmarkOp::SORT: return "sort";
+  }
+  return "unknown";
+}
+
+struct BenchmarkStats {
+  std::string container;
+  std::string operation;
+  size_t size = 0;
+  size_t repetitions = 0;
+  double min_ns = 0;
+  double median_ns = 0;
+  double mean_ns = 0;
+  double p99_ns = 0;
+  double max_ns = 0;
+  double stddev_ns = 0;
+};
+
+// Summarize raw samples (nanoseconds). p99 uses the nearest-rank method.
+inline BenchmarkStats summarizeSamples(std::vector<double> samples) {
+  BenchmarkStats stats;
+  stats.repetitions = samples.size();
+  if (samples.empty()) return stats;
+  std::sort(samples.begin(), samples.end());
+  const size_t n = samples.size();
+  stats.min_ns = samples.front();
+  stats.max_ns = samples.back();
+  stats.median_ns = n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+  const auto p99_rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(n)));
+  stats.p99_ns = samples[p99_rank == 0 ? 0 : p99_rank - 1];
+  stats.mean_ns = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+  if (n > 1) {
+    double sq = 0;
+    for (double s : samples) sq += (s - stats.mean_ns) * (s - stats.mean_ns);
+    stats.stddev_ns = std::sqrt(sq / static_cast<double>(n - 1));
+  }
+  return stats;
+}
+
+namespace stl_benchmark_detail {
+
+template <typename C, typename = void>
+struct IsAssociative : std::false_type {};
+template <typename C>
+struct IsAssociative<C, std::void_t<typename C::key_type, typename C::mapped_type>>
+    : std::true_type {};
+
+template <typename C, typename = void>
+struct HasPushBack : std::false_type {};
+template <typename C>
+struct HasPushBack<C, std::void_t<decltype(std::declval<C&>().push_back(
+                          std::declval<typename C::value_type>()))>> : std::true_type {};
+
+template <typename C, typename = void>
+struct HasPush : std::false_type {};
+template <typename C>
+struct HasPush<C, std::void_t<decltype(std::declval<C&>().push(std::declval<int>()))>>
+    : std::true_type {};
+
+// HashTable-style interface: insert(key, value) / find(key, value&).
+template <typename C, typename = void>
+struct IsKeyValueTable : std::false_type {};
+template <typename C>
+struct IsKeyValueTable<C, std::void_t<decltype(std::declval<C&>().find(
+                              std::declval<const typename C::key_type&>(),
+                              std::declval<typename C::mapped_type&>()))>> : std::true_type {};
+
+template <typename C, typename = void>
+struct HasIterators : std::false_type {};
+template <typename C>
+struct HasIterators<C, std::void_t<decltype(std::declval<C&>().begin()),
+                                   decltype(std::declval<C&>().end())>> : std::true_type {};
+
+template <typename C, typename = void>
+struct HasSubscript : std::false_type {};
+template <typename C>
+struct HasSubscript<C, std::void_t<decltype(std::declval<C&>()[size_t{0}])>> : std::true_type {};
+
+template <typename C, typename = void>
+struct HasIteratorErase : std::false_type {};
+template <typename C>
+struct HasIteratorErase<C, std::void_t<decltype(std::declval<C&>().erase(
+                               std::declval<C&>().begin()))>> : std::true_type {};
+
+template <typename C, typename = void>
+struct HasMemberSort : std::false_type {};
+template <typename C>
+struct HasMemberSort<C, std::void_t<decltype(std::declval<C&>().sort())>> : std::true_type {};
+
+template <typename C, typename = void>
+struct HasRandomAccessIterators : std::false_type {};
+template <typename C>
+struct HasRandomAccessIterators<C, std::enable_if_t<HasIterators<C>::value>>
+    : std::is_base_of<std::random_access_iterator_tag,
+                      typename std::iterator_traits<decltype(
+                          std::declval<C&>().begin())>::iterator_category> {};
+
+template <typename T>
+T makeValue(size_t i) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return std::to_string(i);
+  } else {
+    return static_cast<T>(i);
+  }
+}
+
+}  // namespace stl_benchmark_detail
+
+/**
+ * How each operation is performed on Container. Specialize for containers
+ * whose interface is not detected automatically.
+ */
+template <typename Container>
+struct ContainerOps {
+  static constexpr bool KEY_VALUE_TABLE = stl_benchmark_detail::IsKeyValueTable<Container>::value;
+  static constexpr bool ASSOCIATIVE =
+      stl_benchmark_detail::IsAssociative<Container>::value && !KEY_VALUE_TABLE;
+  static constexpr bool SEQUENCE = stl_benchmark_detail::HasPushBack<Container>::value;
+  static constexpr bool STACK_LIKE = stl_benchmark_detail::HasPush<Container>::value;
+
+  static constexpr bool supports(BenchmarkOp op) {
+    using namespace stl_benchmark_detail;
+    switch (op) {
+      case BenchmarkOp::INSERT:
+        return ASSOCIATIVE || KEY_VALUE_TABLE || SEQUENCE || STACK_LIKE;
+      case BenchmarkOp::RANDOM_ACCESS:
+        return SEQUENCE && HasSubscript<Container>::value;
+      case BenchmarkOp::ITERATE:
+        return (ASSOCIATIVE || SEQUENCE) && HasIterators<Container>::value;
+      case BenchmarkOp::ERASE_MIDDLE:
+        return ASSOCIATIVE || (SEQUENCE && HasIteratorErase<Container>::value);
+      case BenchmarkOp::FIND:
+        return ASSOCIATIVE || KEY_VALUE_TABLE || (SEQUENCE && HasIterators<Container>::value);
+      case BenchmarkOp::SORT:
+        return SEQUENCE && (HasRandomAccessIterators<Container>::value ||
+                            HasMemberSort<Container>::value);
+    }
+    return false;
+  }
+
+  static void insert(Container& c, size_t i) {
+    using namespace stl_benchmark_detail;
+    if constexpr (ASSOCIATIVE || KEY_VALUE_TABLE) {
+      auto key = makeValue<typename Container::key_type>(i);
+      auto value = makeValue<typename Container::mapped_type>(i);
+      if constexpr (ASSOCIATIVE) {
+        c.emplace(std::move(key), std::move(value));
+      } else {
+        c.insert(key, value);
+      }
+    } else if constexpr (SEQUENCE) {
+      c.push_back(makeValue<typename Container::value_type>(i));
+    } else if constexpr (STACK_LIKE) {
+      c.push(static_cast<int>(i));
+    }
+  }
+
+  static Container filled(size_t size) {
+    Container c;
+    for (size_t i = 0; i < size; ++i) insert(c, i);
+    return c;
+  }
+};
+
 class STLBenchmark {
  public:
+  explicit STLBenchmark(size_t warmup_runs = 3, size_t repetitions = 30)
+      : warmup_runs_(warmup_runs), repetitions_(repetitions) {}
+
   template <typename Container>
   long long benchmarkInsert(size_t count);
+
+  template <typename Container>
+  BenchmarkStats run(const std::string& name, BenchmarkOp op, size_t size);
+
+  template <typename Container>
+  void runAll(const std::string& name, size_t size);
+
+  const std::vector<BenchmarkStats>& results() const { return results_; }
+  void clear() { results_.clear(); }
+
+  void toCsv(std::ostream& out) const;
+  void toJson(std::ostream& out) const;
+  bool writeCsv(const std::string& path) const;
+  bool writeJson(const std::string& path) const;
+
+ private:
+  // Time body(container) on a fresh container from setup(), once per run.
+  template <typename Setup, typename Body>
+  std::vector<double> sample(Setup setup, Body body) const;
+
+  template <typename Container>
+  static void timedOp(Container& c, BenchmarkOp op, size_t size, const std::vector<size_t>& order);
+
+  size_t warmup_runs_;
+  size_t repetitions_;
+  std::vector<BenchmarkStats> results_;
 };
 
 template <typename Container>
 long long STLBenchmark::benchmarkInsert(size_t count) {
-  // TODO: Measure time to insert count elements
   auto start = std::chrono::high_resolution_clock::now();
-  
-  // TODO: Create container and insert elements
-  
+  Container c;
+  for (size_t i = 0; i < count; ++i) ContainerOps<Container>::insert(c, i);
+  doNotOptimize(c);
+  clobberMemory();
   auto end = std::chrono::high_resolution_clock::now();
   return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 }
+
+template <typename Setup, typename Body>
+std::vector<double> STLBenchmark::sample(Setup setup, Body body) const {
+  for (size_t i = 0; i < warmup_runs_; ++i) {
+    auto c = setup();
+    body(c);
+  }
+  std::vector<double> samples;
+  samples.reserve(repetitions_);
+  for (size_t i = 0; i < repetitions_; ++i) {
+    auto c = setup();
+    clobberMemory();
+    const auto start = std::chrono::steady_clock::now();
+    body(c);
+    clobberMemory();
+    const auto end = std::chrono::steady_clock::now();
+    samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+  }
+  return samples;
+}
+
+template <typename Container>
+void STLBenchmark::timedOp(Container& c, BenchmarkOp op, size_t size,
+                           const std::vector<size_t>& order) {
+  using Ops = ContainerOps<Container>;
+  using namespace stl_benchmark_detail;
+  switch (op) {
+    case BenchmarkOp::INSERT:
+      for (size_t i = 0; i < size; ++i) Ops::insert(c, i);
+      doNotOptimize(c);
+      break;
+    case BenchmarkOp::RANDOM_ACCESS:
+      if constexpr (HasSubscript<Container>::value && Ops::SEQUENCE) {
+        for (size_t idx : order) doNotOptimize(c[idx]);
+      }
+      break;
+    case BenchmarkOp::ITERATE:
+      if constexpr (HasIterators<Container>::value) {
+        for (const auto& element : c) doNotOptimize(element);
+      }
+      break;
+    case BenchmarkOp::ERASE_MIDDLE:
+      // Erase a tenth of the elements, always from the middle.
+      if constexpr (Ops::ASSOCIATIVE) {
+        for (size_t i = 0; i < size / 10; ++i) {
+          c.erase(makeValue<typename Container::key_type>(size / 2 + i));
+        }
+      } else if constexpr (HasIteratorErase<Container>::value) {
+        for (size_t i = 0; i < size / 10; ++i) {
+          auto it = c.begin();
+          std::advance(it, static_cast<std::ptrdiff_t>(c.size() / 2));
+          c.erase(it);
+        }
+      }
+      doNotOptimize(c);
+      break;
+    case BenchmarkOp::FIND:
+      // Look up size / 10 keys spread over the container.
+      for (size_t i = 0; i < order.size() && i < size / 10 + 1; ++i) {
+        if constexpr (Ops::ASSOCIATIVE) {
+          doNotOptimize(c.find(makeValue<typename Container::key_type>(order[i])));
+        } else if constexpr (Ops::KEY_VALUE_TABLE) {
+          typename Container::mapped_type value{};
+          doNotOptimize(c.find(makeValue<typename Container::key_type>(order[i]), value));
+        } else if constexpr (HasIterators<Container>::value) {
+          doNotOptimize(std::find(c.begin(), c.end(),
+                                  makeValue<typename Container::value_type>(order[i])));
+        }
+      }
+      break;
+    case BenchmarkOp::SORT:
+      if constexpr (HasRandomAccessIterators<Container>::value && Ops::SEQUENCE) {
+        std::sort(c.begin(), c.end());
+      } else if constexpr (HasMemberSort<Container>::value) {
+        c.sort();
+      }
+      doNotOptimize(c);
+      break;
+  }
+}
+
+template <typename Container>
+BenchmarkStats STLBenchmark::run(const std::string& name, BenchmarkOp op, size_t size) {
+  using Ops = ContainerOps<Container>;
+  std::vector<size_t> order(size);
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::shuffle(order.begin(), order.end(), std::mt19937_64{42});
+
+  std::vector<double> samples;
+  if (op == BenchmarkOp::INSERT) {
+    samples = sample([] { return Container{}; },
+                     [&](Container& c) { timedOp(c, op, size, order); });
+  } else if (op == BenchmarkOp::SORT) {
+    // Sorting needs unsorted input: fill in shuffled order.
+    samples = sample(
+        [&] {
+          Container c;
+          for (size_t idx : order) Ops::insert(c, idx);
+          return c;
+        },
+        [&](Container& c) { timedOp(c, op, size, order); });
+  } else {
+    samples = sample([&] { return Ops::filled(size); },
+                     [&](Container& c) { timedOp(c, op, size, order); });
+  }
+
+  BenchmarkStats stats = summarizeSamples(std::move(samples));
+  stats.container = name;
+  stats.operation = benchmarkOpName(op);
+  stats.size = size;
+  results_.push_back(stats);
+  return stats;
+}
+
+template <typename Container>
+void STLBenchmark::runAll(const std::string& name, size_t size) {
+  for (auto op : {BenchmarkOp::INSERT, BenchmarkOp::RANDOM_ACCESS, BenchmarkOp::ITERATE,
+                  BenchmarkOp::ERASE_MIDDLE, BenchmarkOp::FIND, BenchmarkOp::SORT}) {
+    if (ContainerOps<Container>::supports(op)) run<Container>(name, op, size);
+  }
+}
+
+inline void STLBenchmark::toCsv(std::ostream& out) const {
+  out << "container,operation,size,repetitions,min_ns,median_ns,mean_ns,p99_ns,max_ns,stddev_ns\n";
+  for (const auto& r : results_) {
+    out << r.container << ',' << r.operation << ',' << r.size << ',' << r.repetitions << ','
+        << r.min_ns << ',' << r.median_ns << ',' << r.mean_ns << ',' << r.p99_ns << ','
+        << r.max_ns << ',' << r.stddev_ns << '\n';
+  }
+}
+
+inline void STLBenchmark::toJson(std::ostream& out) const {
+  out << "{\n  \"results\": [";
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const auto& r = results_[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"container\": \"" << r.container
+        << "\", \"operation\": \"" << r.operation << "\", \"size\": " << r.size
+        << ", \"repetitions\": " << r.repetitions << ", \"min_ns\": " << r.min_ns
+        << ", \"median_ns\": " << r.median_ns << ", \"mean_ns\": " << r.mean_ns
+        << ", \"p99_ns\": " << r.p99_ns << ", \"max_ns\": " << r.max_ns
+        << ", \"stddev_ns\": " << r.stddev_ns << "}";
+  }
+  out << "\n  ]\n}\n";
+}
+
+inline bool STLBenchmark::writeCsv(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out) return false;
+  toCsv(out);
+  return static_cast<bool>(out);
+}
+
+inline bool STLBenchmark::writeJson(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out) return false;
+  toJson(out);
+  return static_cast<bool>(out);
+}
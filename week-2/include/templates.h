@@ -1,5 +1,8 @@
 #pragma once
+#include <algorithm>
 #include <cstddef>
+#include <type_traits>
+#include <utility>
 
 /**
  * TODO: Implement Template Functions and Classes
@@ -23,12 +26,222 @@ void swap(T& a, T& b) {
   // TODO: Swap values of a and b
 }
 
+/**
+ * Array<T, N> - fixed-size array tuned for small N (price ladders etc.)
+ *
+ * - Fully constexpr: construction, access, arithmetic, reductions, sort
+ * - Storage aligned to the SIMD width covering the whole array (16/32/64
+ *   bytes), so an 8 x double ladder loads with aligned AVX-512 moves
+ * - Contiguous iterators (plain pointers) for STL algorithms
+ * - Element-wise +, -, *, / (array or scalar operand) expand at compile
+ *   time into straight-line code, one expression per element
+ * - sum/product/minElement/maxElement reduce as a balanced tree, which
+ *   exposes instruction-level parallelism (floating point sums therefore
+ *   associate pairwise, not left to right)
+ * - sort() uses a Batcher odd-even merge sorting network for
+ *   N <= SORTING_NETWORK_MAX_N (branch-free compare-exchange), std::sort
+ *   above that
+ */
+
+inline constexpr size_t SORTING_NETWORK_MAX_N = 32;
+inline constexpr size_t MAX_SIMD_ALIGNMENT = 64;
+
+namespace array_detail {
+
+constexpr size_t bitCeil(size_t n) {
+  size_t p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+template <typename T, size_t N>
+constexpr size_t simdAlignment() {
+  const size_t bytes = bitCeil(sizeof(T) * N);
+  const size_t capped = bytes < MAX_SIMD_ALIGNMENT ? bytes : MAX_SIMD_ALIGNMENT;
+  return capped < alignof(T) ? alignof(T) : capped;
+}
+
+// Batcher odd-even merge sort over bitCeil(N) inputs, dropping comparators
+// that touch padding slots (>= N); padding acts as +infinity so the result
+// is still a valid network for N inputs.
+template <typename Visit>
+constexpr void forEachComparator(size_t n, Visit visit) {
+  const size_t padded = bitCeil(n);
+  for (size_t p = 1; p < padded; p <<= 1) {
+    for (size_t k = p; k >= 1; k >>= 1) {
+      for (size_t j = k % p; j + k < padded; j += 2 * k) {
+        for (size_t i = 0; i < k && i + j + k < padded; ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p) && i + j + k < n) visit(i + j, i + j + k);
+        }
+      }
+    }
+  }
+}
+
+template <size_t N>
+constexpr size_t comparatorCount() {
+  size_t count = 0;
+  forEachComparator(N, [&count](size_t, size_t) { ++count; });
+  return count;
+}
+
+struct Comparator {
+  size_t lo;
+  size_t hi;
+};
+
+template <size_t N>
+struct SortingNetwork {
+  static constexpr size_t SIZE = comparatorCount<N>();
+  Comparator pairs[SIZE == 0 ? 1 : SIZE] = {};
+
+  constexpr SortingNetwork() {
+    size_t idx = 0;
+    forEachComparator(N, [this, &idx](size_t lo, size_t hi) {
+      pairs[idx].lo = lo;
+      pairs[idx].hi = hi;
+      ++idx;
+    });
+  }
+};
+
+}  // namespace array_detail
+
 template <typename T, size_t N>
 class Array {
+  static_assert(N > 0, "Array needs at least one element");
+
  public:
-  T& operator[](size_t i) { return data_[i]; }
-  const T& operator[](size_t i) const { return data_[i]; }
-  size_t size() const { return N; }
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  static constexpr size_t ALIGNMENT = array_detail::simdAlignment<T, N>();
+
+  constexpr Array() : data_{} {}
+
+  template <typename... U,
+            std::enable_if_t<sizeof...(U) == N &&
+                                 std::conjunction_v<std::is_convertible<U, T>...>,
+                             int> = 0>
+  constexpr Array(U... values) : data_{static_cast<T>(values)...} {}  // NOLINT
+
+  static constexpr Array filled(T value) {
+    Array a;
+    for (size_t i = 0; i < N; ++i) a.data_[i] = value;
+    return a;
+  }
+
+  constexpr T& operator[](size_t i) { return data_[i]; }
+  constexpr const T& operator[](size_t i) const { return data_[i]; }
+  static constexpr size_t size() { return N; }
+
+  constexpr T* data() { return data_; }
+  constexpr const T* data() const { return data_; }
+  constexpr iterator begin() { return data_; }
+  constexpr iterator end() { return data_ + N; }
+  constexpr const_iterator begin() const { return data_; }
+  constexpr const_iterator end() const { return data_ + N; }
+  constexpr T& front() { return data_[0]; }
+  constexpr T& back() { return data_[N - 1]; }
+
+  // Element-wise application of f, unrolled at compile time.
+  template <typename F>
+  constexpr Array map(const Array& other, F f) const {
+    return mapImpl(other, f, std::make_index_sequence<N>{});
+  }
+
+  template <typename F>
+  constexpr T reduce(F f) const {
+    return reduceRange<0, N>(f);
+  }
+
+  constexpr T sum() const {
+    return reduce([](T a, T b) { return a + b; });
+  }
+  constexpr T product() const {
+    return reduce([](T a, T b) { return a * b; });
+  }
+  constexpr T minElement() const {
+    return reduce([](T a, T b) { return b < a ? b : a; });
+  }
+  constexpr T maxElement() const {
+    return reduce([](T a, T b) { return a < b ? b : a; });
+  }
+
+  constexpr void sort() {
+    if constexpr (N <= SORTING_NETWORK_MAX_N) {
+      sortNetwork(std::make_index_sequence<NETWORK.SIZE>{});
+    } else {
+      std::sort(begin(), end());
+    }
+  }
+
+  constexpr Array& operator+=(const Array& o) { return *this = *this + o; }
+  constexpr Array& operator-=(const Array& o) { return *this = *this - o; }
+  constexpr Array& operator*=(const Array& o) { return *this = *this * o; }
+  constexpr Array& operator/=(const Array& o) { return *this = *this / o; }
+
+  friend constexpr Array operator+(const Array& a, const Array& b) {
+    return a.map(b, [](T x, T y) { return x + y; });
+  }
+  friend constexpr Array operator-(const Array& a, const Array& b) {
+    return a.map(b, [](T x, T y) { return x - y; });
+  }
+  friend constexpr Array operator*(const Array& a, const Array& b) {
+    return a.map(b, [](T x, T y) { return x * y; });
+  }
+  friend constexpr Array operator/(const Array& a, const Array& b) {
+    return a.map(b, [](T x, T y) { return x / y; });
+  }
+  friend constexpr Array operator+(const Array& a, T s) { return a + filled(s); }
+  friend constexpr Array operator-(const Array& a, T s) { return a - filled(s); }
+  friend constexpr Array operator*(const Array& a, T s) { return a * filled(s); }
+  friend constexpr Array operator/(const Array& a, T s) { return a / filled(s); }
+  friend constexpr Array operator*(T s, const Array& a) { return filled(s) * a; }
+
+  friend constexpr bool operator==(const Array& a, const Array& b) {
+    for (size_t i = 0; i < N; ++i) {
+      if (!(a.data_[i] == b.data_[i])) return false;
+    }
+    return true;
+  }
+  friend constexpr bool operator!=(const Array& a, const Array& b) { return !(a == b); }
+
  private:
-  T data_[N];
+  template <typename F, size_t... I>
+  constexpr Array mapImpl(const Array& other, F f, std::index_sequence<I...>) const {
+    return Array(f(data_[I], other.data_[I])...);
+  }
+
+  template <size_t Lo, size_t Hi, typename F>
+  constexpr T reduceRange(F f) const {
+    if constexpr (Hi - Lo == 1) {
+      return data_[Lo];
+    } else {
+      constexpr size_t MID = Lo + (Hi - Lo) / 2;
+      return f(reduceRange<Lo, MID>(f), reduceRange<MID, Hi>(f));
+    }
+  }
+
+  static constexpr void compareExchange(T& a, T& b) {
+    const T lo = b < a ? b : a;
+    const T hi = b < a ? a : b;
+    a = lo;
+    b = hi;
+  }
+
+  template <size_t... I>
+  constexpr void sortNetwork(std::index_sequence<I...>) {
+    (compareExchange(data_[NETWORK.pairs[I].lo], data_[NETWORK.pairs[I].hi]), ...);
+  }
+
+  static constexpr array_detail::SortingNetwork<N <= SORTING_NETWORK_MAX_N ? N : 1> NETWORK{};
+
+  alignas(ALIGNMENT) T data_[N];
 };
+
+template <typename T, size_t N>
+constexpr T dot(const Array<T, N>& a, const Array<T, N>& b) {
+  return (a * b).sum();
+}
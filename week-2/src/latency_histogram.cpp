@@ -0,0 +1,77 @@
+#include "latency_histogram.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr unsigned SUB_BITS = LatencyHistogram::SUB_BUCKET_BITS;
+constexpr uint64_t SUB_COUNT = uint64_t{1} << SUB_BITS;      // Exact range [0, SUB_COUNT).
+constexpr uint64_t HALF_COUNT = SUB_COUNT >> 1;               // Sub-buckets per octave.
+constexpr size_t BUCKET_COUNT = SUB_COUNT + (64 - SUB_BITS) * HALF_COUNT;
+
+unsigned highestBit(uint64_t value) { return 63u - static_cast<unsigned>(__builtin_clzll(value)); }
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(BUCKET_COUNT, 0),
+      count_(0),
+      min_(std::numeric_limits<uint64_t>::max()),
+      max_(0),
+      sum_(0) {}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+  if (value < SUB_COUNT) return static_cast<size_t>(value);
+  // value in [2^k, 2^(k+1)), k >= SUB_BITS: keep the top SUB_BITS bits.
+  const unsigned shift = highestBit(value) - SUB_BITS + 1;
+  const uint64_t sub = (value >> shift) - HALF_COUNT;
+  return static_cast<size_t>(SUB_COUNT + (shift - 1) * HALF_COUNT + sub);
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(size_t index) {
+  if (index < SUB_COUNT) return index;
+  const uint64_t shift = (index - SUB_COUNT) / HALF_COUNT + 1;
+  const uint64_t sub = (index - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+  const uint64_t lowest = sub << shift;
+  return lowest + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t value) {
+  ++counts_[bucketIndex(value)];
+  ++count_;
+  sum_ += value;
+  if (value < min_) min_ = value;
+  if (value > max_) max_ = value;
+}
+
+void LatencyHistogram::reset() {
+  counts_.assign(BUCKET_COUNT, 0);
+  count_ = 0;
+  min_ = std::numeric_limits<uint64_t>::max();
+  max_ = 0;
+  sum_ = 0;
+}
+
+double LatencyHistogram::mean() const {
+  return count_ == 0 ? 0.0 : static_cast<double>(sum_ / static_cast<long double>(count_));
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+  if (count_ == 0) return 0;
+  if (p >= 100.0) return max_;
+  // The epsilon keeps e.g. 99.9% of 1000 at rank 999 despite rounding.
+  auto rank = static_cast<uint64_t>(std::ceil(p / 100.0 * static_cast<double>(count_) - 1e-9));
+  if (rank == 0) rank = 1;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      const uint64_t value = highestEquivalentValue(i);
+      // Never report past the exact extremes.
+      if (value > max_) return max_;
+      return value < min_ ? min_ : value;
+    }
+  }
+  return max_;
+}
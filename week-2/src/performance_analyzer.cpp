@@ -0,0 +1,217 @@
+#include "performance_analyzer.h"
+
+#ifdef PERFORMANCE_ANALYZER_HAS_TSC
+#include <cpuid.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <ostream>
+
+const char* hardwareEventName(HardwareEvent e) {
+  switch (e) {
+    case HardwareEvent::CYCLES: return "cycles";
+    case HardwareEvent::INSTRUCTIONS: return "instructions";
+    case HardwareEvent::CACHE_MISSES: return "cache-misses";
+    case HardwareEvent::BRANCH_MISSES: return "branch-misses";
+    case HardwareEvent::DTLB_MISSES: return "dTLB-misses";
+  }
+  return "unknown";
+}
+
+bool HardwareCounters::anyAvailable() const {
+  for (bool v : valid) {
+    if (v) return true;
+  }
+  return false;
+}
+
+double PerfMeasurement::ipc() const {
+  if (!counters.has(HardwareEvent::CYCLES) || !counters.has(HardwareEvent::INSTRUCTIONS)) {
+    return 0.0;
+  }
+  const uint64_t cycles = counters.get(HardwareEvent::CYCLES);
+  if (cycles == 0) return 0.0;
+  return static_cast<double>(counters.get(HardwareEvent::INSTRUCTIONS)) /
+         static_cast<double>(cycles);
+}
+
+double PerfMeasurement::perOperation(HardwareEvent e) const {
+  if (!counters.has(e)) return -1.0;
+  return static_cast<double>(counters.get(e)) / static_cast<double>(operations);
+}
+
+void PerfMeasurement::report(std::ostream& out) const {
+  out << "wall=" << wall_us << "us ops=" << operations << " IPC=";
+  if (ipc() > 0.0) {
+    out << ipc();
+  } else {
+    out << "n/a";
+  }
+  for (size_t i = 0; i < HARDWARE_EVENT_COUNT; ++i) {
+    const auto e = static_cast<HardwareEvent>(i);
+    out << ' ' << hardwareEventName(e) << "/op=";
+    if (counters.has(e)) {
+      out << perOperation(e);
+    } else {
+      out << "n/a";
+    }
+  }
+  out << '\n';
+}
+
+#ifdef __linux__
+
+namespace {
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+// Indexed by HardwareEvent.
+constexpr EventConfig EVENT_CONFIGS[HARDWARE_EVENT_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+int openCounter(const EventConfig& event) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // Current thread, any CPU, no group.
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}  // namespace
+
+PerfCounterSet::PerfCounterSet() {
+  for (size_t i = 0; i < HARDWARE_EVENT_COUNT; ++i) fds_[i] = openCounter(EVENT_CONFIGS[i]);
+}
+
+PerfCounterSet::~PerfCounterSet() {
+  for (int fd : fds_) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+bool PerfCounterSet::available() const {
+  for (int fd : fds_) {
+    if (fd >= 0) return true;
+  }
+  return false;
+}
+
+void PerfCounterSet::start() {
+  for (int fd : fds_) {
+    if (fd < 0) continue;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+HardwareCounters PerfCounterSet::stop() {
+  for (int fd : fds_) {
+    if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+  }
+  HardwareCounters result;
+  for (size_t i = 0; i < HARDWARE_EVENT_COUNT; ++i) {
+    if (fds_[i] < 0) continue;
+    uint64_t data[3] = {};  // value, time_enabled, time_running
+    if (read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+    if (data[2] == 0) continue;  // Never scheduled onto the PMU.
+    // Scale up if the kernel multiplexed this counter.
+    result.values[i] = data[2] < data[1] ? static_cast<uint64_t>(static_cast<double>(data[0]) *
+                                                                 static_cast<double>(data[1]) /
+                                                                 static_cast<double>(data[2]))
+                                         : data[0];
+    result.valid[i] = true;
+  }
+  return result;
+}
+
+#else  // !__linux__
+
+PerfCounterSet::PerfCounterSet() {
+  for (int& fd : fds_) fd = -1;
+}
+PerfCounterSet::~PerfCounterSet() = default;
+bool PerfCounterSet::available() const { return false; }
+void PerfCounterSet::start() {}
+HardwareCounters PerfCounterSet::stop() { return {}; }
+
+#endif
+
+bool PerformanceAnalyzer::countersAvailable() {
+  PerfCounterSet probe;
+  return probe.available();
+}
+
+namespace {
+
+bool detectInvariantTsc() {
+#ifdef PERFORMANCE_ANALYZER_HAS_TSC
+  unsigned eax, ebx, ecx, edx;
+  // RDTSCP: CPUID 0x80000001 EDX bit 27. Invariant TSC: 0x80000007 EDX bit 8.
+  if (!__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 27))) return false;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+double calibrateNsPerTick() {
+  if (!TscClock::usesTsc()) return 1.0;
+  using Clock = std::chrono::steady_clock;
+  const auto wall_start = Clock::now();
+  const uint64_t tsc_start = TscClock::start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  const uint64_t tsc_end = TscClock::stop();
+  const auto wall_end = Clock::now();
+  const double ns = std::chrono::duration<double, std::nano>(wall_end - wall_start).count();
+  return tsc_end > tsc_start ? ns / static_cast<double>(tsc_end - tsc_start) : 1.0;
+}
+
+}  // namespace
+
+bool TscClock::usesTsc() {
+  static const bool invariant = detectInvariantTsc();
+  return invariant;
+}
+
+double TscClock::nsPerTick() {
+  static const double ns_per_tick = calibrateNsPerTick();
+  return ns_per_tick;
+}
+
+uint64_t PerformanceAnalyzer::timerOverheadTicks() {
+  static const uint64_t overhead = [] {
+    uint64_t best = ~uint64_t{0};
+    for (int i = 0; i < 1000; ++i) {
+      const uint64_t t0 = TscClock::start();
+      const uint64_t t1 = TscClock::stop();
+      best = std::min(best, t1 - t0);
+    }
+    return best;
+  }();
+  return overhead;
+}
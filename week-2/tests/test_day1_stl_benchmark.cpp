@@ -3,6 +3,10 @@
 #include <vector>
 #include <list>
 #include <deque>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include "containers.h"
 
 TEST(Day1STLBenchmarkTest, VectorInsert) {
   STLBenchmark bench;
@@ -22,6 +26,55 @@ TEST(Day1STLBenchmarkTest, DequeInsert) {
   EXPECT_GT(time, 0);
 }
 
+TEST(Day1STLBenchmarkTest, SummaryStatistics) {
+  std::vector<double> samples;
+  for (int i = 1; i <= 100; ++i) samples.push_back(i);
+  BenchmarkStats stats = summarizeSamples(samples);
+  EXPECT_EQ(stats.repetitions, 100);
+  EXPECT_DOUBLE_EQ(stats.min_ns, 1);
+  EXPECT_DOUBLE_EQ(stats.max_ns, 100);
+  EXPECT_DOUBLE_EQ(stats.median_ns, 50.5);
+  EXPECT_DOUBLE_EQ(stats.mean_ns, 50.5);
+  EXPECT_DOUBLE_EQ(stats.p99_ns, 99);
+  EXPECT_NEAR(stats.stddev_ns, 29.011, 1e-3);
+}
+
+TEST(Day1STLBenchmarkTest, SupportedOperationsAreDetected) {
+  EXPECT_TRUE(ContainerOps<std::vector<int>>::supports(BenchmarkOp::RANDOM_ACCESS));
+  EXPECT_FALSE(ContainerOps<std::list<int>>::supports(BenchmarkOp::RANDOM_ACCESS));
+  EXPECT_TRUE(ContainerOps<std::list<int>>::supports(BenchmarkOp::SORT));
+  EXPECT_FALSE((ContainerOps<std::map<int, int>>::supports(BenchmarkOp::SORT)));
+  EXPECT_TRUE((ContainerOps<std::unordered_map<int, int>>::supports(BenchmarkOp::ERASE_MIDDLE)));
+  EXPECT_TRUE(ContainerOps<Stack<int>>::supports(BenchmarkOp::INSERT));
+  EXPECT_FALSE(ContainerOps<Stack<int>>::supports(BenchmarkOp::ITERATE));
+  EXPECT_TRUE((ContainerOps<SmallVector<int, 8>>::supports(BenchmarkOp::SORT)));
+}
+
+TEST(Day1STLBenchmarkTest, RunAllCollectsEverySupportedOperation) {
+  STLBenchmark bench(1, 5);
+  bench.runAll<std::vector<int>>("vector", 200);
+  bench.runAll<std::map<int, int>>("map", 200);
+  // vector: all six operations; map: insert, iterate, erase_middle, find.
+  ASSERT_EQ(bench.results().size(), 10);
+  for (const auto& r : bench.results()) {
+    EXPECT_EQ(r.repetitions, 5);
+    EXPECT_LE(r.min_ns, r.median_ns);
+    EXPECT_LE(r.median_ns, r.max_ns);
+  }
+}
+
+TEST(Day1STLBenchmarkTest, ExportsCsvAndJson) {
+  STLBenchmark bench(0, 3);
+  bench.run<std::deque<int>>("deque", BenchmarkOp::ITERATE, 100);
+  std::ostringstream csv, json;
+  bench.toCsv(csv);
+  bench.toJson(json);
+  EXPECT_EQ(csv.str().rfind("container,operation,size,", 0), 0);
+  EXPECT_NE(csv.str().find("\ndeque,iterate,100,3,"), std::string::npos);
+  EXPECT_NE(json.str().find("\"container\": \"deque\""), std::string::npos);
+  EXPECT_NE(json.str().find("\"p99_ns\""), std::string::npos);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
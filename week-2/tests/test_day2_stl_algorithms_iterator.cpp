@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <algorithm>
+#include <iterator>
+#include <ranges>
 
 TEST(Day2STLAlgorithmsTest, FindAlgorithm) {
   std::vector<int> vec = {1, 2, 3, 4, 5};
@@ -25,6 +27,40 @@ TEST(Day2IteratorTest, CustomIterator) {
   EXPECT_EQ(*it, 2);
 }
 
+TEST(Day2IteratorTest, ContiguousIteratorConformance) {
+  static_assert(std::contiguous_iterator<SimpleIterator<int>>);
+  static_assert(std::random_access_iterator<SimpleIterator<const double>>);
+  static_assert(std::is_same_v<std::iterator_traits<SimpleIterator<int>>::iterator_category,
+                               std::random_access_iterator_tag>);
+  int arr[] = {10, 20, 30, 40};
+  SimpleIterator<int> first(arr), last(arr + 4);
+  EXPECT_EQ(std::to_address(first), arr);
+  EXPECT_EQ(std::distance(first, last), 4);
+  EXPECT_EQ(first[2], 30);
+  EXPECT_EQ(*(first + 3), 40);
+  EXPECT_EQ(*(last - 1), 40);
+  EXPECT_TRUE(first < last);
+  EXPECT_TRUE(last >= first + 4);
+  SimpleIterator<const int> cfirst = first;
+  EXPECT_EQ(*cfirst, 10);
+}
+
+TEST(Day2IteratorTest, WorksWithStandardAlgorithms) {
+  int arr[] = {5, 2, 8, 1, 9};
+  SimpleIterator<int> first(arr), last(arr + 5);
+  std::sort(first, last);
+  EXPECT_TRUE(std::is_sorted(arr, arr + 5));
+  EXPECT_TRUE(std::binary_search(first, last, 8));
+
+  int out[5] = {};
+  std::copy(SimpleIterator<const int>(arr), SimpleIterator<const int>(arr + 5), out);
+  EXPECT_EQ(out[4], 9);
+
+  std::ranges::subrange range(first, last);
+  EXPECT_EQ(std::ranges::size(range), 5);
+  EXPECT_EQ(std::ranges::data(range), arr);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
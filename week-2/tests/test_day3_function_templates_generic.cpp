@@ -1,5 +1,9 @@
 #include "templates.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
 
 TEST(Day3FunctionTemplatesTest, MaxFunction) {
   EXPECT_EQ(max(3, 5), 5);
@@ -20,6 +24,73 @@ TEST(Day3GenericLibraryTest, ArrayContainer) {
   EXPECT_EQ(arr.size(), 5);
 }
 
+TEST(Day3GenericLibraryTest, ArrayIsConstexpr) {
+  constexpr Array<int, 4> a{4, 1, 3, 2};
+  constexpr Array<int, 4> b = a * 2 + 1;
+  static_assert(b[0] == 9 && b[3] == 5);
+  static_assert(a.sum() == 10);
+  static_assert(a.product() == 24);
+  static_assert(a.minElement() == 1 && a.maxElement() == 4);
+  static_assert(dot(a, a) == 30);
+  constexpr Array<int, 4> sorted = [] {
+    Array<int, 4> s{4, 1, 3, 2};
+    s.sort();
+    return s;
+  }();
+  static_assert(sorted == Array<int, 4>{1, 2, 3, 4});
+  EXPECT_EQ(b[1], 3);
+}
+
+TEST(Day3GenericLibraryTest, ArraySimdAlignment) {
+  EXPECT_EQ((Array<float, 4>::ALIGNMENT), 16);
+  EXPECT_EQ((Array<double, 4>::ALIGNMENT), 32);
+  EXPECT_EQ((Array<double, 16>::ALIGNMENT), 64);
+  EXPECT_EQ(alignof(Array<double, 8>), 64);
+  Array<double, 8> ladder;
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ladder.data()) % 64, 0);
+}
+
+TEST(Day3GenericLibraryTest, ArrayIteratorsWorkWithAlgorithms) {
+  Array<int, 5> arr{5, 3, 1, 4, 2};
+  EXPECT_EQ(*std::max_element(arr.begin(), arr.end()), 5);
+  std::reverse(arr.begin(), arr.end());
+  EXPECT_EQ(arr.front(), 2);
+  EXPECT_EQ(arr.back(), 5);
+}
+
+TEST(Day3GenericLibraryTest, ArrayElementWiseOps) {
+  Array<double, 3> a{1.0, 2.0, 3.0};
+  Array<double, 3> b{0.5, 0.5, 0.5};
+  a += b;
+  EXPECT_DOUBLE_EQ(a[2], 3.5);
+  Array<double, 3> c = a / b - 1.0;
+  EXPECT_DOUBLE_EQ(c[0], 2.0);
+  EXPECT_DOUBLE_EQ(c[2], 6.0);
+}
+
+template <size_t N>
+void checkSortingNetwork(std::mt19937& rng) {
+  std::uniform_int_distribution<int> dist(-50, 50);
+  for (int trial = 0; trial < 200; ++trial) {
+    Array<int, N> arr;
+    std::vector<int> expected(N);
+    for (size_t i = 0; i < N; ++i) expected[i] = arr[i] = dist(rng);
+    arr.sort();
+    std::sort(expected.begin(), expected.end());
+    ASSERT_TRUE(std::equal(arr.begin(), arr.end(), expected.begin())) << "N=" << N;
+  }
+}
+
+template <size_t... Ns>
+void checkSortingNetworks(std::index_sequence<Ns...>) {
+  std::mt19937 rng(7);
+  (checkSortingNetwork<Ns + 1>(rng), ...);
+}
+
+TEST(Day3GenericLibraryTest, ArraySortingNetworksSortEverySize) {
+  checkSortingNetworks(std::make_index_sequence<SORTING_NETWORK_MAX_N + 2>{});
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,5 +1,11 @@
 #include "containers.h"
+#include "spsc_ring_buffer.h"
 #include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST(Day4ClassTemplatesTest, VectorTemplate) {
   Vector<int> vec(5);
@@ -16,8 +22,259 @@ TEST(Day4ClassTemplatesTest, StackTemplate) {
   EXPECT_EQ(stack.size(), 2);
 }
 
+TEST(Day4SmallVectorTest, StaysInlineUpToCapacity) {
+  SmallVector<int, 4> vec;
+  for (int i = 0; i < 4; ++i) vec.push_back(i);
+  EXPECT_TRUE(vec.isInline());
+  EXPECT_EQ(vec.size(), 4);
+  EXPECT_EQ(vec[3], 3);
+}
+
+TEST(Day4SmallVectorTest, SpillsToHeap) {
+  SmallVector<std::string, 2> vec;
+  vec.push_back("a");
+  vec.push_back("b");
+  vec.push_back("c");
+  EXPECT_FALSE(vec.isInline());
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec[0], "a");
+  EXPECT_EQ(vec.back(), "c");
+}
+
+TEST(Day4SmallVectorTest, PushBackOwnElementWhileGrowing) {
+  SmallVector<std::string, 1> vec;
+  vec.push_back("self");
+  vec.push_back(vec[0]);
+  EXPECT_EQ(vec[1], "self");
+}
+
+TEST(Day4SmallVectorTest, MoveStealsHeapBuffer) {
+  SmallVector<int, 2> src{1, 2, 3};
+  const int* heap = src.data();
+  SmallVector<int, 2> dst(std::move(src));
+  EXPECT_EQ(dst.data(), heap);
+  EXPECT_EQ(dst.size(), 3);
+  EXPECT_TRUE(src.empty());
+  EXPECT_TRUE(src.isInline());
+}
+
+TEST(Day4SmallVectorTest, MoveRelocatesInlineElements) {
+  SmallVector<std::unique_ptr<int>, 4> src;
+  src.push_back(std::make_unique<int>(7));
+  SmallVector<std::unique_ptr<int>, 4> dst;
+  dst = std::move(src);
+  ASSERT_EQ(dst.size(), 1);
+  EXPECT_EQ(*dst[0], 7);
+  EXPECT_TRUE(src.empty());
+}
+
+TEST(Day4SmallVectorTest, CopyIsDeep) {
+  SmallVector<std::string, 2> src{"x", "y", "z"};
+  SmallVector<std::string, 2> copy(src);
+  copy[0] = "changed";
+  EXPECT_EQ(src[0], "x");
+  EXPECT_EQ(copy.size(), 3);
+}
+
+TEST(Day4SmallVectorTest, CopyAssignBetweenHeapBuffers) {
+  SmallVector<std::string, 2> src{"a", "b", "c", "d"};
+  SmallVector<std::string, 2> dst{"w", "x", "y", "z", "extra"};
+  ASSERT_FALSE(src.isInline());
+  ASSERT_FALSE(dst.isInline());
+  dst = src;  // dst's old heap buffer must be freed (LSan)
+  ASSERT_EQ(dst.size(), 4);
+  EXPECT_EQ(dst[0], "a");
+  EXPECT_EQ(dst.back(), "d");
+  EXPECT_NE(dst.data(), src.data());
+
+  SmallVector<std::string, 2> small{"only"};
+  dst = small;  // Heap to inline
+  ASSERT_EQ(dst.size(), 1);
+  EXPECT_TRUE(dst.isInline());
+  EXPECT_EQ(dst[0], "only");
+}
+
+namespace {
+
+// Copies throw once the shared budget runs out; the move constructor is not
+// noexcept, so containers relocate it by copying.
+struct ThrowingCopy {
+  static inline int copiesLeft = 0;
+  std::string value;
+
+  explicit ThrowingCopy(std::string v) : value(std::move(v)) {}
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copiesLeft-- <= 0) throw std::runtime_error("copy budget exhausted");
+  }
+  ThrowingCopy(ThrowingCopy&& other) : value(std::move(other.value)) {}  // NOLINT
+};
+
+}  // namespace
+
+static_assert(std::is_nothrow_move_constructible_v<SmallVector<std::string, 2>>);
+static_assert(!std::is_nothrow_move_constructible_v<SmallVector<ThrowingCopy, 2>>);
+static_assert(!std::is_nothrow_move_constructible_v<StaticStack<ThrowingCopy, 2>>);
+
+TEST(Day4SmallVectorTest, GrowKeepsElementsWhenRelocationThrows) {
+  SmallVector<ThrowingCopy, 2> vec;
+  vec.emplace_back("first");
+  vec.emplace_back("second");
+  ThrowingCopy::copiesLeft = 1;  // Second element of the relocation throws
+  EXPECT_THROW(vec.emplace_back("third"), std::runtime_error);
+  ASSERT_EQ(vec.size(), 2);  // Fresh buffer freed (LSan), elements intact
+  EXPECT_TRUE(vec.isInline());
+  EXPECT_EQ(vec[0].value, "first");
+  EXPECT_EQ(vec[1].value, "second");
+
+  ThrowingCopy::copiesLeft = 100;
+  vec.emplace_back("third");
+  EXPECT_EQ(vec.size(), 3);
+  EXPECT_EQ(vec.back().value, "third");
+}
+
+TEST(Day4StaticStackTest, PushPopTop) {
+  StaticStack<int, 3> stack;
+  EXPECT_TRUE(stack.push(1));
+  EXPECT_TRUE(stack.push(2));
+  EXPECT_EQ(stack.top(), 2);
+  stack.pop();
+  EXPECT_EQ(stack.top(), 1);
+  EXPECT_EQ(stack.size(), 1);
+}
+
+TEST(Day4StaticStackTest, RejectsPushWhenFull) {
+  StaticStack<int, 2> stack;
+  EXPECT_TRUE(stack.push(1));
+  EXPECT_TRUE(stack.push(2));
+  EXPECT_TRUE(stack.full());
+  EXPECT_FALSE(stack.push(3));
+  EXPECT_EQ(stack.top(), 2);
+}
+
+TEST(Day4StaticStackTest, MoveTransfersElements) {
+  StaticStack<std::string, 4> src;
+  src.push("bottom");
+  src.push("top");
+  StaticStack<std::string, 4> dst(std::move(src));
+  EXPECT_EQ(dst.size(), 2);
+  EXPECT_EQ(dst.top(), "top");
+  EXPECT_TRUE(src.empty());
+}
+
+TEST(Day4SpscRingBufferTest, CapacityRoundsToPowerOfTwo) {
+  SpscRingBuffer<int> queue(5);
+  EXPECT_EQ(queue.capacity(), 8);
+}
+
+TEST(Day4SpscRingBufferTest, FifoAndFullEmpty) {
+  SpscRingBuffer<int> queue(4);
+  for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.tryPush(i));
+  EXPECT_FALSE(queue.tryPush(99));
+  int val = -1;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.tryPop(val));
+    EXPECT_EQ(val, i);
+  }
+  EXPECT_FALSE(queue.tryPop(val));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(Day4SpscRingBufferTest, BatchPushPopWraps) {
+  SpscRingBuffer<int> queue(8);
+  int in[6] = {0, 1, 2, 3, 4, 5};
+  int out[8] = {};
+  EXPECT_EQ(queue.tryPushBatch(in, 6), 6);
+  EXPECT_EQ(queue.tryPopBatch(out, 4), 4);
+  EXPECT_EQ(queue.tryPushBatch(in, 6), 6);  // Wraps around the end.
+  EXPECT_EQ(queue.tryPushBatch(in, 6), 0);  // Full.
+  EXPECT_EQ(queue.tryPopBatch(out, 8), 8);
+  EXPECT_EQ(out[0], 4);
+  EXPECT_EQ(out[1], 5);
+  EXPECT_EQ(out[2], 0);
+  EXPECT_EQ(out[7], 5);
+}
+
+TEST(Day4SpscRingBufferTest, DestroysRemainingElements) {
+  auto tracker = std::make_shared<int>(0);
+  {
+    SpscRingBuffer<std::shared_ptr<int>> queue(4);
+    queue.tryPush(tracker);
+    queue.tryPush(tracker);
+    EXPECT_EQ(tracker.use_count(), 3);
+  }
+  EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(Day4SpscRingBufferTest, ProducerConsumerThreads) {
+  constexpr int COUNT = 100000;
+  SpscRingBuffer<int> queue(64);
+  std::thread producer([&] {
+    for (int i = 0; i < COUNT; ++i) {
+      while (!queue.tryPush(i)) std::this_thread::yield();
+    }
+  });
+  long long sum = 0;
+  int expected = 0;
+  bool in_order = true;
+  while (expected < COUNT) {
+    int val;
+    if (queue.tryPop(val)) {
+      in_order &= (val == expected);
+      sum += val;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(sum, static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+}
+
 TEST(Day4ExpressionTemplatesTest, LazyEvaluation) {
-  EXPECT_TRUE(true);
+  Vector<double> a(3), b(3), c(3);
+  for (size_t i = 0; i < 3; ++i) {
+    a[i] = 1.0 + i;
+    b[i] = 2.0;
+    c[i] = 10.0 * i;
+  }
+  auto expr = a + b * c;
+  a[0] = 100.0;  // Nothing computed yet: the expression sees the update.
+  Vector<double> result = expr;
+  EXPECT_EQ(result.size(), 3);
+  EXPECT_DOUBLE_EQ(result[0], 100.0);
+  EXPECT_DOUBLE_EQ(result[1], 2.0 + 20.0);
+  EXPECT_DOUBLE_EQ(result[2], 3.0 + 40.0);
+}
+
+TEST(Day4ExpressionTemplatesTest, ScalarBroadcast) {
+  Vector<double> a(4);
+  for (size_t i = 0; i < 4; ++i) a[i] = static_cast<double>(i);
+  Vector<double> result = 2.0 * a - 1.0;
+  EXPECT_DOUBLE_EQ(result[0], -1.0);
+  EXPECT_DOUBLE_EQ(result[3], 5.0);
+  Vector<double> halved = a / 2.0;
+  EXPECT_DOUBLE_EQ(halved[3], 1.5);
+}
+
+TEST(Day4ExpressionTemplatesTest, AssignmentMayAliasOperand) {
+  Vector<int> a(3), b(3);
+  for (int i = 0; i < 3; ++i) {
+    a[i] = i;
+    b[i] = 10;
+  }
+  a = a + b * a;
+  EXPECT_EQ(a[0], 0);
+  EXPECT_EQ(a[1], 11);
+  EXPECT_EQ(a[2], 22);
+}
+
+TEST(Day4ExpressionTemplatesTest, ExpressionNodesHoldNoStorage) {
+  Vector<float> a(1000), b(1000);
+  auto expr = a + b;
+  // Two references to the leaves, no buffer of its own.
+  EXPECT_LE(sizeof(expr), 2 * sizeof(void*));
+  EXPECT_EQ(expr.size(), 1000);
 }
 
 int main(int argc, char** argv) {
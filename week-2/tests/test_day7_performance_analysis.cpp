@@ -1,5 +1,6 @@
 #include "performance_analyzer.h"
 #include <gtest/gtest.h>
+#include <sstream>
 #include <vector>
 
 TEST(Day7PerformanceTest, VectorPerformance) {
@@ -22,6 +23,109 @@ TEST(Day7PerformanceTest, AllocationPerformance) {
   EXPECT_GT(time, 0);
 }
 
+TEST(Day7PerformanceTest, HardwareCountersOrGracefulFallback) {
+  PerformanceAnalyzer analyzer;
+  constexpr size_t OPS = 100000;
+  std::vector<int> v(OPS, 1);
+  long long sum = 0;
+  PerfMeasurement m = analyzer.measureWithCounters([&]() {
+    for (int x : v) sum += x;
+  }, OPS);
+  EXPECT_EQ(sum, static_cast<long long>(OPS));
+  EXPECT_EQ(m.operations, OPS);
+  EXPECT_GE(m.wall_us, 0);
+  if (m.counters.has(HardwareEvent::INSTRUCTIONS)) {
+    EXPECT_GT(m.perOperation(HardwareEvent::INSTRUCTIONS), 0.0);
+  } else {
+    EXPECT_EQ(m.perOperation(HardwareEvent::INSTRUCTIONS), -1.0);
+  }
+  if (!PerformanceAnalyzer::countersAvailable()) {
+    EXPECT_FALSE(m.counters.anyAvailable());
+    EXPECT_EQ(m.ipc(), 0.0);
+  }
+}
+
+TEST(Day7PerformanceTest, DerivedMetrics) {
+  PerfMeasurement m;
+  m.operations = 10;
+  m.counters.values[static_cast<size_t>(HardwareEvent::CYCLES)] = 200;
+  m.counters.valid[static_cast<size_t>(HardwareEvent::CYCLES)] = true;
+  m.counters.values[static_cast<size_t>(HardwareEvent::INSTRUCTIONS)] = 500;
+  m.counters.valid[static_cast<size_t>(HardwareEvent::INSTRUCTIONS)] = true;
+  m.counters.values[static_cast<size_t>(HardwareEvent::CACHE_MISSES)] = 30;
+  m.counters.valid[static_cast<size_t>(HardwareEvent::CACHE_MISSES)] = true;
+  EXPECT_DOUBLE_EQ(m.ipc(), 2.5);
+  EXPECT_DOUBLE_EQ(m.perOperation(HardwareEvent::CACHE_MISSES), 3.0);
+  EXPECT_DOUBLE_EQ(m.perOperation(HardwareEvent::DTLB_MISSES), -1.0);
+  std::ostringstream out;
+  m.report(out);
+  EXPECT_NE(out.str().find("IPC=2.5"), std::string::npos);
+  EXPECT_NE(out.str().find("cache-misses/op=3"), std::string::npos);
+  EXPECT_NE(out.str().find("dTLB-misses/op=n/a"), std::string::npos);
+}
+
+TEST(Day7LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram h;
+  for (uint64_t v = 1; v <= 100; ++v) h.record(v);
+  EXPECT_EQ(h.count(), 100);
+  EXPECT_EQ(h.min(), 1);
+  EXPECT_EQ(h.max(), 100);
+  EXPECT_EQ(h.percentile(50), 50);
+  EXPECT_EQ(h.percentile(99), 99);
+  EXPECT_DOUBLE_EQ(h.mean(), 50.5);
+}
+
+TEST(Day7LatencyHistogramTest, LargeValuesWithinRelativeError) {
+  LatencyHistogram h;
+  for (uint64_t v : {1000ull, 123456ull, 987654321ull, 1ull << 62}) {
+    h.reset();
+    h.record(v);
+    h.record(v + 1);  // Keep min/max from clamping the bucket estimate.
+    h.record(v * 2);
+    const uint64_t p = h.percentile(50);
+    EXPECT_GE(p, v);
+    EXPECT_LE(static_cast<double>(p - v), static_cast<double>(v) / 64.0);
+  }
+}
+
+TEST(Day7LatencyHistogramTest, TailPercentiles) {
+  LatencyHistogram h;
+  for (int i = 0; i < 990; ++i) h.record(10);
+  for (int i = 0; i < 9; ++i) h.record(1000);
+  h.record(50000);
+  EXPECT_EQ(h.percentile(50), 10);
+  EXPECT_EQ(h.percentile(99), 10);
+  EXPECT_GE(h.percentile(99.9), 1000);
+  EXPECT_LE(h.percentile(99.9), 1016);
+  EXPECT_EQ(h.percentile(100), 50000);
+}
+
+TEST(Day7TscClockTest, CalibratedAndMonotonic) {
+  EXPECT_GT(TscClock::nsPerTick(), 0.0);
+  const uint64_t a = TscClock::start();
+  const uint64_t b = TscClock::stop();
+  EXPECT_GE(b, a);
+}
+
+TEST(Day7PerformanceTest, LatencyPercentiles) {
+  PerformanceAnalyzer analyzer;
+  std::vector<int> v(64, 1);
+  LatencyReport r = analyzer.measureLatency([&]() {
+    int sum = 0;
+    for (int x : v) sum += x;
+    volatile int sink = sum;
+    (void)sink;
+  }, 10000);
+  EXPECT_EQ(r.iterations, 10000);
+  EXPECT_EQ(r.histogram.count(), 10000);
+  EXPECT_GE(r.timer_overhead_ns, 0.0);
+  EXPECT_LE(r.min_ns, r.p50_ns);
+  EXPECT_LE(r.p50_ns, r.p90_ns);
+  EXPECT_LE(r.p90_ns, r.p99_ns);
+  EXPECT_LE(r.p99_ns, r.p999_ns);
+  EXPECT_LE(r.p999_ns, r.max_ns);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,110 @@
+#include "coro_task.h"
+#include "future.h"
+#include "thread_pool.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+/**
+ * Coroutine Task<T> vs. callback-based futures on the same ThreadPool.
+ * - AwaitSync: co_await of a task that completes immediately (frame from
+ *   FramePool + two symmetric transfers): the raw coroutine switch cost
+ * - Hop: one pipeline stage that moves to a worker, via
+ *   `co_await pool.schedule()` vs. Future::then()
+ * - Pipeline throughput: CHAINS independent pipelines of STAGES hops each,
+ *   all in flight at once
+ */
+
+constexpr int STAGES = 64;
+constexpr int CHAINS = 256;
+
+static Task<int> immediate(int v) { co_return v; }
+
+static Task<int64_t> awaitMany(int n) {
+  int64_t sum = 0;
+  for (int i = 0; i < n; ++i) sum += co_await immediate(i);
+  co_return sum;
+}
+
+static void BM_CoroutineAwaitSync(benchmark::State& state) {
+  constexpr int AWAITS = 1 << 12;
+  for (auto _ : state) benchmark::DoNotOptimize(syncWait(awaitMany(AWAITS)));
+  state.SetItemsProcessed(state.iterations() * AWAITS);
+}
+
+static Task<int64_t> hopChain(ThreadPool& pool, int stages) {
+  int64_t value = 0;
+  for (int i = 0; i < stages; ++i) {
+    co_await pool.schedule();
+    value += i;
+  }
+  co_return value;
+}
+
+static Future<int64_t> futureChain(ThreadPool& pool, int stages) {
+  Future<int64_t> f = pool.submit([] { return int64_t{0}; });
+  for (int i = 1; i < stages; ++i) f = f.then([i](int64_t v) { return v + i; });
+  return f;
+}
+
+static void BM_CoroutineHop(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) benchmark::DoNotOptimize(syncWait(hopChain(pool, STAGES)));
+  state.SetItemsProcessed(state.iterations() * STAGES);
+}
+
+static void BM_FutureThenHop(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) benchmark::DoNotOptimize(futureChain(pool, STAGES).get());
+  state.SetItemsProcessed(state.iterations() * STAGES);
+}
+
+// Fire-and-forget coroutine for launching many chains at once.
+struct Spawned {
+  struct promise_type {
+    Spawned get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+static Spawned runChain(ThreadPool& pool, std::atomic<int>& remaining, std::atomic<int64_t>& sink) {
+  sink.fetch_add(co_await hopChain(pool, STAGES), std::memory_order_relaxed);
+  if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) remaining.notify_all();
+}
+
+static void BM_CoroutinePipeline(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  std::atomic<int64_t> sink{0};
+  for (auto _ : state) {
+    std::atomic<int> remaining{CHAINS};
+    for (int c = 0; c < CHAINS; ++c) runChain(pool, remaining, sink);
+    for (int r = remaining.load(); r != 0; r = remaining.load()) remaining.wait(r);
+  }
+  benchmark::DoNotOptimize(sink.load());
+  state.SetItemsProcessed(state.iterations() * CHAINS * STAGES);
+}
+
+static void BM_FuturePipeline(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<Future<int64_t>> chains;
+    chains.reserve(CHAINS);
+    for (int c = 0; c < CHAINS; ++c) chains.push_back(futureChain(pool, STAGES));
+    benchmark::DoNotOptimize(whenAll(std::move(chains)).get());
+  }
+  state.SetItemsProcessed(state.iterations() * CHAINS * STAGES);
+}
+
+BENCHMARK(BM_CoroutineAwaitSync);
+BENCHMARK(BM_CoroutineHop)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_FutureThenHop)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_CoroutinePipeline)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK(BM_FuturePipeline)->Arg(1)->Arg(4)->UseRealTime();
+
+BENCHMARK_MAIN();
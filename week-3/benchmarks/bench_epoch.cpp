@@ -0,0 +1,103 @@
+#include "epoch.h"
+#include "hazard_pointer.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Read-side cost of safe memory reclamation. Each iteration loads a shared
+ * pointer and reads through it:
+ * - Unprotected: plain acquire load (the floor; unsafe with frees)
+ * - Ebr: one EpochGuard per read (store + fence on entry)
+ * - Qsbr: online participant, quiescent() after every read (a load and
+ *   compare unless the epoch moved)
+ * - HazardPointer: protect() per read (store + fence + re-validate)
+ * The *UnderUpdates variants run a writer thread that keeps replacing and
+ * retiring the object, so epochs advance and memory is really reclaimed.
+ */
+
+struct Payload {
+  int64_t value = 1;
+};
+
+static EpochDomain domain;
+static std::atomic<Payload*> shared{new Payload};
+
+// Replaces and retires the shared object until stopped.
+class Updater {
+ public:
+  Updater()
+      : thread_([this] {
+          EpochParticipant self(domain);
+          while (!stop_.load(std::memory_order_relaxed)) {
+            self.retire(shared.exchange(new Payload, std::memory_order_acq_rel));
+            std::this_thread::yield();
+          }
+        }) {}
+  ~Updater() {
+    stop_.store(true);
+    thread_.join();
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+static void BM_Unprotected(benchmark::State& state) {
+  int64_t sum = 0;
+  for (auto _ : state) sum += shared.load(std::memory_order_acquire)->value;
+  benchmark::DoNotOptimize(sum);
+}
+
+static void ebrReads(benchmark::State& state) {
+  EpochParticipant self(domain);
+  int64_t sum = 0;
+  for (auto _ : state) {
+    EpochGuard guard(self);
+    sum += shared.load(std::memory_order_acquire)->value;
+  }
+  benchmark::DoNotOptimize(sum);
+}
+
+static void qsbrReads(benchmark::State& state) {
+  EpochParticipant self(domain);
+  self.online();
+  int64_t sum = 0;
+  for (auto _ : state) {
+    sum += shared.load(std::memory_order_acquire)->value;
+    self.quiescent();
+  }
+  self.offline();
+  benchmark::DoNotOptimize(sum);
+}
+
+static void BM_Ebr(benchmark::State& state) { ebrReads(state); }
+static void BM_Qsbr(benchmark::State& state) { qsbrReads(state); }
+
+static void BM_HazardPointer(benchmark::State& state) {
+  HazardPointer hp;
+  int64_t sum = 0;
+  for (auto _ : state) sum += hp.protect(shared)->value;
+  benchmark::DoNotOptimize(sum);
+}
+
+static void BM_EbrUnderUpdates(benchmark::State& state) {
+  Updater updater;
+  ebrReads(state);
+}
+
+static void BM_QsbrUnderUpdates(benchmark::State& state) {
+  Updater updater;
+  qsbrReads(state);
+}
+
+BENCHMARK(BM_Unprotected)->ThreadRange(1, 4);
+BENCHMARK(BM_Ebr)->ThreadRange(1, 4);
+BENCHMARK(BM_Qsbr)->ThreadRange(1, 4);
+BENCHMARK(BM_HazardPointer)->ThreadRange(1, 4);
+BENCHMARK(BM_EbrUnderUpdates);
+BENCHMARK(BM_QsbrUnderUpdates);
+
+BENCHMARK_MAIN();
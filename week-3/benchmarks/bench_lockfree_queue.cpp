@@ -0,0 +1,151 @@
+#include "lockfree_queue.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * Bounded MPMC queue throughput, ops/sec (items_per_second counts each
+ * item once: one push + one pop), across producer/consumer counts:
+ * - LockFree: LockFreeQueue tryPush/tryPop
+ * - LockFreeBatch: LockFreeQueue with BATCH-item batches
+ * - Mutex: std::queue behind one std::mutex, same capacity bound
+ * Full/empty attempts spin with a yield in all three.
+ */
+
+constexpr size_t CAPACITY = 1024;
+constexpr int64_t ITEMS_PER_PRODUCER = 1 << 16;
+constexpr size_t BATCH = 16;
+
+class MutexQueue {
+ public:
+  explicit MutexQueue(size_t capacity) : capacity_(capacity) {}
+
+  bool tryPush(int64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.size() >= capacity_) return false;
+    items_.push(value);
+    return true;
+  }
+
+  bool tryPop(int64_t& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.empty()) return false;
+    value = items_.front();
+    items_.pop();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::queue<int64_t> items_;
+  size_t capacity_;
+};
+
+// Runs producers and consumers to completion; push/pop move a count of
+// items (0 when full/empty).
+template <typename Push, typename Pop>
+static void runRound(int producers, int consumers, Push&& push, Pop&& pop) {
+  const int64_t total = producers * ITEMS_PER_PRODUCER;
+  std::atomic<int64_t> consumed{0};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (int64_t i = 0; i < ITEMS_PER_PRODUCER;) {
+        const size_t n = push(p * ITEMS_PER_PRODUCER + i, ITEMS_PER_PRODUCER - i);
+        if (n == 0) std::this_thread::yield();
+        i += static_cast<int64_t>(n);
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      int64_t sum = 0;
+      while (consumed.load(std::memory_order_relaxed) < total) {
+        const size_t n = pop(sum);
+        if (n == 0) {
+          std::this_thread::yield();
+        } else {
+          consumed.fetch_add(static_cast<int64_t>(n), std::memory_order_relaxed);
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    });
+  }
+  for (auto& t : threads) t.join();
+}
+
+static void BM_LockFree(benchmark::State& state) {
+  const int producers = static_cast<int>(state.range(0));
+  const int consumers = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    LockFreeQueue<int64_t> queue(CAPACITY);
+    runRound(
+        producers, consumers,
+        [&](int64_t v, int64_t) -> size_t { return queue.tryPush(v) ? 1 : 0; },
+        [&](int64_t& sum) -> size_t {
+          int64_t v;
+          if (!queue.tryPop(v)) return 0;
+          sum += v;
+          return 1;
+        });
+  }
+  state.SetItemsProcessed(state.iterations() * producers * ITEMS_PER_PRODUCER);
+}
+
+static void BM_LockFreeBatch(benchmark::State& state) {
+  const int producers = static_cast<int>(state.range(0));
+  const int consumers = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    LockFreeQueue<int64_t> queue(CAPACITY);
+    runRound(
+        producers, consumers,
+        [&](int64_t first, int64_t left) -> size_t {
+          int64_t batch[BATCH];
+          const size_t n = static_cast<size_t>(std::min<int64_t>(BATCH, left));
+          for (size_t k = 0; k < n; ++k) batch[k] = first + static_cast<int64_t>(k);
+          return queue.tryPushBatch(batch, n);
+        },
+        [&](int64_t& sum) -> size_t {
+          int64_t batch[BATCH];
+          const size_t n = queue.tryPopBatch(batch, BATCH);
+          for (size_t k = 0; k < n; ++k) sum += batch[k];
+          return n;
+        });
+  }
+  state.SetItemsProcessed(state.iterations() * producers * ITEMS_PER_PRODUCER);
+}
+
+static void BM_Mutex(benchmark::State& state) {
+  const int producers = static_cast<int>(state.range(0));
+  const int consumers = static_cast<int>(state.range(1));
+  for (auto _ : state) {
+    MutexQueue queue(CAPACITY);
+    runRound(
+        producers, consumers,
+        [&](int64_t v, int64_t) -> size_t { return queue.tryPush(v) ? 1 : 0; },
+        [&](int64_t& sum) -> size_t {
+          int64_t v;
+          if (!queue.tryPop(v)) return 0;
+          sum += v;
+          return 1;
+        });
+  }
+  state.SetItemsProcessed(state.iterations() * producers * ITEMS_PER_PRODUCER);
+}
+
+// Args: {producers, consumers}
+#define PRODUCER_CONSUMER_SWEEP                                       \
+  Args({1, 1})->Args({2, 2})->Args({4, 4})->Args({1, 4})->Args({4, 1}) \
+      ->ArgNames({"producers", "consumers"})                           \
+      ->UseRealTime()
+
+BENCHMARK(BM_LockFree)->PRODUCER_CONSUMER_SWEEP;
+BENCHMARK(BM_LockFreeBatch)->PRODUCER_CONSUMER_SWEEP;
+BENCHMARK(BM_Mutex)->PRODUCER_CONSUMER_SWEEP;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+#include "ms_queue.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+
+/**
+ * Unbounded queues under contention: every benchmark thread repeatedly
+ * pushes one item and pops one (the queue starts with PREFILL items, so
+ * pops rarely find it empty). items_per_second counts push+pop pairs
+ * summed over all threads.
+ * - MichaelScott: MichaelScottQueue (hazard pointers, FramePool nodes)
+ * - Mutex: std::queue behind one std::mutex
+ */
+
+constexpr int PREFILL = 1024;
+
+class MutexQueue {
+ public:
+  void push(int64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    items_.push(value);
+  }
+
+  bool tryPop(int64_t& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.empty()) return false;
+    value = items_.front();
+    items_.pop();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::queue<int64_t> items_;
+};
+
+// Takes the global by reference: thread 0 creates the queue, and only the
+// framework's start barrier (entering the loop) orders that before use.
+template <typename Queue>
+static void pushPopPairs(benchmark::State& state, Queue* const& shared) {
+  int64_t sum = 0;
+  int64_t value = 0;
+  for (auto _ : state) {
+    Queue& queue = *shared;
+    queue.push(state.iterations());
+    if (queue.tryPop(value)) sum += value;
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static MichaelScottQueue<int64_t>* ms_queue = nullptr;
+static MutexQueue* mutex_queue = nullptr;
+
+static void BM_MichaelScott(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    ms_queue = new MichaelScottQueue<int64_t>;
+    for (int i = 0; i < PREFILL; ++i) ms_queue->push(i);
+  }
+  pushPopPairs(state, ms_queue);
+  if (state.thread_index() == 0) {
+    delete ms_queue;
+    ms_queue = nullptr;
+  }
+}
+
+static void BM_Mutex(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    mutex_queue = new MutexQueue;
+    for (int i = 0; i < PREFILL; ++i) mutex_queue->push(i);
+  }
+  pushPopPairs(state, mutex_queue);
+  if (state.thread_index() == 0) {
+    delete mutex_queue;
+    mutex_queue = nullptr;
+  }
+}
+
+BENCHMARK(BM_MichaelScott)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_Mutex)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,179 @@
+#include "thread_pool.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Worker placement vs. remote memory traffic.
+ * Every worker repeatedly streams over its own buffer (BUFFER_BYTES):
+ * - MainTouched: buffers allocated and zeroed by the benchmark thread, so
+ *   first-touch puts every page on the benchmark thread's node
+ * - FirstTouchScratch: buffers come from localScratch(), touched by each
+ *   (pinned) worker itself
+ * Both run unpinned (NONE) and pinned (COMPACT, SCATTER).
+ *
+ * Counters (when perf_event_open allows it): node_loads and
+ * node_load_misses are the generic NODE cache events (LLC misses served by
+ * local vs. remote memory on most PMUs); remote_ratio = misses / loads.
+ * They are opened with inherit=1 before the pool exists and read after it
+ * is destroyed, because inherited counts are folded in at thread exit.
+ * On a single-node machine the ratio stays near zero for every policy.
+ */
+
+constexpr size_t BUFFER_BYTES = 8u << 20;
+constexpr int PASSES = 4;
+
+class NodeLoadCounters {
+ public:
+  NodeLoadCounters() {
+#ifdef __linux__
+    loads_ = open(PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+    misses_ = open(PERF_COUNT_HW_CACHE_RESULT_MISS);
+#endif
+  }
+
+  ~NodeLoadCounters() {
+#ifdef __linux__
+    if (loads_ >= 0) close(loads_);
+    if (misses_ >= 0) close(misses_);
+#endif
+  }
+
+  bool available() const { return loads_ >= 0 && misses_ >= 0; }
+
+  uint64_t loads() const { return read(loads_); }
+  uint64_t misses() const { return read(misses_); }
+
+ private:
+#ifdef __linux__
+  static int open(uint64_t result) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_NODE | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  static uint64_t read(int fd) {
+    uint64_t value = 0;
+    if (fd < 0 || ::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+      return 0;
+    }
+    return value;
+  }
+#else
+  static uint64_t read(int) { return 0; }
+#endif
+
+  int loads_ = -1;
+  int misses_ = -1;
+};
+
+static uint64_t streamBuffer(const uint64_t* data, size_t words) {
+  uint64_t sum = 0;
+  for (int pass = 0; pass < PASSES; ++pass) {
+    for (size_t i = 0; i < words; ++i) sum += data[i];
+  }
+  return sum;
+}
+
+// One task per worker. Tasks go through the shared injection queue, so
+// each one waits at a start barrier until all pool.size() tasks are
+// running: a worker blocked at the barrier cannot take a second task, so
+// every worker ends up with exactly one. Each task then streams the buffer
+// of the worker it landed on.
+template <typename BufferFor>
+static void runOnEveryWorker(ThreadPool& pool, BufferFor&& buffer_for,
+                             std::atomic<uint64_t>& sink) {
+  std::atomic<size_t> started{0};
+  for (size_t t = 0; t < pool.size(); ++t) {
+    pool.enqueue([&pool, &buffer_for, &sink, &started] {
+      started.fetch_add(1, std::memory_order_acq_rel);
+      while (started.load(std::memory_order_acquire) < pool.size()) std::this_thread::yield();
+      const auto* data = static_cast<const uint64_t*>(
+          buffer_for(static_cast<size_t>(pool.currentWorkerIndex())));
+      sink.fetch_add(streamBuffer(data, BUFFER_BYTES / sizeof(uint64_t)),
+                     std::memory_order_relaxed);
+    });
+  }
+  pool.wait();
+}
+
+static void reportCounters(benchmark::State& state, const NodeLoadCounters& counters) {
+  state.counters["counters_valid"] = counters.available() ? 1 : 0;
+  if (!counters.available()) return;
+  const double loads = static_cast<double>(counters.loads());
+  const double misses = static_cast<double>(counters.misses());
+  state.counters["node_loads"] = loads;
+  state.counters["node_load_misses"] = misses;
+  state.counters["remote_ratio"] = loads > 0 ? misses / loads : 0.0;
+}
+
+static ThreadPoolOptions optionsFor(const benchmark::State& state) {
+  ThreadPoolOptions options;
+  options.num_threads = static_cast<size_t>(state.range(0));
+  options.affinity = static_cast<AffinityPolicy>(state.range(1));
+  return options;
+}
+
+static void BM_MainTouched(benchmark::State& state) {
+  NodeLoadCounters counters;
+  std::atomic<uint64_t> sink{0};
+  {
+    ThreadPool pool(optionsFor(state));
+    std::vector<std::unique_ptr<uint64_t[]>> buffers;
+    for (size_t i = 0; i < pool.size(); ++i) {
+      buffers.emplace_back(new uint64_t[BUFFER_BYTES / sizeof(uint64_t)]());
+    }
+    auto buffer_for = [&](size_t worker) { return buffers[worker].get(); };
+    for (auto _ : state) runOnEveryWorker(pool, buffer_for, sink);
+  }
+  benchmark::DoNotOptimize(sink.load());
+  state.SetBytesProcessed(state.iterations() * state.range(0) * BUFFER_BYTES * PASSES);
+  reportCounters(state, counters);
+}
+
+static void BM_FirstTouchScratch(benchmark::State& state) {
+  NodeLoadCounters counters;
+  std::atomic<uint64_t> sink{0};
+  {
+    ThreadPoolOptions options = optionsFor(state);
+    options.scratch_bytes = BUFFER_BYTES;
+    ThreadPool pool(options);
+    auto buffer_for = [&](size_t) { return pool.localScratch(BUFFER_BYTES); };
+    for (auto _ : state) runOnEveryWorker(pool, buffer_for, sink);
+  }
+  benchmark::DoNotOptimize(sink.load());
+  state.SetBytesProcessed(state.iterations() * state.range(0) * BUFFER_BYTES * PASSES);
+  reportCounters(state, counters);
+}
+
+// Args: {threads, AffinityPolicy}
+#define PLACEMENT_SWEEP                                                               \
+  ArgsProduct({{2, 8},                                                                \
+               {static_cast<int64_t>(AffinityPolicy::NONE),                           \
+                static_cast<int64_t>(AffinityPolicy::COMPACT),                        \
+                static_cast<int64_t>(AffinityPolicy::SCATTER)}})                      \
+      ->ArgNames({"threads", "policy"})                                               \
+      ->UseRealTime()
+
+BENCHMARK(BM_MainTouched)->PLACEMENT_SWEEP;
+BENCHMARK(BM_FirstTouchScratch)->PLACEMENT_SWEEP;
+
+BENCHMARK_MAIN();
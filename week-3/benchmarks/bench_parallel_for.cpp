@@ -0,0 +1,113 @@
+#include "parallel_for.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * parallelFor (lazy binary splitting, auto grain) vs. OpenMP-style static
+ * partitioning (schedule(static): one contiguous block per thread).
+ * - Uniform: every iteration costs the same; static is the ideal split
+ * - Triangular: cost grows linearly with i; the last block holds ~2x the
+ *   average work
+ * - Clustered: 2% of iterations are 100x heavier and sit in one region,
+ *   so a single static block gets most of the work
+ * Static partitioning is built on the same pool so only the split policy
+ * differs.
+ */
+
+constexpr size_t ITERATIONS = 1 << 14;
+
+enum class Workload { UNIFORM, TRIANGULAR, CLUSTERED };
+
+static std::vector<uint32_t> makeCosts(Workload workload) {
+  std::vector<uint32_t> costs(ITERATIONS);
+  std::mt19937 rng(42);
+  for (size_t i = 0; i < ITERATIONS; ++i) {
+    switch (workload) {
+      case Workload::UNIFORM:
+        costs[i] = 64;
+        break;
+      case Workload::TRIANGULAR:
+        costs[i] = static_cast<uint32_t>(1 + 128 * i / ITERATIONS);
+        break;
+      case Workload::CLUSTERED: {
+        // Heavy iterations concentrated in the first eighth of the range.
+        const bool heavy = i < ITERATIONS / 8 && rng() % 6 == 0;
+        costs[i] = heavy ? 6400 : 64;
+        break;
+      }
+    }
+  }
+  return costs;
+}
+
+// Roughly `cost` dependent floating-point steps.
+static double work(uint32_t cost, size_t seed) {
+  double x = static_cast<double>(seed & 1023) * 1e-3;
+  for (uint32_t k = 0; k < cost; ++k) x = std::sqrt(x * x + 1.0) - 0.5;
+  return x;
+}
+
+static void staticPartitionFor(ThreadPool& pool, size_t n,
+                               const std::vector<uint32_t>& costs, std::vector<double>& out) {
+  const size_t blocks = pool.size();
+  for (size_t b = 0; b < blocks; ++b) {
+    const size_t lo = n * b / blocks;
+    const size_t hi = n * (b + 1) / blocks;
+    pool.enqueue([&costs, &out, lo, hi] {
+      for (size_t i = lo; i < hi; ++i) out[i] = work(costs[i], i);
+    });
+  }
+  pool.wait();
+}
+
+static void BM_LazySplitting(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  const auto costs = makeCosts(static_cast<Workload>(state.range(1)));
+  std::vector<double> out(ITERATIONS);
+  for (auto _ : state) {
+    parallelFor(pool, 0, ITERATIONS, [&](size_t i) { out[i] = work(costs[i], i); });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ITERATIONS);
+}
+
+static void BM_StaticPartition(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  const auto costs = makeCosts(static_cast<Workload>(state.range(1)));
+  std::vector<double> out(ITERATIONS);
+  for (auto _ : state) {
+    staticPartitionFor(pool, ITERATIONS, costs, out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * ITERATIONS);
+}
+
+static void BM_LazySplittingReduce(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  const auto costs = makeCosts(static_cast<Workload>(state.range(1)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parallelReduce(
+        pool, 0, ITERATIONS, 0.0, [&](size_t i) { return work(costs[i], i); },
+        [](double a, double b) { return a + b; }));
+  }
+  state.SetItemsProcessed(state.iterations() * ITERATIONS);
+}
+
+// Args: {threads, workload}
+#define SWEEP                                                                              \
+  ArgsProduct({{1, 2, 4, 8},                                                               \
+               {static_cast<int64_t>(Workload::UNIFORM),                                   \
+                static_cast<int64_t>(Workload::TRIANGULAR),                                \
+                static_cast<int64_t>(Workload::CLUSTERED)}})                               \
+      ->ArgNames({"threads", "workload"})                                                  \
+      ->UseRealTime()
+
+BENCHMARK(BM_LazySplitting)->SWEEP;
+BENCHMARK(BM_StaticPartition)->SWEEP;
+BENCHMARK(BM_LazySplittingReduce)->SWEEP;
+
+BENCHMARK_MAIN();
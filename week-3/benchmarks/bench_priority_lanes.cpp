@@ -0,0 +1,85 @@
+#include "delay_histogram.h"
+#include "thread_pool.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * Latency-critical tasks mixed into a bulk backlog.
+ * Each iteration queues BULK_TASKS analytics tasks (~BULK_WORK_NS of
+ * spinning each) with one short "order" task after every ORDER_EVERY of
+ * them, then waits for everything:
+ * - Fifo: all tasks on the NORMAL lane, so orders queue behind the backlog
+ * - Lanes: orders on HIGH, bulk on LOW
+ * - Reserved: as Lanes, plus one worker reserved for HIGH
+ * Counters are queueing delays (enqueue to start) per class, in µs,
+ * measured by the tasks themselves so every mode is measured the same way.
+ */
+
+constexpr int BULK_TASKS = 2000;
+constexpr int ORDER_EVERY = 20;
+constexpr int64_t BULK_WORK_NS = 20000;
+
+enum class LaneMode { FIFO, LANES, RESERVED };
+
+static int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static void spinFor(int64_t ns) {
+  const int64_t until = nowNs() + ns;
+  while (nowNs() < until) {
+  }
+}
+
+static void BM_MixedLoad(benchmark::State& state) {
+  const auto mode = static_cast<LaneMode>(state.range(1));
+  ThreadPoolOptions options;
+  options.num_threads = static_cast<size_t>(state.range(0));
+  options.reserved_high_workers = mode == LaneMode::RESERVED ? 1 : 0;
+  ThreadPool pool(options);
+  const bool fifo = mode == LaneMode::FIFO;
+  const TaskPriority order_lane = fifo ? TaskPriority::NORMAL : TaskPriority::HIGH;
+  const TaskPriority bulk_lane = fifo ? TaskPriority::NORMAL : TaskPriority::LOW;
+
+  DelayHistogram order_delay;
+  DelayHistogram bulk_delay;
+  std::atomic<uint64_t> sink{0};
+  for (auto _ : state) {
+    for (int i = 0; i < BULK_TASKS; ++i) {
+      const int64_t queued_at = nowNs();
+      pool.enqueue([&, queued_at] {
+        bulk_delay.record(static_cast<uint64_t>(nowNs() - queued_at));
+        spinFor(BULK_WORK_NS);
+      }, bulk_lane);
+      if (i % ORDER_EVERY == ORDER_EVERY - 1) {
+        pool.enqueue([&, queued_at] {
+          order_delay.record(static_cast<uint64_t>(nowNs() - queued_at));
+          sink.fetch_add(1, std::memory_order_relaxed);
+        }, order_lane);
+      }
+    }
+    pool.wait();
+  }
+  benchmark::DoNotOptimize(sink.load());
+  state.SetItemsProcessed(state.iterations() * BULK_TASKS);
+  state.counters["order_p50_us"] = order_delay.percentile(50) / 1e3;
+  state.counters["order_p99_us"] = order_delay.percentile(99) / 1e3;
+  state.counters["order_max_us"] = order_delay.max() / 1e3;
+  state.counters["bulk_p50_us"] = bulk_delay.percentile(50) / 1e3;
+  state.counters["bulk_p99_us"] = bulk_delay.percentile(99) / 1e3;
+}
+
+// Args: {threads, LaneMode}
+BENCHMARK(BM_MixedLoad)
+    ->ArgsProduct({{2, 4},
+                   {static_cast<int64_t>(LaneMode::FIFO), static_cast<int64_t>(LaneMode::LANES),
+                    static_cast<int64_t>(LaneMode::RESERVED)}})
+    ->ArgNames({"threads", "mode"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
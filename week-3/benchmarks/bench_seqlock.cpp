@@ -0,0 +1,111 @@
+#include "seqlock.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+/**
+ * Reader latency of single-writer snapshots while a writer thread stores
+ * back to back (heavy write contention). Each iteration reads one full
+ * snapshot; `retries` is failed read attempts per read.
+ * - SeqLock / DoubleBuffer: seqlock.h
+ * - Mutex / SharedMutex: the same value behind a lock, copied out
+ * Sizes: a 32-byte quote and a 1 KiB book (where SeqLock readers start
+ * losing to the writer and the double buffer pays off).
+ */
+
+template <size_t BYTES>
+struct Snapshot {
+  uint64_t fields[BYTES / sizeof(uint64_t)] = {};
+};
+
+using Quote = Snapshot<32>;
+using Book = Snapshot<1024>;
+
+template <typename T>
+class MutexBox {
+ public:
+  void store(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value_ = value;
+  }
+  bool tryLoad(T& value) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value = value_;
+    return true;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  T value_{};
+};
+
+template <typename T>
+class SharedMutexBox {
+ public:
+  void store(const T& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    value_ = value;
+  }
+  bool tryLoad(T& value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    value = value_;
+    return true;
+  }
+
+ private:
+  mutable std::shared_mutex mutex_;
+  T value_{};
+};
+
+// Stores continuously until destroyed.
+template <typename Box, typename T>
+class Writer {
+ public:
+  explicit Writer(Box& box)
+      : thread_([this, &box] {
+          T value;
+          while (!stop_.load(std::memory_order_relaxed)) {
+            ++value.fields[0];
+            box.store(value);
+          }
+        }) {}
+  ~Writer() {
+    stop_.store(true);
+    thread_.join();
+  }
+
+ private:
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+template <template <typename> class Box, typename T>
+static void BM_Read(benchmark::State& state) {
+  static Box<T> box;
+  Writer<Box<T>, T> writer(box);
+  T value;
+  int64_t retries = 0;
+  for (auto _ : state) {
+    for (int attempt = 0; !box.tryLoad(value); ++attempt) {
+      seqlock_detail::backoff(attempt);
+      ++retries;
+    }
+    benchmark::DoNotOptimize(value);
+  }
+  state.counters["retries"] =
+      benchmark::Counter(static_cast<double>(retries), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_TEMPLATE(BM_Read, SeqLock, Quote);
+BENCHMARK_TEMPLATE(BM_Read, VersionedDoubleBuffer, Quote);
+BENCHMARK_TEMPLATE(BM_Read, MutexBox, Quote);
+BENCHMARK_TEMPLATE(BM_Read, SharedMutexBox, Quote);
+BENCHMARK_TEMPLATE(BM_Read, SeqLock, Book);
+BENCHMARK_TEMPLATE(BM_Read, VersionedDoubleBuffer, Book);
+BENCHMARK_TEMPLATE(BM_Read, MutexBox, Book);
+BENCHMARK_TEMPLATE(BM_Read, SharedMutexBox, Book);
+
+BENCHMARK_MAIN();
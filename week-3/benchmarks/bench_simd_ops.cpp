@@ -0,0 +1,199 @@
+#include "simd_ops.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * Throughput of the simd_ops kernels at every dispatch level, with the
+ * working set sized for each level of the memory hierarchy. Args are
+ * {SimdLevel, floats per array}; bytes_per_second counts every array
+ * read or written (add: 3 arrays, fma: 4, dot: 2, sum/max: 1).
+ * Sizes (per array): 2K floats = 8 KiB (L1), 64K = 256 KiB (L2),
+ * 2M = 8 MiB (L3) and 16M = 64 MiB (DRAM). Levels the CPU lacks are
+ * skipped.
+ *
+ * Transcendentals (BM_Exp, BM_Log, BM_Erf, BM_NormalCdf): 4096 doubles
+ * (L1) per iteration at each level, next to the same loop over libm
+ * (BM_Libm*). items_per_second counts evaluations; max_ulp is the worst
+ * error on that input against long double libm.
+ */
+
+static bool selectLevel(benchmark::State& state) {
+  const auto level = static_cast<SimdLevel>(state.range(0));
+  if (!setSimdLevel(level)) {
+    state.SkipWithError("SIMD level not supported on this CPU");
+    return false;
+  }
+  state.SetLabel(simdLevelName(level));
+  return true;
+}
+
+static std::vector<float> data(size_t size, float value) { return std::vector<float>(size, value); }
+
+static void setThroughput(benchmark::State& state, size_t size, int arrays) {
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size * sizeof(float)) * arrays);
+}
+
+static void BM_Add(benchmark::State& state) {
+  if (!selectLevel(state)) return;
+  const size_t size = static_cast<size_t>(state.range(1));
+  auto a = data(size, 1.0f), b = data(size, 2.0f), result = data(size, 0.0f);
+  for (auto _ : state) {
+    vectorAdd(a.data(), b.data(), result.data(), size);
+    benchmark::ClobberMemory();
+  }
+  setThroughput(state, size, 3);
+}
+
+static void BM_Fma(benchmark::State& state) {
+  if (!selectLevel(state)) return;
+  const size_t size = static_cast<size_t>(state.range(1));
+  auto a = data(size, 1.0f), b = data(size, 2.0f), c = data(size, 3.0f);
+  auto result = data(size, 0.0f);
+  for (auto _ : state) {
+    vectorFma(a.data(), b.data(), c.data(), result.data(), size);
+    benchmark::ClobberMemory();
+  }
+  setThroughput(state, size, 4);
+}
+
+static void BM_Dot(benchmark::State& state) {
+  if (!selectLevel(state)) return;
+  const size_t size = static_cast<size_t>(state.range(1));
+  auto a = data(size, 1.0f), b = data(size, 0.5f);
+  for (auto _ : state) benchmark::DoNotOptimize(dotProduct(a.data(), b.data(), size));
+  setThroughput(state, size, 2);
+}
+
+static void BM_Sum(benchmark::State& state) {
+  if (!selectLevel(state)) return;
+  const size_t size = static_cast<size_t>(state.range(1));
+  auto a = data(size, 1.0f);
+  for (auto _ : state) benchmark::DoNotOptimize(vectorSum(a.data(), size));
+  setThroughput(state, size, 1);
+}
+
+static void BM_Max(benchmark::State& state) {
+  if (!selectLevel(state)) return;
+  const size_t size = static_cast<size_t>(state.range(1));
+  auto a = data(size, 1.0f);
+  for (auto _ : state) benchmark::DoNotOptimize(vectorMax(a.data(), size));
+  setThroughput(state, size, 1);
+}
+
+// Args: {SimdLevel, floats per array}
+#define LEVEL_SWEEP                                                                   \
+  ArgsProduct({{static_cast<int64_t>(SimdLevel::SCALAR),                              \
+                static_cast<int64_t>(SimdLevel::SSE2),                                \
+                static_cast<int64_t>(SimdLevel::AVX2),                                \
+                static_cast<int64_t>(SimdLevel::AVX512)},                             \
+               {2 << 10, 64 << 10, 2 << 20, 16 << 20}})                               \
+      ->ArgNames({"level", "floats"})
+
+BENCHMARK(BM_Add)->LEVEL_SWEEP;
+BENCHMARK(BM_Fma)->LEVEL_SWEEP;
+BENCHMARK(BM_Dot)->LEVEL_SWEEP;
+BENCHMARK(BM_Sum)->LEVEL_SWEEP;
+BENCHMARK(BM_Max)->LEVEL_SWEEP;
+
+// ------------------------------------------------------- Transcendentals
+
+constexpr size_t MATH_SIZE = 4096;
+
+using MathKernel = void (*)(const double*, double*, size_t);
+
+struct MathCase {
+  MathKernel kernel;
+  double (*libm)(double);
+  long double (*reference)(long double);
+  double lo, hi;
+};
+
+static double normalCdf(double x) { return 0.5 * std::erfc(-x * M_SQRT1_2); }
+static long double normalCdfReference(long double x) { return 0.5L * erfcl(-x / sqrtl(2.0L)); }
+
+// Input ranges typical of pricing: log-moneyness, discounting, d1/d2.
+static const MathCase EXP{vectorExp, [](double x) { return std::exp(x); },
+                          [](long double x) { return expl(x); }, -20.0, 20.0};
+static const MathCase LOG{vectorLog, [](double x) { return std::log(x); },
+                          [](long double x) { return logl(x); }, 0.01, 100.0};
+static const MathCase ERF{vectorErf, [](double x) { return std::erf(x); },
+                          [](long double x) { return erfl(x); }, -5.0, 5.0};
+static const MathCase NORMAL_CDF{vectorNormalCdf, normalCdf, normalCdfReference, -8.0, 8.0};
+
+static std::vector<double> mathInputs(const MathCase& c) {
+  std::vector<double> x(MATH_SIZE);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = c.lo + (c.hi - c.lo) * (static_cast<double>((i * 2654435761u) % MATH_SIZE) + 0.5) /
+                      static_cast<double>(MATH_SIZE);
+  }
+  return x;
+}
+
+static double maxUlp(const std::vector<double>& x, const std::vector<double>& y,
+                     const MathCase& c) {
+  double worst = 0.0;
+  for (size_t i = 0; i < x.size(); ++i) {
+    const long double expected = c.reference(x[i]);
+    const double rounded = static_cast<double>(expected);
+    const double ulp =
+        std::nextafter(std::fabs(rounded), std::numeric_limits<double>::infinity()) -
+        std::fabs(rounded);
+    worst = std::max(worst, static_cast<double>(std::fabs(y[i] - expected) / ulp));
+  }
+  return worst;
+}
+
+static void simdMath(benchmark::State& state, const MathCase& c) {
+  if (!selectLevel(state)) return;
+  const auto x = mathInputs(c);
+  std::vector<double> y(x.size());
+  for (auto _ : state) {
+    c.kernel(x.data(), y.data(), y.size());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(x.size()));
+  state.counters["max_ulp"] = maxUlp(x, y, c);
+}
+
+static void libmMath(benchmark::State& state, const MathCase& c) {
+  const auto x = mathInputs(c);
+  std::vector<double> y(x.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); ++i) y[i] = c.libm(x[i]);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(x.size()));
+  state.counters["max_ulp"] = maxUlp(x, y, c);
+}
+
+static void BM_Exp(benchmark::State& state) { simdMath(state, EXP); }
+static void BM_Log(benchmark::State& state) { simdMath(state, LOG); }
+static void BM_Erf(benchmark::State& state) { simdMath(state, ERF); }
+static void BM_NormalCdf(benchmark::State& state) { simdMath(state, NORMAL_CDF); }
+static void BM_LibmExp(benchmark::State& state) { libmMath(state, EXP); }
+static void BM_LibmLog(benchmark::State& state) { libmMath(state, LOG); }
+static void BM_LibmErf(benchmark::State& state) { libmMath(state, ERF); }
+static void BM_LibmNormalCdf(benchmark::State& state) { libmMath(state, NORMAL_CDF); }
+
+// Args: {SimdLevel}
+#define MATH_LEVELS                                                                   \
+  ArgsProduct({{static_cast<int64_t>(SimdLevel::SCALAR),                              \
+                static_cast<int64_t>(SimdLevel::SSE2),                                \
+                static_cast<int64_t>(SimdLevel::AVX2),                                \
+                static_cast<int64_t>(SimdLevel::AVX512)}})                            \
+      ->ArgNames({"level"})
+
+BENCHMARK(BM_Exp)->MATH_LEVELS;
+BENCHMARK(BM_LibmExp);
+BENCHMARK(BM_Log)->MATH_LEVELS;
+BENCHMARK(BM_LibmLog);
+BENCHMARK(BM_Erf)->MATH_LEVELS;
+BENCHMARK(BM_LibmErf);
+BENCHMARK(BM_NormalCdf)->MATH_LEVELS;
+BENCHMARK(BM_LibmNormalCdf);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,142 @@
+#include "skip_list.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+/**
+ * Ordered maps under a read-mostly mix. The map starts with KEYS keys out
+ * of a range of 2 * KEYS; each iteration picks a random key and does a
+ * find (90%), insert (5%) or erase (5%), so the size stays near KEYS.
+ * items_per_second counts operations summed over all threads.
+ * - SkipList: ConcurrentSkipList (lock-free, EBR, FramePool nodes)
+ * - SharedMutexMap: std::map behind a std::shared_mutex (readers share)
+ * The *Scan variants instead visit SCAN_LENGTH consecutive keys per
+ * iteration while one writer thread keeps inserting and erasing.
+ */
+
+constexpr int64_t KEYS = 1 << 16;
+constexpr int64_t SCAN_LENGTH = 64;
+
+class SharedMutexMap {
+ public:
+  bool insert(int64_t key, int64_t value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return items_.emplace(key, value).second;
+  }
+
+  bool erase(int64_t key) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return items_.erase(key) > 0;
+  }
+
+  bool find(int64_t key, int64_t& value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = items_.find(key);
+    if (it == items_.end()) return false;
+    value = it->second;
+    return true;
+  }
+
+  template <typename F>
+  void forEachInRange(int64_t lo, int64_t hi, F&& f) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (auto it = items_.lower_bound(lo); it != items_.end() && it->first < hi; ++it) {
+      f(it->first, it->second);
+    }
+  }
+
+ private:
+  mutable std::shared_mutex mutex_;
+  std::map<int64_t, int64_t> items_;
+};
+
+static uint64_t nextRandom(uint64_t& state) {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+template <typename Map>
+static Map* createMap() {
+  auto* map = new Map;
+  for (int64_t key = 0; key < 2 * KEYS; key += 2) map->insert(key, key);
+  return map;
+}
+
+// Takes the global by reference: thread 0 creates the map, and only the
+// framework's start barrier (entering the loop) orders that before use.
+template <typename Map>
+static void mixedOps(benchmark::State& state, Map* const& shared) {
+  uint64_t rng = 0x9E3779B97F4A7C15ULL + state.thread_index();
+  int64_t sum = 0;
+  int64_t value = 0;
+  for (auto _ : state) {
+    Map& map = *shared;
+    const uint64_t r = nextRandom(rng);
+    const int64_t key = static_cast<int64_t>((r >> 8) % (2 * KEYS));
+    const uint64_t op = r % 100;
+    if (op < 90) {
+      if (map.find(key, value)) sum += value;
+    } else if (op < 95) {
+      map.insert(key, key);
+    } else {
+      map.erase(key);
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Thread 0 writes; the others scan.
+template <typename Map>
+static void scans(benchmark::State& state, Map* const& shared) {
+  uint64_t rng = 0x9E3779B97F4A7C15ULL + state.thread_index();
+  int64_t sum = 0;
+  for (auto _ : state) {
+    Map& map = *shared;
+    const uint64_t r = nextRandom(rng);
+    const int64_t key = static_cast<int64_t>((r >> 8) % (2 * KEYS));
+    if (state.thread_index() == 0 && state.threads() > 1) {
+      if ((r & 1) != 0) {
+        map.insert(key, key);
+      } else {
+        map.erase(key);
+      }
+    } else {
+      map.forEachInRange(key, key + 2 * SCAN_LENGTH, [&](int64_t, int64_t v) { sum += v; });
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static ConcurrentSkipList<int64_t, int64_t>* skip_list = nullptr;
+static SharedMutexMap* locked_map = nullptr;
+
+template <typename Map>
+static void runShared(benchmark::State& state, Map*& shared,
+                      void (*body)(benchmark::State&, Map* const&)) {
+  if (state.thread_index() == 0) shared = createMap<Map>();
+  body(state, shared);
+  if (state.thread_index() == 0) {
+    delete shared;
+    shared = nullptr;
+  }
+}
+
+static void BM_SkipList(benchmark::State& state) { runShared(state, skip_list, mixedOps); }
+static void BM_SharedMutexMap(benchmark::State& state) { runShared(state, locked_map, mixedOps); }
+static void BM_SkipListScan(benchmark::State& state) { runShared(state, skip_list, scans); }
+static void BM_SharedMutexMapScan(benchmark::State& state) {
+  runShared(state, locked_map, scans);
+}
+
+BENCHMARK(BM_SkipList)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_SharedMutexMap)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_SkipListScan)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK(BM_SharedMutexMapScan)->ThreadRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
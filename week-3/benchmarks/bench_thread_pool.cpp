@@ -0,0 +1,169 @@
+#include "thread_pool.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing ThreadPool vs. a single mutex-protected queue.
+ * - External: many tiny tasks submitted from the benchmark thread
+ * - Recursive: fork-join binary splitting where tasks spawn tasks, the
+ *   case work stealing is designed for (contention on one queue vs. mostly
+ *   uncontended owner pushes/pops)
+ * - Futures: fan out tasks that return values and gather them, via
+ *   submit() + whenAll vs. hand-rolled std::promise plumbing through
+ *   enqueue() (a promise per task plus std::function's heap copy)
+ * Thread counts sweep 1..64; beyond hardware_concurrency() the numbers show
+ * oversubscription behaviour rather than scaling.
+ */
+
+// Baseline: one std::queue, one mutex, one condition variable.
+class SingleQueueThreadPool {
+ public:
+  explicit SingleQueueThreadPool(size_t num_threads) {
+    for (size_t i = 0; i < num_threads; ++i) threads_.emplace_back([this] { workerLoop(); });
+  }
+
+  ~SingleQueueThreadPool() {
+    wait();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) t.join();
+  }
+
+  void enqueue(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push(std::move(task));
+      ++pending_;
+    }
+    cv_.notify_one();
+  }
+
+  void wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+  }
+
+ private:
+  void workerLoop() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (stop_ && tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0) done_.notify_all();
+    }
+  }
+
+  std::vector<std::thread> threads_;
+  std::queue<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::condition_variable done_;
+  size_t pending_ = 0;
+  bool stop_ = false;
+};
+
+constexpr int EXTERNAL_TASKS = 1 << 14;
+constexpr int RECURSIVE_RANGE = 1 << 16;
+constexpr int RECURSIVE_GRAIN = 16;
+
+template <typename Pool>
+static void BM_ExternalTasks(benchmark::State& state) {
+  Pool pool(static_cast<size_t>(state.range(0)));
+  std::atomic<uint64_t> sink{0};
+  for (auto _ : state) {
+    for (int i = 0; i < EXTERNAL_TASKS; ++i) {
+      pool.enqueue([&sink, i] {
+        sink.fetch_add(static_cast<uint64_t>(i), std::memory_order_relaxed);
+      });
+    }
+    pool.wait();
+  }
+  benchmark::DoNotOptimize(sink.load());
+  state.SetItemsProcessed(state.iterations() * EXTERNAL_TASKS);
+}
+
+template <typename Pool>
+static void splitRange(Pool& pool, std::atomic<uint64_t>& sink, int lo, int hi) {
+  if (hi - lo <= RECURSIVE_GRAIN) {
+    uint64_t local = 0;
+    for (int i = lo; i < hi; ++i) local += static_cast<uint64_t>(i) * i;
+    sink.fetch_add(local, std::memory_order_relaxed);
+    return;
+  }
+  const int mid = lo + (hi - lo) / 2;
+  pool.enqueue([&pool, &sink, lo, mid] { splitRange(pool, sink, lo, mid); });
+  pool.enqueue([&pool, &sink, mid, hi] { splitRange(pool, sink, mid, hi); });
+}
+
+template <typename Pool>
+static void BM_RecursiveTasks(benchmark::State& state) {
+  Pool pool(static_cast<size_t>(state.range(0)));
+  std::atomic<uint64_t> sink{0};
+  for (auto _ : state) {
+    pool.enqueue([&] { splitRange(pool, sink, 0, RECURSIVE_RANGE); });
+    pool.wait();
+  }
+  benchmark::DoNotOptimize(sink.load());
+  // Leaves plus interior nodes of the split tree.
+  state.SetItemsProcessed(state.iterations() * (2 * RECURSIVE_RANGE / RECURSIVE_GRAIN - 1));
+}
+
+constexpr int FUTURE_TASKS = 1 << 12;
+
+static void BM_FuturesSubmitWhenAll(benchmark::State& state) {
+  ThreadPool pool(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<Future<int>> futures;
+    futures.reserve(FUTURE_TASKS);
+    for (int i = 0; i < FUTURE_TASKS; ++i) futures.push_back(pool.submit([i] { return i; }));
+    benchmark::DoNotOptimize(whenAll(std::move(futures)).get());
+  }
+  state.SetItemsProcessed(state.iterations() * FUTURE_TASKS);
+}
+
+static void BM_FuturesStdPromise(benchmark::State& state) {
+  SingleQueueThreadPool pool(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::vector<std::future<int>> futures;
+    futures.reserve(FUTURE_TASKS);
+    for (int i = 0; i < FUTURE_TASKS; ++i) {
+      auto promise = std::make_shared<std::promise<int>>();
+      futures.push_back(promise->get_future());
+      pool.enqueue([promise, i] { promise->set_value(i); });
+    }
+    std::vector<int> values;
+    values.reserve(FUTURE_TASKS);
+    for (auto& f : futures) values.push_back(f.get());
+    benchmark::DoNotOptimize(values);
+  }
+  state.SetItemsProcessed(state.iterations() * FUTURE_TASKS);
+}
+
+#define THREAD_SWEEP RangeMultiplier(2)->Range(1, 64)->UseRealTime()
+
+BENCHMARK_TEMPLATE(BM_ExternalTasks, ThreadPool)->THREAD_SWEEP;
+BENCHMARK_TEMPLATE(BM_ExternalTasks, SingleQueueThreadPool)->THREAD_SWEEP;
+BENCHMARK_TEMPLATE(BM_RecursiveTasks, ThreadPool)->THREAD_SWEEP;
+BENCHMARK_TEMPLATE(BM_RecursiveTasks, SingleQueueThreadPool)->THREAD_SWEEP;
+BENCHMARK(BM_FuturesSubmitWhenAll)->THREAD_SWEEP;
+BENCHMARK(BM_FuturesStdPromise)->THREAD_SWEEP;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "frame_pool.h"
+#include "thread_pool.h"
+
+/**
+ * Task<T>: lazily started C++20 coroutine integrated with ThreadPool
+ *
+ * - A Task does nothing until it is awaited (or handed to syncWait)
+ * - `co_await pool.schedule()` moves the coroutine onto a pool worker;
+ *   everything after it runs there
+ * - Awaiting a Task and returning from one both use symmetric transfer
+ *   (await_suspend returns the next handle), so chains of tasks that
+ *   complete synchronously run in constant stack space (guaranteed by
+ *   Clang; GCC only emits the tail call when optimizing)
+ * - Coroutine frames come from FramePool: thread-local free lists per
+ *   size class, so steady-state task creation does not touch malloc
+ * - Exceptions propagate to the awaiter (or out of syncWait)
+ * - Awaiting an empty Task (default-constructed or moved-from) throws
+ *   std::logic_error
+ * - syncWait(task) runs a task to completion from ordinary code; from a
+ *   pool worker it runs other queued tasks while waiting
+ */
+
+template <typename T = void>
+class Task;
+
+namespace coro_detail {
+
+struct PromiseBase {
+  static void* operator new(size_t size) { return FramePool::allocate(size); }
+  static void operator delete(void* p, size_t size) { FramePool::deallocate(p, size); }
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  // Hands control straight to whoever awaited us (or back to the resumer).
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+      std::coroutine_handle<> next = self.promise().continuation;
+      return next ? next : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+
+  FinalAwaiter final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() { error = std::current_exception(); }
+
+  std::coroutine_handle<> continuation;
+  std::exception_ptr error;
+};
+
+template <typename T>
+struct Promise : PromiseBase {
+  Task<T> get_return_object();
+
+  template <typename U>
+  void return_value(U&& v) {
+    value.emplace(std::forward<U>(v));
+  }
+
+  T take() {
+    if (error) std::rethrow_exception(error);
+    return std::move(*value);
+  }
+
+  std::optional<T> value;
+};
+
+template <>
+struct Promise<void> : PromiseBase {
+  Task<void> get_return_object();
+
+  void return_void() {}
+
+  void take() {
+    if (error) std::rethrow_exception(error);
+  }
+};
+
+}  // namespace coro_detail
+
+template <typename T>
+class Task {
+ public:
+  using promise_type = coro_detail::Promise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Task() = default;
+  explicit Task(Handle h) : handle_(h) {}
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() {
+    if (handle_) handle_.destroy();
+  }
+
+  bool valid() const { return static_cast<bool>(handle_); }
+
+  // Awaiting starts the task and suspends the caller until it finishes.
+  auto operator co_await() && {
+    if (!handle_) throw std::logic_error("co_await on an empty Task");
+    struct Awaiter {
+      bool await_ready() const noexcept { return handle.done(); }
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+        handle.promise().continuation = caller;
+        return handle;  // Symmetric transfer into the task.
+      }
+      T await_resume() { return handle.promise().take(); }
+
+      Handle handle;
+    };
+    return Awaiter{handle_};
+  }
+
+  auto operator co_await() & { return std::move(*this).operator co_await(); }
+
+ private:
+  Handle handle_;
+};
+
+namespace coro_detail {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() {
+  return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Promise<void>::get_return_object() {
+  return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+// Fire-and-forget driver used by syncWait: starts immediately, frees its
+// own frame when done.
+struct Detached {
+  struct promise_type {
+    static void* operator new(size_t size) { return FramePool::allocate(size); }
+    static void operator delete(void* p, size_t size) { FramePool::deallocate(p, size); }
+
+    Detached get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+template <typename T>
+struct SyncWaitState {
+  std::atomic<bool> done{false};
+  std::optional<std::conditional_t<std::is_void_v<T>, bool, T>> value;
+  std::exception_ptr error;
+};
+
+// The state is passed by shared_ptr (copied into the frame) so the waiter
+// may return as soon as `done` flips, while this frame is still unwinding.
+template <typename T>
+Detached runAndSignal(Task<T> task, std::shared_ptr<SyncWaitState<T>> state) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      co_await std::move(task);
+      state->value.emplace(true);
+    } else {
+      state->value.emplace(co_await std::move(task));
+    }
+  } catch (...) {
+    state->error = std::current_exception();
+  }
+  state->done.store(true, std::memory_order_release);
+  state->done.notify_all();
+}
+
+}  // namespace coro_detail
+
+/**
+ * syncWait(task[, pool])
+ * - Starts task on the calling thread and blocks until it completes
+ * - Pass the pool the task schedules onto when calling from one of its
+ *   workers: the worker then runs queued tasks instead of blocking
+ */
+template <typename T>
+T syncWait(Task<T> task, ThreadPool* pool = nullptr) {
+  auto state = std::make_shared<coro_detail::SyncWaitState<T>>();
+  coro_detail::runAndSignal(std::move(task), state);
+  const bool helping = pool != nullptr && pool->currentWorkerIndex() >= 0;
+  while (!state->done.load(std::memory_order_acquire)) {
+    if (!helping) {
+      state->done.wait(false, std::memory_order_acquire);
+    } else if (!pool->tryRunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+  if (state->error) std::rethrow_exception(state->error);
+  if constexpr (!std::is_void_v<T>) return std::move(*state->value);
+}
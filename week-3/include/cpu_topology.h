@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * CPU / NUMA topology from sysfs and worker placement policies
+ *
+ * - CpuTopology::detect() reads <root>/cpu/online,
+ *   <root>/cpu/cpuN/topology/{physical_package_id,core_id} and
+ *   <root>/node/nodeK/cpulist (root defaults to /sys/devices/system)
+ * - Missing files degrade gracefully: no node directory means one node,
+ *   no topology directory means every CPU is its own core; if nothing can
+ *   be read at all the result is a uniform topology of
+ *   hardware_concurrency() CPUs
+ * - Node numbers are dense indices (0..nodeCount()-1) in ascending sysfs
+ *   node order, so sparse node ids still index arrays directly
+ *
+ * Placement policies (planPlacement):
+ * - COMPACT: fill one node first; within it, hyperthread siblings of a
+ *   core are adjacent (shares caches, keeps memory on one node)
+ * - SCATTER: one thread per physical core before any siblings, round-robin
+ *   across nodes (maximizes memory bandwidth and cache capacity)
+ * - EXPLICIT: the caller's CPU list, in order
+ * - More workers than CPUs wrap around the plan
+ */
+
+enum class AffinityPolicy { NONE, COMPACT, SCATTER, EXPLICIT };
+
+struct LogicalCpu {
+  int id = 0;          // OS CPU number
+  int package_id = 0;  // Socket
+  int core_id = 0;     // Physical core within the package
+  int node = 0;        // Dense NUMA node index
+};
+
+class CpuTopology {
+ public:
+  static constexpr const char* DEFAULT_SYSFS_ROOT = "/sys/devices/system";
+
+  static CpuTopology detect(const std::string& sysfs_root = DEFAULT_SYSFS_ROOT);
+  static CpuTopology uniform(size_t cpu_count);
+
+  const std::vector<LogicalCpu>& cpus() const { return cpus_; }
+  size_t nodeCount() const { return node_count_; }
+
+  // Dense node of an OS CPU number, or -1 if the CPU is unknown.
+  int nodeOf(int cpu) const;
+
+  // True when the data came from sysfs rather than the uniform fallback.
+  bool fromSysfs() const { return from_sysfs_; }
+
+ private:
+  std::vector<LogicalCpu> cpus_;  // Sorted by id
+  size_t node_count_ = 1;
+  bool from_sysfs_ = false;
+};
+
+// Parses a sysfs CPU list such as "0-3,8,10-11". Returns false on
+// malformed input (out is left unspecified).
+bool parseCpuList(const std::string& text, std::vector<int>& out);
+
+// One OS CPU per worker, or an empty vector for NONE (or an empty
+// EXPLICIT list): workers are then left unpinned.
+std::vector<int> planPlacement(const CpuTopology& topology, AffinityPolicy policy,
+                               size_t workers, const std::vector<int>& explicit_cpus = {});
+
+// Pin a thread to one CPU. False if unsupported or refused.
+bool pinCurrentThreadToCpu(int cpu);
+bool pinThreadToCpu(std::thread& thread, int cpu);
+
+const char* affinityPolicyName(AffinityPolicy policy);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * DelayHistogram: concurrent log-linear histogram of nanosecond delays
+ *
+ * - record() is wait-free (relaxed atomic increments), so every worker can
+ *   record into the same histogram on its hot path
+ * - Values below 8 get exact buckets; above that each power of two is
+ *   split into 8 sub-buckets (relative error <= 12.5%)
+ * - percentile() returns the upper bound of the bucket holding the
+ *   requested rank, so reported tails never understate
+ * - Reads while writers are active are approximate (not a snapshot)
+ */
+
+class DelayHistogram {
+ public:
+  static constexpr int SUB_BUCKET_BITS = 3;
+  static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+  void record(uint64_t ns) {
+    buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+    uint64_t seen = max_.load(std::memory_order_relaxed);
+    while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() {
+    for (auto& b : buckets_) b.store(0, std::memory_order_relaxed);
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+  }
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  double mean() const {
+    const uint64_t n = count();
+    return n == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / n;
+  }
+
+  // p in [0, 100]. 0 when empty.
+  uint64_t percentile(double p) const {
+    const uint64_t n = count();
+    if (n == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(n) + 0.5);
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen >= rank) {
+        const uint64_t upper = bucketUpperBound(i);
+        return upper < max() ? upper : max();
+      }
+    }
+    return max();
+  }
+
+  static constexpr size_t bucketOf(uint64_t v) {
+    if (v < SUB_BUCKETS) return static_cast<size_t>(v);
+    const int exponent = 63 - __builtin_clzll(v);
+    const int shift = exponent - SUB_BUCKET_BITS;
+    const size_t sub = static_cast<size_t>((v >> shift) & (SUB_BUCKETS - 1));
+    return SUB_BUCKETS + static_cast<size_t>(shift) * SUB_BUCKETS + sub;
+  }
+
+  static constexpr uint64_t bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) return index;
+    const size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    const uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    const uint64_t lower = (SUB_BUCKETS + sub) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+  }
+
+ private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * Epoch-Based Reclamation (Fraser, 2004) and QSBR (McKenney & Slingwine)
+ *
+ * - An EpochDomain holds a global epoch and the records of its registered
+ *   threads; a thread registers by constructing an EpochParticipant and
+ *   keeps it for as long as it touches the protected structures
+ * - EBR: an EpochGuard marks a read-side critical section. Entering
+ *   publishes "active in epoch E", leaving clears it; nested guards are
+ *   free. Nothing on the read path allocates
+ * - QSBR: an online participant is always treated as reading and instead
+ *   calls quiescent() between operations, which only stores when the
+ *   epoch has moved; offline() before blocking
+ * - The epoch advances once every active or online participant has
+ *   announced the current one; memory retired in epoch e is freed once the
+ *   epoch reaches e + 2, so no reader can still hold it
+ * - retire() appends to one of three per-thread limbo lists (one per epoch
+ *   in flight); every COLLECT_INTERVAL retirements the participant tries
+ *   to advance the epoch and frees the lists that have become safe
+ * - Limbo lists of a participant that unregisters move to the domain and
+ *   are freed by a later collect (or when the domain is destroyed)
+ * - A stalled reader blocks reclamation for everyone (unlike hazard
+ *   pointers) but readers never loop or validate
+ * - On Linux the reader-side fence is replaced by membarrier(2): readers
+ *   only publish with a plain store, and tryAdvance() (already amortized)
+ *   forces a barrier on every running thread of the process before it
+ *   looks at their epochs. Without membarrier, or under TSan (which cannot
+ *   model it), readers use a seq_cst store instead
+ * - defaultEpochDomain()/localEpochParticipant() give lock-free structures
+ *   a shared domain and implicit per-thread registration
+ *
+ * Usage:
+ *   EpochDomain domain;
+ *   EpochParticipant self(domain);     // once per thread
+ *   { EpochGuard guard(self); Node* n = head.load(); ... }
+ *   self.retire(old);                  // after unlinking old
+ */
+
+class EpochDomain;
+
+class EpochParticipant {
+ public:
+  static constexpr size_t COLLECT_INTERVAL = 64;
+
+  explicit EpochParticipant(EpochDomain& domain);
+  ~EpochParticipant();
+
+  EpochParticipant(const EpochParticipant&) = delete;
+  EpochParticipant& operator=(const EpochParticipant&) = delete;
+
+  // EBR critical sections (see EpochGuard).
+  void enter() {
+    if (depth_++ == 0 && !online_) announce();
+  }
+  void leave() {
+    if (--depth_ == 0 && !online_) record_->state.store(0, std::memory_order_release);
+  }
+
+  // QSBR: while online the participant counts as reading everywhere
+  // except at quiescent() calls.
+  void online() {
+    online_ = true;
+    announce();
+  }
+  void offline() {
+    online_ = false;
+    if (depth_ == 0) record_->state.store(0, std::memory_order_release);
+  }
+  inline void quiescent();
+
+  // Frees p with deleter once no reader can still see it. p must already
+  // be unreachable for new readers.
+  void retire(void* p, void (*deleter)(void*));
+
+  template <typename T>
+  void retire(T* p) {
+    retire(static_cast<void*>(p), [](void* q) { delete static_cast<T*>(q); });
+  }
+
+  // Tries to advance the epoch and frees everything that is now safe;
+  // returns how many objects were freed.
+  size_t collect();
+
+  // Retired by this participant and not yet freed.
+  size_t pending() const;
+
+ private:
+  friend class EpochDomain;
+
+  struct Retired {
+    void* pointer;
+    void (*deleter)(void*);
+  };
+
+  struct Limbo {
+    uint64_t epoch = 0;
+    std::vector<Retired> items;
+  };
+
+  struct alignas(64) Record {
+    // (epoch << 1) | 1 while reading or online, 0 otherwise.
+    std::atomic<uint64_t> state{0};
+    std::atomic<bool> in_use{false};
+    Record* next = nullptr;  // Immutable once published
+  };
+
+  inline void announce();
+  inline void publish(uint64_t state);
+  size_t freeSafe(uint64_t epoch);
+
+  EpochDomain& domain_;
+  Record* record_;
+  int depth_ = 0;
+  bool online_ = false;
+  size_t since_collect_ = 0;
+  Limbo limbo_[3];
+};
+
+class EpochDomain {
+ public:
+  EpochDomain();
+  // All participants must be gone; frees everything still retired.
+  ~EpochDomain();
+
+  EpochDomain(const EpochDomain&) = delete;
+  EpochDomain& operator=(const EpochDomain&) = delete;
+
+  uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+  // Advances the epoch if every active participant has announced the
+  // current one. Returns the (possibly unchanged) epoch.
+  uint64_t tryAdvance();
+
+ private:
+  friend class EpochParticipant;
+  using Record = EpochParticipant::Record;
+  using Retired = EpochParticipant::Retired;
+
+  struct Orphan {
+    uint64_t epoch;
+    Retired item;
+  };
+
+  Record* acquireRecord();
+  void adoptOrphans(const EpochParticipant::Limbo* limbo, size_t count);
+  size_t freeOrphans(uint64_t epoch);
+
+  alignas(64) std::atomic<uint64_t> epoch_{2};
+  bool asymmetric_fence_ = false;  // Readers rely on membarrier in tryAdvance
+  std::atomic<Record*> records_{nullptr};
+  std::mutex orphan_mutex_;
+  std::vector<Orphan> orphans_;
+  std::atomic<bool> has_orphans_{false};
+};
+
+void EpochParticipant::publish(uint64_t state) {
+  // Either order the reads that follow after this store here, or let
+  // tryAdvance's membarrier do it for us.
+  if (domain_.asymmetric_fence_) {
+    record_->state.store(state, std::memory_order_relaxed);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } else {
+    record_->state.store(state, std::memory_order_seq_cst);
+  }
+}
+
+void EpochParticipant::announce() {
+  publish((domain_.epoch_.load(std::memory_order_relaxed) << 1) | 1);
+}
+
+void EpochParticipant::quiescent() {
+  if (!online_) return;
+  const uint64_t announced = (domain_.epoch_.load(std::memory_order_relaxed) << 1) | 1;
+  // Usually the epoch has not moved since the last call: nothing to do.
+  if (record_->state.load(std::memory_order_relaxed) != announced) publish(announced);
+}
+
+// Process-wide domain, and the calling thread's participant in it (created
+// on first use, unregistered at thread exit), for structures that do not
+// manage registration themselves.
+EpochDomain& defaultEpochDomain();
+EpochParticipant& localEpochParticipant();
+
+// RAII EBR read-side critical section.
+class EpochGuard {
+ public:
+  explicit EpochGuard(EpochParticipant& participant) : participant_(participant) {
+    participant_.enter();
+  }
+  ~EpochGuard() { participant_.leave(); }
+
+  EpochGuard(const EpochGuard&) = delete;
+  EpochGuard& operator=(const EpochGuard&) = delete;
+
+ private:
+  EpochParticipant& participant_;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+/**
+ * FramePool: size-class allocator for coroutine frames and lock-free nodes
+ * - Classes of 64, 128, ... MAX_POOLED_FRAME bytes; larger blocks use
+ *   ::operator new directly
+ * - Each thread keeps up to MAX_CACHED_FRAMES free blocks per class.
+ *   Blocks are often freed on a different thread than they were allocated
+ *   on; the cap keeps such one-way traffic from hoarding memory
+ * - Safe to call from other thread_local destructors: once the calling
+ *   thread's cache is gone, blocks go straight to ::operator new/delete
+ * - FramePoolAllocator<T> adapts it to the standard allocator interface,
+ *   e.g. for std::allocate_shared
+ */
+class FramePool {
+ public:
+  static constexpr size_t MIN_FRAME = 64;
+  static constexpr size_t MAX_POOLED_FRAME = 4096;
+  static constexpr size_t SIZE_CLASSES = 7;  // 64 .. 4096
+  static constexpr size_t MAX_CACHED_FRAMES = 256;
+
+  static void* allocate(size_t size) {
+    const size_t cls = sizeClass(size);
+    if (cls == SIZE_CLASSES) return ::operator new(size);
+    // Always the full class size: the block may be cached by another thread.
+    if (cache_gone) return ::operator new(classSize(cls));
+    FreeList& list = cache().lists[cls];
+    if (list.head != nullptr) {
+      Node* node = list.head;
+      list.head = node->next;
+      --list.count;
+      return node;
+    }
+    return ::operator new(classSize(cls));
+  }
+
+  static void deallocate(void* p, size_t size) {
+    const size_t cls = sizeClass(size);
+    if (cls == SIZE_CLASSES || cache_gone) {
+      ::operator delete(p);
+      return;
+    }
+    FreeList& list = cache().lists[cls];
+    if (list.count >= MAX_CACHED_FRAMES) {
+      ::operator delete(p);
+      return;
+    }
+    list.head = ::new (p) Node{list.head};
+    ++list.count;
+  }
+
+  static constexpr size_t sizeClass(size_t size) {
+    size_t cls = 0;
+    size_t cap = MIN_FRAME;
+    while (cap < size && cls < SIZE_CLASSES) {
+      cap <<= 1;
+      ++cls;
+    }
+    return cls;
+  }
+
+  static constexpr size_t classSize(size_t cls) { return MIN_FRAME << cls; }
+
+ private:
+  struct Node {
+    Node* next;
+  };
+
+  struct FreeList {
+    Node* head = nullptr;
+    size_t count = 0;
+  };
+
+  struct Cache {
+    FreeList lists[SIZE_CLASSES];
+
+    ~Cache() {
+      cache_gone = true;
+      for (FreeList& list : lists) {
+        while (list.head != nullptr) {
+          Node* next = list.head->next;
+          ::operator delete(list.head);
+          list.head = next;
+        }
+      }
+    }
+  };
+
+  // Trivially destructible, so still readable after Cache is destroyed.
+  static inline thread_local bool cache_gone = false;
+
+  static Cache& cache() {
+    thread_local Cache c;
+    return c;
+  }
+};
+
+template <typename T>
+struct FramePoolAllocator {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "FramePool blocks only have ::operator new's default alignment");
+  using value_type = T;
+
+  FramePoolAllocator() = default;
+  template <typename U>
+  FramePoolAllocator(const FramePoolAllocator<U>&) noexcept {}  // NOLINT: rebinding converts
+
+  T* allocate(size_t n) { return static_cast<T*>(FramePool::allocate(n * sizeof(T))); }
+  void deallocate(T* p, size_t n) noexcept { FramePool::deallocate(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const FramePoolAllocator<U>&) const noexcept {
+    return true;
+  }
+};
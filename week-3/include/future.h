@@ -0,0 +1,348 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "frame_pool.h"
+#include "inline_task.h"
+
+/**
+ * Lightweight futures for ThreadPool
+ *
+ * - ThreadPool::submit(f) returns a Future<R> sharing one state with the
+ *   task that produces it (no packaged_task / promise pair). States come
+ *   from FramePool, so a thread that keeps submitting reuses freed ones
+ * - The state is a single atomic status word: waiters block on it with
+ *   C++20 atomic wait, continuations are attached with one CAS
+ * - then(f) never blocks a worker: when the value arrives the continuation
+ *   is enqueued on the same pool (or immediately, if already ready)
+ * - Exceptions thrown by a task are captured and rethrown from get();
+ *   continuations and combinators forward them without running user code
+ * - Futures are move-only and single-consumer: get() and then() consume
+ * - whenAll / whenAny combine vectors of futures into one future; their
+ *   bookkeeping runs inline on the completing thread (no extra tasks), and
+ *   continuations on the combined future go back to the pool as usual
+ * - wait()/get() from inside a worker runs other queued tasks while
+ *   waiting, so a pool can never deadlock on its own futures
+ */
+
+class ThreadPool;
+
+template <typename T>
+class Future;
+
+namespace future_detail {
+
+struct Unit {};
+
+template <typename T>
+using Stored = std::conditional_t<std::is_void_v<T>, Unit, T>;
+
+// Defined in thread_pool.cpp; a null pool runs the task inline.
+void schedule(ThreadPool* pool, InlineTask&& task);
+// True when the calling thread is a worker of pool.
+bool onWorkerOf(ThreadPool* pool);
+// Runs one queued task if the caller is a worker of pool.
+bool tryRunPendingTask(ThreadPool* pool);
+
+constexpr uint32_t PENDING = 0;
+constexpr uint32_t HAS_CONTINUATION = 1;
+constexpr uint32_t READY = 2;
+
+template <typename T>
+struct SharedState {
+  explicit SharedState(ThreadPool* p) : pool(p) {}
+
+  void setValue(Stored<T>&& v) {
+    value.emplace(std::move(v));
+    complete();
+  }
+
+  void setError(std::exception_ptr e) {
+    error = std::move(e);
+    complete();
+  }
+
+  // Schedules task on the pool once the state is ready. With run_inline the
+  // task runs directly on whichever thread completes (or attaches to) the
+  // state instead; only for short bookkeeping that runs no user code.
+  void setContinuation(InlineTask&& task, bool run_inline = false) {
+    continuation = std::move(task);
+    continuation_inline = run_inline;
+    uint32_t expected = PENDING;
+    if (!status.compare_exchange_strong(expected, HAS_CONTINUATION, std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+      runContinuation();  // Already ready.
+    }
+  }
+
+  void wait() {
+    const bool helping = onWorkerOf(pool);
+    while (true) {
+      const uint32_t s = status.load(std::memory_order_acquire);
+      if (s == READY) return;
+      if (!helping) {
+        status.wait(s, std::memory_order_acquire);
+      } else if (!tryRunPendingTask(pool)) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  bool isReady() const { return status.load(std::memory_order_acquire) == READY; }
+
+  std::atomic<uint32_t> status{PENDING};
+  ThreadPool* pool;
+  std::optional<Stored<T>> value;
+  std::exception_ptr error;
+  InlineTask continuation;
+  bool continuation_inline = false;
+
+ private:
+  void complete() {
+    const uint32_t prev = status.exchange(READY, std::memory_order_acq_rel);
+    status.notify_all();
+    if (prev == HAS_CONTINUATION) runContinuation();
+  }
+
+  void runContinuation() {
+    if (continuation_inline) {
+      InlineTask task = std::move(continuation);
+      task();
+    } else {
+      schedule(pool, std::move(continuation));
+    }
+  }
+};
+
+// A new pending state, control block included, in one FramePool block.
+template <typename T>
+std::shared_ptr<SharedState<T>> makeState(ThreadPool* pool) {
+  return std::allocate_shared<SharedState<T>>(FramePoolAllocator<SharedState<T>>(), pool);
+}
+
+// Runs fn and stores its result (or exception) into state.
+template <typename T, typename Fn>
+void fulfill(SharedState<T>& state, Fn& fn) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      fn();
+      state.setValue(Unit{});
+    } else {
+      state.setValue(fn());
+    }
+  } catch (...) {
+    state.setError(std::current_exception());
+  }
+}
+
+// Lets the combinators below reach a Future's state.
+struct FutureAccess {
+  template <typename T>
+  static std::shared_ptr<SharedState<T>>& state(Future<T>& future) {
+    return future.state_;
+  }
+  template <typename T>
+  static Future<T> make(std::shared_ptr<SharedState<T>> state) {
+    return Future<T>(std::move(state));
+  }
+  template <typename T, typename Callback>
+  static void onComplete(Future<T>& future, Callback&& callback, bool run_inline) {
+    future.onComplete(std::forward<Callback>(callback), run_inline);
+  }
+};
+
+template <typename F, typename T>
+struct ThenResult {
+  using type = std::invoke_result_t<F, T>;
+};
+
+template <typename F>
+struct ThenResult<F, void> {
+  using type = std::invoke_result_t<F>;
+};
+
+}  // namespace future_detail
+
+template <typename T>
+class Future {
+ public:
+  using value_type = T;
+
+  Future() = default;
+  Future(Future&&) noexcept = default;
+  Future& operator=(Future&&) noexcept = default;
+  Future(const Future&) = delete;
+  Future& operator=(const Future&) = delete;
+
+  bool valid() const { return state_ != nullptr; }
+  bool isReady() const { return state_->isReady(); }
+
+  void wait() const { state_->wait(); }
+
+  // Waits, then returns the value or rethrows the task's exception.
+  T get() {
+    state_->wait();
+    auto state = std::move(state_);
+    if (state->error) std::rethrow_exception(state->error);
+    if constexpr (!std::is_void_v<T>) return std::move(*state->value);
+  }
+
+  // Runs f(value) on the pool once this future is ready and returns a
+  // future for its result. An exception skips f and propagates.
+  template <typename F>
+  auto then(F&& f) -> Future<typename future_detail::ThenResult<std::decay_t<F>, T>::type> {
+    using R = typename future_detail::ThenResult<std::decay_t<F>, T>::type;
+    auto next = future_detail::makeState<R>(state_->pool);
+    onComplete([next, fn = std::decay_t<F>(std::forward<F>(f))](
+                   future_detail::SharedState<T>& prev) mutable {
+      if (prev.error) {
+        next->setError(prev.error);
+        return;
+      }
+      auto call = [&]() -> R {
+        if constexpr (std::is_void_v<T>) {
+          return fn();
+        } else {
+          return fn(std::move(*prev.value));
+        }
+      };
+      future_detail::fulfill(*next, call);
+    });
+    return future_detail::FutureAccess::make(std::move(next));
+  }
+
+ private:
+  friend struct future_detail::FutureAccess;
+
+  explicit Future(std::shared_ptr<future_detail::SharedState<T>> state)
+      : state_(std::move(state)) {}
+
+  // Consumes the future; callback(state) runs on the pool when ready.
+  template <typename Callback>
+  void onComplete(Callback&& callback, bool run_inline = false) {
+    auto* raw = state_.get();
+    raw->setContinuation(
+        [state = std::move(state_), cb = std::forward<Callback>(callback)]() mutable {
+          cb(*state);
+        },
+        run_inline);
+  }
+
+  std::shared_ptr<future_detail::SharedState<T>> state_;
+};
+
+/**
+ * whenAll: ready when every input is ready
+ * - Future<std::vector<T>> with values in input order (Future<void> for T = void)
+ * - The first exception (in completion order) wins; values are dropped
+ * - An empty input yields a ready future
+ */
+template <typename T>
+Future<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> whenAll(
+    std::vector<Future<T>> futures) {
+  using Result = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+  using Stored = future_detail::Stored<T>;
+
+  using Access = future_detail::FutureAccess;
+
+  ThreadPool* pool = futures.empty() ? nullptr : Access::state(futures.front())->pool;
+  auto out = future_detail::makeState<Result>(pool);
+
+  struct Gather {
+    std::vector<std::optional<Stored>> values;
+    std::atomic<size_t> remaining;
+    std::atomic<bool> failed{false};
+    std::shared_ptr<future_detail::SharedState<Result>> out;
+
+    void finish() {
+      if constexpr (std::is_void_v<T>) {
+        out->setValue(future_detail::Unit{});
+      } else {
+        std::vector<T> result;
+        result.reserve(values.size());
+        for (auto& v : values) result.push_back(std::move(*v));
+        out->setValue(std::move(result));
+      }
+    }
+  };
+
+  if (futures.empty()) {
+    if constexpr (std::is_void_v<T>) {
+      out->setValue(future_detail::Unit{});
+    } else {
+      out->setValue(std::vector<T>{});
+    }
+    return Access::make(std::move(out));
+  }
+
+  auto gather = std::make_shared<Gather>();
+  gather->values.resize(futures.size());
+  gather->remaining.store(futures.size(), std::memory_order_relaxed);
+  gather->out = out;
+
+  for (size_t i = 0; i < futures.size(); ++i) {
+    Access::onComplete(futures[i], [gather, i](future_detail::SharedState<T>& state) {
+      if (state.error) {
+        if (!gather->failed.exchange(true)) gather->out->setError(state.error);
+      } else {
+        gather->values[i] = std::move(state.value);
+      }
+      if (gather->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 &&
+          !gather->failed.load(std::memory_order_acquire)) {
+        gather->finish();
+      }
+    }, /*run_inline=*/true);
+  }
+  return Access::make(std::move(out));
+}
+
+template <typename T>
+struct WhenAnyResult {
+  size_t index;
+  T value;
+};
+
+template <>
+struct WhenAnyResult<void> {
+  size_t index;
+};
+
+/**
+ * whenAny: ready when the first input is ready
+ * - Future<WhenAnyResult<T>>: index of the winner and its value
+ * - If the first input to finish threw, the result rethrows that exception
+ * - The other inputs still run; their results are discarded
+ * - An empty input yields an invalid (default) future
+ */
+template <typename T>
+auto whenAny(std::vector<Future<T>> futures) {
+  using Result = WhenAnyResult<T>;
+  using Access = future_detail::FutureAccess;
+  if (futures.empty()) return Future<Result>();
+
+  ThreadPool* pool = Access::state(futures.front())->pool;
+  auto out = future_detail::makeState<Result>(pool);
+  auto claimed = std::make_shared<std::atomic<bool>>(false);
+  for (size_t i = 0; i < futures.size(); ++i) {
+    Access::onComplete(futures[i], [out, claimed, i](future_detail::SharedState<T>& state) {
+      if (claimed->exchange(true)) return;
+      if (state.error) {
+        out->setError(state.error);
+      } else if constexpr (std::is_void_v<T>) {
+        out->setValue(Result{i});
+      } else {
+        out->setValue(Result{i, std::move(*state.value)});
+      }
+    }, /*run_inline=*/true);
+  }
+  return Access::make(std::move(out));
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Hazard Pointers (Michael, 2004): safe memory reclamation for lock-free
+ * structures
+ *
+ * - Before dereferencing a shared node, a thread publishes it in one of
+ *   its hazard slots (HazardPointer::protect); a node handed to
+ *   retireHazardous() is freed only once no slot holds it, which also
+ *   rules out ABA on that node's address
+ * - Each thread owns a record of SLOTS_PER_THREAD slots, taken from one
+ *   process-wide list on first use and reused after the thread exits
+ * - Retired nodes collect in a per-thread list; a scan runs when it
+ *   reaches max(SCAN_THRESHOLD, 2 x total slots), so reclamation costs
+ *   amortized O(1) per node and garbage per thread stays bounded
+ * - Nodes still protected when their thread exits are adopted by the
+ *   next scan on any thread
+ *
+ * Usage:
+ *   HazardPointer hp;
+ *   Node* n = hp.protect(head_);   // n stays allocated until hp resets
+ *   ...
+ *   retireHazardous(old);          // after unlinking old
+ */
+
+class HazardPointer {
+ public:
+  static constexpr size_t SLOTS_PER_THREAD = 4;
+  static constexpr size_t SCAN_THRESHOLD = 64;
+
+  // Claims a free slot of the calling thread. Throws std::runtime_error if
+  // all SLOTS_PER_THREAD are held by live HazardPointers.
+  HazardPointer();
+  ~HazardPointer();
+
+  HazardPointer(const HazardPointer&) = delete;
+  HazardPointer& operator=(const HazardPointer&) = delete;
+
+  // Loads source and publishes it until the published value is confirmed
+  // to still be current; the result is safe to dereference until the next
+  // protect/reset.
+  template <typename T>
+  T* protect(const std::atomic<T*>& source) {
+    T* p = source.load(std::memory_order_relaxed);
+    while (true) {
+      slot_->store(p, std::memory_order_seq_cst);
+      T* current = source.load(std::memory_order_seq_cst);
+      if (current == p) return p;
+      p = current;
+    }
+  }
+
+  void reset() { slot_->store(nullptr, std::memory_order_release); }
+
+ private:
+  std::atomic<const void*>* slot_;
+  size_t index_;
+};
+
+// Frees p with deleter once no hazard slot protects it.
+void retireHazardous(void* p, void (*deleter)(void*));
+
+template <typename T>
+void retireHazardous(T* p) {
+  retireHazardous(static_cast<void*>(p), [](void* q) { delete static_cast<T*>(q); });
+}
+
+// Frees everything the calling thread retired that is no longer
+// protected; returns how many nodes were freed.
+size_t scanHazards();
+
+// Nodes retired by the calling thread and not yet freed.
+size_t pendingHazardous();
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * InlineTask: move-only void() callable with small-buffer storage
+ *
+ * - Callables up to INLINE_SIZE bytes (and no stricter than max_align_t)
+ *   that are nothrow-movable live inside the object: no heap allocation
+ * - Larger callables fall back to a single heap allocation
+ * - Move-only, so it can hold move-only captures (promises, unique_ptr)
+ *   that std::function rejects
+ * - sizeof(InlineTask) == 64: one cache line per queued task
+ */
+
+class InlineTask {
+ public:
+  static constexpr size_t INLINE_SIZE = 64 - sizeof(void*);
+
+  InlineTask() = default;
+
+  template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask>>>
+  InlineTask(F&& f) {  // NOLINT(google-explicit-constructor): lambdas convert implicitly
+    using Fn = std::decay_t<F>;
+    if constexpr (fitsInline<Fn>()) {
+      ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+      vtable_ = &INLINE_VTABLE<Fn>;
+    } else {
+      ::new (static_cast<void*>(storage_)) Fn*(new Fn(std::forward<F>(f)));
+      vtable_ = &HEAP_VTABLE<Fn>;
+    }
+  }
+
+  InlineTask(InlineTask&& other) noexcept : vtable_(other.vtable_) {
+    if (vtable_ != nullptr) {
+      vtable_->relocate(storage_, other.storage_);
+      other.vtable_ = nullptr;
+    }
+  }
+
+  InlineTask& operator=(InlineTask&& other) noexcept {
+    if (this != &other) {
+      reset();
+      vtable_ = other.vtable_;
+      if (vtable_ != nullptr) {
+        vtable_->relocate(storage_, other.storage_);
+        other.vtable_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  InlineTask(const InlineTask&) = delete;
+  InlineTask& operator=(const InlineTask&) = delete;
+
+  ~InlineTask() { reset(); }
+
+  void operator()() { vtable_->invoke(storage_); }
+
+  explicit operator bool() const { return vtable_ != nullptr; }
+
+  // True when the callable is stored in the inline buffer.
+  bool isInline() const { return vtable_ != nullptr && vtable_->is_inline; }
+
+  template <typename F>
+  static constexpr bool fitsInline() {
+    return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<F>;
+  }
+
+ private:
+  struct VTable {
+    void (*invoke)(void* storage);
+    // Move-construct into dst and destroy the source.
+    void (*relocate)(void* dst, void* src);
+    void (*destroy)(void* storage);
+    bool is_inline;
+  };
+
+  template <typename Fn>
+  static constexpr VTable INLINE_VTABLE = {
+      [](void* s) { (*static_cast<Fn*>(s))(); },
+      [](void* dst, void* src) {
+        ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+        static_cast<Fn*>(src)->~Fn();
+      },
+      [](void* s) { static_cast<Fn*>(s)->~Fn(); },
+      true,
+  };
+
+  template <typename Fn>
+  static constexpr VTable HEAP_VTABLE = {
+      [](void* s) { (**static_cast<Fn**>(s))(); },
+      [](void* dst, void* src) { ::new (dst) Fn*(*static_cast<Fn**>(src)); },
+      [](void* s) { delete *static_cast<Fn**>(s); },
+      false,
+  };
+
+  void reset() {
+    if (vtable_ != nullptr) {
+      vtable_->destroy(storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[INLINE_SIZE];
+  const VTable* vtable_ = nullptr;
+};
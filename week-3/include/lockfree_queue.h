@@ -1,45 +1,202 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /**
- * TODO: Implement a Lock-Free Queue
- * 
+ * Bounded MPMC Lock-Free Queue (Vyukov)
+ *
+ * - Ring of cells, each with its own sequence number; capacity is rounded
+ *   up to a power of two so positions map to cells with a mask
+ * - A producer at position p may write cell p & mask once its sequence is
+ *   p, then publishes it as p + 1; a consumer at p waits for p + 1 and
+ *   frees the cell for the next lap as p + capacity
+ * - Producers only contend on enqueue_pos_, consumers on dequeue_pos_
+ *   (each on its own cache line); a full or empty queue fails fast
+ *   instead of blocking
+ * - Batch variants claim a run of ready cells with a single CAS. A claimed
+ *   cell must be published, so nothing that can throw runs between claim
+ *   and publish: when T's copy may throw, tryPushBatch copies the items
+ *   first and moves them into the cells
+ * - Not lock-free in the strict sense: a producer or consumer preempted
+ *   between claiming a cell and publishing it holds up that one cell
+ *
  * Requirements:
- * - Method: void push(T value)
- * - Method: bool pop(T& value)
- * - Thread-safe without locks
- * 
- * Implementation hints:
- * - Use std::atomic for lock-free operations
- * - Implement using linked list with atomic head/tail pointers
- * - Use compare_and_swap (CAS) operations
- * - Handle ABA problem if needed
- * 
- * Simplified approach:
- * - Start with a simple atomic counter-based circular buffer
- * - Use std::atomic<size_t> for head and tail indices
+ * - Constructor: LockFreeQueue(size_t capacity = 1024)
+ * - Method: bool tryPush(T value) - false when full
+ * - Method: bool tryPop(T& value) - false when empty
+ * - Method: size_t tryPushBatch(const T* items, size_t count)
+ * - Method: size_t tryPopBatch(T* out, size_t max)
+ * - Method: size_t size() const - approximate under concurrency
  */
 
 template <typename T>
 class LockFreeQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "LockFreeQueue needs nothrow-movable T (a claimed cell must be filled)");
+
  public:
-  // TODO: Implement constructor
-  // LockFreeQueue(size_t capacity = 1024);
-  
-  // TODO: Implement push
-  // void push(const T& value);
-  
-  // TODO: Implement pop
-  // bool pop(T& value);
-  
-  // TODO: Implement size
-  // size_t size() const;
-  
+  explicit LockFreeQueue(size_t capacity = 1024) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    mask_ = cap - 1;
+    cells_ = std::make_unique<Cell[]>(cap);
+    for (size_t i = 0; i < cap; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  ~LockFreeQueue() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      const size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+      for (size_t pos = dequeue_pos_.load(std::memory_order_relaxed); pos != tail; ++pos) {
+        slot(cells_[pos & mask_])->~T();
+      }
+    }
+  }
+
+  LockFreeQueue(const LockFreeQueue&) = delete;
+  LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+  bool tryPush(T value) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;  // Cell still holds last lap's item: full.
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    new (cell->storage) T(std::move(value));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPop(T& value) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;  // Not yet written: empty.
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    take(*cell, value, pos);
+    return true;
+  }
+
+  // Pushes a prefix of items[0..count); returns how many were pushed. If a
+  // copy throws, nothing is pushed.
+  size_t tryPushBatch(const T* items, size_t count) {
+    if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+      return pushRun(items, count);
+    } else {
+      std::vector<T> copies(items, items + std::min(count, capacity()));
+      return pushRun(copies.data(), copies.size());
+    }
+  }
+
+  // Pops up to max items into out; returns how many were popped.
+  size_t tryPopBatch(T* out, size_t max) {
+    if (max == 0) return 0;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    size_t claimed;
+    while (true) {
+      claimed = readyRun(pos, max, 1);
+      if (claimed == 0) {
+        const size_t seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) return 0;
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) break;
+    }
+    for (size_t i = 0; i < claimed; ++i) take(cells_[(pos + i) & mask_], out[i], pos + i);
+    return claimed;
+  }
+
+  size_t size() const {
+    const size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    const size_t head = dequeue_pos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+  size_t capacity() const { return mask_ + 1; }
+
  private:
-  // TODO: Add member variables:
-  // - T* buffer_;
-  // - size_t capacity_;
-  // - std::atomic<size_t> head_;
-  // - std::atomic<size_t> tail_;
+  static constexpr size_t CACHE_LINE = 64;
+
+  struct Cell {
+    std::atomic<size_t> sequence{0};
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  T* slot(Cell& cell) { return std::launder(reinterpret_cast<T*>(cell.storage)); }
+
+  void take(Cell& cell, T& value, size_t pos) {
+    T* item = slot(cell);
+    value = std::move(*item);
+    item->~T();
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  }
+
+  // Claims up to count free cells and constructs them from items: a copy
+  // from const T*, a (nothrow) move from T*.
+  template <typename Item>
+  size_t pushRun(Item* items, size_t count) {
+    if (count == 0) return 0;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    size_t claimed;
+    while (true) {
+      claimed = readyRun(pos, count, 0);
+      if (claimed == 0) {
+        const size_t seq = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) < 0) return 0;
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) break;
+    }
+    for (size_t i = 0; i < claimed; ++i) {
+      Cell& cell = cells_[(pos + i) & mask_];
+      new (cell.storage) T(std::move(items[i]));
+      cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return claimed;
+  }
+
+  // Length of the run of cells from pos whose sequence equals
+  // position + offset (0: free for a producer, 1: full for a consumer).
+  size_t readyRun(size_t pos, size_t limit, size_t offset) const {
+    size_t n = 0;
+    while (n < limit && n <= mask_ &&
+           cells_[(pos + n) & mask_].sequence.load(std::memory_order_acquire) ==
+               pos + n + offset) {
+      ++n;
+    }
+    return n;
+  }
+
+  alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos_{0};
+  alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos_{0};
+  alignas(CACHE_LINE) std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
 };
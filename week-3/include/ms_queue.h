@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "frame_pool.h"
+#include "hazard_pointer.h"
+
+/**
+ * Unbounded MPMC Lock-Free Queue (Michael & Scott, 1996)
+ *
+ * - Singly linked list with a dummy head node; push links at the tail with
+ *   a CAS on tail->next, pop swings head to head->next with a CAS
+ * - Threads that find tail lagging help swing it forward, so no thread
+ *   waits on a stalled one (lock-free, unlike the bounded LockFreeQueue)
+ * - Nodes are protected with hazard pointers (hazard_pointer.h) and
+ *   retired after unlinking, so no thread frees a node another one is
+ *   still reading, and a recycled address can never satisfy a stale CAS
+ *   (no ABA)
+ * - Nodes come from FramePool (frame_pool.h): steady push/pop traffic on a
+ *   thread reuses its own freed nodes instead of calling malloc
+ * - The value lives in the node that becomes the new dummy; only the pop
+ *   that won the CAS moves it out
+ *
+ * Requirements:
+ * - Method: void push(T value) - never fails
+ * - Method: bool tryPop(T& value) - false when empty
+ */
+
+template <typename T>
+class MichaelScottQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "MichaelScottQueue needs nothrow-movable T");
+
+ public:
+  MichaelScottQueue() {
+    Node* dummy = new Node;
+    head_.store(dummy, std::memory_order_relaxed);
+    tail_.store(dummy, std::memory_order_relaxed);
+  }
+
+  ~MichaelScottQueue() {
+    // Single-threaded by now: every node after the dummy holds a value.
+    Node* node = head_.load(std::memory_order_relaxed);
+    Node* next = node->next.load(std::memory_order_relaxed);
+    delete node;
+    for (node = next; node != nullptr; node = next) {
+      next = node->next.load(std::memory_order_relaxed);
+      node->value()->~T();
+      delete node;
+    }
+  }
+
+  MichaelScottQueue(const MichaelScottQueue&) = delete;
+  MichaelScottQueue& operator=(const MichaelScottQueue&) = delete;
+
+  void push(T value) {
+    Node* node = new Node;
+    new (node->storage) T(std::move(value));
+    HazardPointer hp;
+    while (true) {
+      Node* tail = hp.protect(tail_);
+      Node* next = tail->next.load(std::memory_order_acquire);
+      if (tail != tail_.load(std::memory_order_acquire)) continue;
+      if (next != nullptr) {
+        // Tail is lagging: help the other push finish.
+        tail_.compare_exchange_weak(tail, next, std::memory_order_release,
+                                    std::memory_order_relaxed);
+        continue;
+      }
+      Node* expected = nullptr;
+      if (tail->next.compare_exchange_weak(expected, node, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+        tail_.compare_exchange_strong(tail, node, std::memory_order_release,
+                                      std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  bool tryPop(T& value) {
+    HazardPointer hp_head;
+    HazardPointer hp_next;
+    while (true) {
+      Node* head = hp_head.protect(head_);
+      Node* next = hp_next.protect(head->next);
+      // head->next is only meaningful while head is still the head.
+      if (head != head_.load(std::memory_order_acquire)) continue;
+      if (next == nullptr) return false;
+      Node* tail = tail_.load(std::memory_order_acquire);
+      if (head == tail) {
+        tail_.compare_exchange_weak(tail, next, std::memory_order_release,
+                                    std::memory_order_relaxed);
+        continue;
+      }
+      if (head_.compare_exchange_weak(head, next, std::memory_order_acq_rel,
+                                      std::memory_order_relaxed)) {
+        T* slot = next->value();
+        value = std::move(*slot);
+        slot->~T();
+        hp_head.reset();
+        retireHazardous(head);
+        return true;
+      }
+    }
+  }
+
+  // Racy snapshot.
+  bool empty() const {
+    HazardPointer hp;
+    Node* head = hp.protect(head_);
+    return head->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+
+    static void* operator new(size_t size) { return FramePool::allocate(size); }
+    static void operator delete(void* p, size_t size) { FramePool::deallocate(p, size); }
+  };
+
+  static constexpr size_t CACHE_LINE = 64;
+
+  alignas(CACHE_LINE) std::atomic<Node*> head_;
+  alignas(CACHE_LINE) std::atomic<Node*> tail_;
+};
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "thread_pool.h"
+
+/**
+ * parallelFor / parallelReduce on ThreadPool
+ *
+ * Lazy binary splitting (Tzannes, Caragea, Barua & Vishkin, PPoPP 2010):
+ * - A task walks its range in chunks of `grain` iterations
+ * - Before each chunk it checks its worker's deque: if it is empty (no
+ *   work for thieves to take) and more than two grains remain, it splits
+ *   the rest in half and pushes the upper half as a new task
+ * - So splits only happen when they can be stolen: one thread never
+ *   splits past the first push, N busy threads split about N times, and
+ *   an idle thief finds the biggest remaining half at the top of a deque
+ *
+ * Grain size is tuned at run time, per call:
+ * - Starts at 1 and doubles while a chunk finishes in under half of
+ *   TARGET_CHUNK_NS, halves when a chunk takes more than twice that
+ * - Shared across the call's tasks so new halves start from the tuned
+ *   value instead of relearning it
+ *
+ * Bodies must not throw. The calling thread blocks until the loop is done;
+ * if it is a worker of the same pool it runs queued tasks meanwhile, so
+ * nested parallel loops are fine.
+ */
+
+namespace parallel_detail {
+
+// Aim for chunks long enough to amortize the split check and clock reads,
+// short enough that a thief rarely waits on a half-done chunk.
+constexpr int64_t TARGET_CHUNK_NS = 20000;
+constexpr size_t MAX_GRAIN = size_t{1} << 20;
+
+inline int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Outstanding tasks of one parallel call plus the shared grain estimate.
+struct LoopControl {
+  std::atomic<size_t> pending{1};
+  std::atomic<size_t> grain{1};
+
+  void finishOne() {
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) pending.notify_all();
+  }
+
+  void waitAll(ThreadPool& pool) {
+    const bool helping = pool.currentWorkerIndex() >= 0;
+    while (true) {
+      const size_t p = pending.load(std::memory_order_acquire);
+      if (p == 0) return;
+      if (!helping) {
+        pending.wait(p, std::memory_order_acquire);
+      } else if (!pool.tryRunPendingTask()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+inline size_t tuneGrain(size_t grain, int64_t elapsed_ns, size_t chunk) {
+  if (chunk < grain) return grain;  // Tail chunk: says nothing about the grain.
+  if (elapsed_ns < TARGET_CHUNK_NS / 2 && grain < MAX_GRAIN) return grain * 2;
+  if (elapsed_ns > TARGET_CHUNK_NS * 2 && grain > 1) return grain / 2;
+  return grain;
+}
+
+// Runs shared->chunk(state, lo, hi) over [lo, hi) with lazy binary
+// splitting. state is per task (e.g. a reduction accumulator): created by
+// makeState() and handed to finish() after the task's last chunk.
+template <typename Shared>
+void runSplit(ThreadPool& pool, const std::shared_ptr<Shared>& shared, size_t lo, size_t hi) {
+  auto state = shared->makeState();
+  size_t grain = shared->control.grain.load(std::memory_order_relaxed);
+  while (lo < hi) {
+    if (hi - lo > 2 * grain && pool.localQueueSize() == 0) {
+      const size_t mid = lo + (hi - lo) / 2;
+      shared->control.pending.fetch_add(1, std::memory_order_relaxed);
+      pool.enqueue([&pool, shared, mid, hi] {
+        runSplit(pool, shared, mid, hi);
+        shared->control.finishOne();
+      });
+      hi = mid;
+      continue;
+    }
+    const size_t chunk_end = std::min(hi, lo + grain);
+    const int64_t start = nowNs();
+    shared->chunk(state, lo, chunk_end);
+    const size_t tuned = tuneGrain(grain, nowNs() - start, chunk_end - lo);
+    if (tuned != grain) {
+      grain = tuned;
+      shared->control.grain.store(grain, std::memory_order_relaxed);
+    }
+    lo = chunk_end;
+  }
+  shared->finish(state);
+}
+
+// Runs the root task on the pool (or inline, from one of its workers) and
+// waits for every split to finish.
+template <typename Shared>
+void runLoop(ThreadPool& pool, const std::shared_ptr<Shared>& shared, size_t begin, size_t end) {
+  if (pool.currentWorkerIndex() >= 0) {
+    runSplit(pool, shared, begin, end);
+    shared->control.finishOne();
+  } else {
+    pool.enqueue([&pool, shared, begin, end] {
+      runSplit(pool, shared, begin, end);
+      shared->control.finishOne();
+    });
+  }
+  shared->control.waitAll(pool);
+}
+
+template <typename Body>
+struct ForShared {
+  struct Empty {};
+
+  explicit ForShared(Body& b) : body(b) {}
+
+  Empty makeState() const { return {}; }
+
+  void chunk(Empty&, size_t lo, size_t hi) {
+    if constexpr (std::is_invocable_v<Body&, size_t, size_t>) {
+      body(lo, hi);
+    } else {
+      for (size_t i = lo; i < hi; ++i) body(i);
+    }
+  }
+
+  void finish(Empty&) {}
+
+  LoopControl control;
+  Body& body;
+};
+
+template <typename T, typename Map, typename Combine>
+struct ReduceShared {
+  ReduceShared(T id, Map& m, Combine& c)
+      : identity(std::move(id)), result(identity), map(m), combine(c) {}
+
+  T makeState() const { return identity; }
+
+  void chunk(T& acc, size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) acc = combine(std::move(acc), map(i));
+  }
+
+  // One partial per task; there are only as many tasks as splits.
+  void finish(T& acc) {
+    std::lock_guard<std::mutex> lock(mutex);
+    result = combine(std::move(result), std::move(acc));
+  }
+
+  LoopControl control;
+  const T identity;
+  T result;
+  std::mutex mutex;
+  Map& map;
+  Combine& combine;
+};
+
+}  // namespace parallel_detail
+
+/**
+ * parallelFor(pool, begin, end, body)
+ * - body(i) for every i in [begin, end), or body(lo, hi) for each chunk
+ *   when body is callable that way (lets the inner loop vectorize)
+ * - Iterations run in unspecified order on unspecified threads
+ */
+template <typename Body>
+void parallelFor(ThreadPool& pool, size_t begin, size_t end, Body&& body) {
+  if (begin >= end) return;
+  using Shared = parallel_detail::ForShared<std::remove_reference_t<Body>>;
+  auto shared = std::make_shared<Shared>(body);
+  parallel_detail::runLoop(pool, shared, begin, end);
+}
+
+/**
+ * parallelReduce(pool, begin, end, identity, map, combine)
+ * - Folds combine(acc, map(i)) over [begin, end) and returns the result
+ * - combine must be associative and commutative, identity its neutral
+ *   element: how the range is split (and so the grouping) varies per run
+ */
+template <typename T, typename Map, typename Combine>
+T parallelReduce(ThreadPool& pool, size_t begin, size_t end, T identity, Map&& map,
+                 Combine&& combine) {
+  if (begin >= end) return identity;
+  using Shared = parallel_detail::ReduceShared<T, std::remove_reference_t<Map>,
+                                               std::remove_reference_t<Combine>>;
+  auto shared = std::make_shared<Shared>(std::move(identity), map, combine);
+  parallel_detail::runLoop(pool, shared, begin, end);
+  return std::move(shared->result);
+}
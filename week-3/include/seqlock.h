@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+/**
+ * Sequence Locks for Single-Writer / Multi-Reader Snapshots
+ *
+ * - SeqLock<T>: the writer makes the sequence odd, copies the value in and
+ *   makes it even again; a reader copies the value out and retries if the
+ *   sequence was odd or changed meanwhile. Readers never write shared
+ *   memory, so they neither block the writer nor bounce its cache line
+ * - VersionedDoubleBuffer<T>: two SeqLock-style slots and a version. The
+ *   writer fills the slot readers are not directed to and then publishes
+ *   the new version, so a reader only retries if the writer completes two
+ *   stores during its copy. Use it for larger T, where a copy takes long
+ *   enough for a plain SeqLock reader to keep losing against the writer
+ * - T must be trivially copyable. The value lives in relaxed atomic words
+ *   (Boehm, "Can seqlocks get along with programming language memory
+ *   models?"), so a torn read is never a data race and is always discarded
+ * - One writer at a time: concurrent store() calls need external locking
+ * - load() spins (pause, then yield) while the writer is mid-copy;
+ *   tryLoad() makes a single attempt and never waits
+ *
+ * Usage:
+ *   SeqLock<Quote> quote;
+ *   quote.store(q);              // writer thread
+ *   Quote snapshot = quote.load();  // any reader
+ */
+
+namespace seqlock_detail {
+
+// A trivially copyable T spread over relaxed 64-bit atomics.
+template <typename T>
+class Words {
+ public:
+  static_assert(std::is_trivially_copyable_v<T>, "seqlock values must be trivially copyable");
+
+  void write(const T& value) {
+    const auto* src = reinterpret_cast<const unsigned char*>(&value);
+    for (size_t i = 0; i < FULL; ++i) {
+      uint64_t word;
+      std::memcpy(&word, src + i * sizeof(uint64_t), sizeof(uint64_t));
+      words_[i].store(word, std::memory_order_relaxed);
+    }
+    if constexpr (TAIL != 0) {
+      uint64_t word = 0;
+      std::memcpy(&word, src + FULL * sizeof(uint64_t), TAIL);
+      words_[FULL].store(word, std::memory_order_relaxed);
+    }
+  }
+
+  void read(T& value) const {
+    auto* dst = reinterpret_cast<unsigned char*>(&value);
+    for (size_t i = 0; i < FULL; ++i) {
+      const uint64_t word = words_[i].load(std::memory_order_relaxed);
+      std::memcpy(dst + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+    }
+    if constexpr (TAIL != 0) {
+      const uint64_t word = words_[FULL].load(std::memory_order_relaxed);
+      std::memcpy(dst + FULL * sizeof(uint64_t), &word, TAIL);
+    }
+  }
+
+ private:
+  static constexpr size_t FULL = sizeof(T) / sizeof(uint64_t);
+  static constexpr size_t TAIL = sizeof(T) % sizeof(uint64_t);
+
+  std::atomic<uint64_t> words_[FULL + (TAIL != 0)] = {};
+};
+
+// Odd while the writer is copying.
+inline void beginWrite(std::atomic<uint64_t>& seq) {
+  const uint64_t s = seq.load(std::memory_order_relaxed);
+  seq.store(s + 1, std::memory_order_relaxed);
+  // Keeps the data stores below after the odd sequence.
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+inline void endWrite(std::atomic<uint64_t>& seq) {
+  seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// One read attempt: true if value holds a consistent copy taken while the
+// sequence stayed at expected (which must be even).
+template <typename T>
+bool tryReadAt(const std::atomic<uint64_t>& seq, uint64_t expected, const Words<T>& words,
+               T& value) {
+  if (seq.load(std::memory_order_acquire) != expected) return false;
+  words.read(value);
+  // Keeps the data loads above before the second sequence check.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return seq.load(std::memory_order_relaxed) == expected;
+}
+
+// One read attempt: true if value holds a consistent copy.
+template <typename T>
+bool tryRead(const std::atomic<uint64_t>& seq, const Words<T>& words, T& value) {
+  const uint64_t before = seq.load(std::memory_order_acquire);
+  if ((before & 1) != 0) return false;
+  return tryReadAt(seq, before, words, value);
+}
+
+inline void backoff(int attempt) {
+  if (attempt % 64 == 63) {
+    std::this_thread::yield();  // The writer may have been preempted mid-copy
+  } else {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+}
+
+}  // namespace seqlock_detail
+
+template <typename T>
+class SeqLock {
+ public:
+  SeqLock() : SeqLock(T{}) {}
+  explicit SeqLock(const T& initial) { words_.write(initial); }
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  // Single writer.
+  void store(const T& value) {
+    seqlock_detail::beginWrite(seq_);
+    words_.write(value);
+    seqlock_detail::endWrite(seq_);
+  }
+
+  bool tryLoad(T& value) const { return seqlock_detail::tryRead(seq_, words_, value); }
+
+  T load() const {
+    T value;
+    for (int attempt = 0; !tryLoad(value); ++attempt) seqlock_detail::backoff(attempt);
+    return value;
+  }
+
+  // Number of completed stores.
+  uint64_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  alignas(64) std::atomic<uint64_t> seq_{0};
+  seqlock_detail::Words<T> words_;
+};
+
+template <typename T>
+class VersionedDoubleBuffer {
+ public:
+  VersionedDoubleBuffer() : VersionedDoubleBuffer(T{}) {}
+  explicit VersionedDoubleBuffer(const T& initial) { slots_[0].words.write(initial); }
+
+  VersionedDoubleBuffer(const VersionedDoubleBuffer&) = delete;
+  VersionedDoubleBuffer& operator=(const VersionedDoubleBuffer&) = delete;
+
+  // Single writer.
+  void store(const T& value) {
+    const uint64_t next = version_.load(std::memory_order_relaxed) + 1;
+    Slot& slot = slots_[next & 1];
+    seqlock_detail::beginWrite(slot.seq);
+    slot.words.write(value);
+    seqlock_detail::endWrite(slot.seq);
+    version_.store(next, std::memory_order_release);
+  }
+
+  // On success also reports which version was read.
+  bool tryLoad(T& value, uint64_t* version = nullptr) const {
+    const uint64_t current = version_.load(std::memory_order_acquire);
+    const Slot& slot = slots_[current & 1];
+    // Slot current & 1 has been written once per version of that parity, so
+    // it holds version current exactly while its sequence is slotSeq(current).
+    // A refill with a newer version changes the sequence and fails the read.
+    if (!seqlock_detail::tryReadAt(slot.seq, slotSeq(current), slot.words, value)) return false;
+    if (version != nullptr) *version = current;
+    return true;
+  }
+
+  T load(uint64_t* version = nullptr) const {
+    T value;
+    for (int attempt = 0; !tryLoad(value, version); ++attempt) seqlock_detail::backoff(attempt);
+    return value;
+  }
+
+  // Number of completed stores.
+  uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+ private:
+  // Completed writes to slot v & 1 up to and including version v, times two.
+  static uint64_t slotSeq(uint64_t v) { return (v + 1) & ~uint64_t{1}; }
+
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> seq{0};
+    seqlock_detail::Words<T> words;
+  };
+
+  alignas(64) std::atomic<uint64_t> version_{0};
+  Slot slots_[2];
+};
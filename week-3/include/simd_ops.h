@@ -3,19 +3,70 @@
 #include <cstddef>
 
 /**
- * TODO: Implement SIMD Operations
- * 
- * Requirements:
- * - Vector addition using SIMD
- * - Vector multiplication using SIMD
- * - Compare performance with scalar operations
- * 
- * Implementation hints:
- * - Use compiler intrinsics or auto-vectorization
- * - Start with simple array operations
- * - Use -O3 -march=native for optimization
+ * SIMD Float Kernels with Runtime Dispatch
+ *
+ * - Every kernel has scalar, SSE2, AVX2 (+FMA) and AVX-512F versions; the
+ *   widest one the CPU and OS support is picked on first use from CPUID
+ *   (and XGETBV, so AVX state the OS does not save is never used). The
+ *   wide versions are compiled with target attributes, so the library
+ *   itself needs no -march flag and still runs on plain x86-64
+ * - Any pointer alignment works. Element-wise kernels peel a head so the
+ *   main loop stores to aligned addresses (inputs use unaligned loads;
+ *   they cost the same when the data happens to be aligned)
+ * - Tails (and heads) use masked loads/stores on AVX2 and AVX-512, so no
+ *   kernel reads or writes past the end; SSE2 finishes them with scalar code
+ * - Reductions keep several independent accumulators to hide add latency,
+ *   so sum/dot results may differ from the scalar loop in the last bits
+ *   (different association order); min/max are exact and skip NaNs at
+ *   every level
+ * - Outputs may alias inputs exactly (result == a), not partially
+ * - setSimdLevel() forces a narrower level (tests, benchmarks); it refuses
+ *   levels the CPU lacks
+ *
+ * Transcendentals (double, src/simd_math.cpp): exp, log, erf and the
+ * standard normal CDF over arrays, 2 / 4 / 8 lanes per step on SSE2 /
+ * AVX2 / AVX-512. Max error against a long double reference, checked in
+ * test_day5 at every level:
+ * - vectorExp: 1.3 ulp; +inf above 709.78, 0 below -745.13, subnormal
+ *   results rounded correctly
+ * - vectorLog: 1 ulp; NaN for x < 0, -inf at 0, subnormal inputs handled
+ * - vectorErf: 2 ulp
+ * - vectorNormalCdf: 6 ulp relative, including the lower tail down to
+ *   x = -37.5 (below that results are subnormal, then 0)
+ * NaN propagates; results can differ between levels in the last bit
+ * because wider levels fuse multiply-adds.
  */
 
-// TODO: Implement SIMD operations
+enum class SimdLevel { SCALAR, SSE2, AVX2, AVX512 };
+
+const char* simdLevelName(SimdLevel level);
+
+// Widest level this CPU and OS support.
+SimdLevel detectSimdLevel();
+
+// Level the kernels below currently dispatch to.
+SimdLevel activeSimdLevel();
+
+// False (and no change) if the CPU does not support level.
+bool setSimdLevel(SimdLevel level);
+
+// result[i] = a[i] + b[i]
 void vectorAdd(const float* a, const float* b, float* result, size_t size);
+// result[i] = a[i] * b[i]
 void vectorMultiply(const float* a, const float* b, float* result, size_t size);
+// result[i] = a[i] * b[i] + c[i] (fused on AVX2/AVX-512, one rounding)
+void vectorFma(const float* a, const float* b, const float* c, float* result, size_t size);
+
+float dotProduct(const float* a, const float* b, size_t size);
+float vectorSum(const float* a, size_t size);
+// NaN elements are ignored; +infinity / -infinity for an empty (or all-NaN)
+// range.
+float vectorMin(const float* a, size_t size);
+float vectorMax(const float* a, size_t size);
+
+// result[i] = f(x[i]); result may alias x.
+void vectorExp(const double* x, double* result, size_t size);
+void vectorLog(const double* x, double* result, size_t size);
+void vectorErf(const double* x, double* result, size_t size);
+// Standard normal CDF: 0.5 * erfc(-x / sqrt(2)).
+void vectorNormalCdf(const double* x, double* result, size_t size);
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+
+#include "epoch.h"
+#include "frame_pool.h"
+
+/**
+ * Lock-Free Concurrent Skip List (ordered map)
+ *
+ * - Herlihy & Shavit's lock-free skip list: a node is inserted by CAS at
+ *   level 0 (the linearization point), then linked into its upper levels
+ * - Deletion is logical first: the low bit of each of the node's next
+ *   pointers is set (top level down); whoever marks level 0 owns the
+ *   removal. Marked nodes are snipped out by any later traversal
+ * - Nodes are reclaimed with epoch-based reclamation (epoch.h, default
+ *   domain): every operation runs inside an EpochGuard, so a traversal
+ *   never touches freed memory. A node is retired by whichever finishes
+ *   last of its inserter (linking) and its remover (unlinking), so a late
+ *   upper-level link cannot make a retired node reachable again
+ * - Towers: heights are geometric with p = 1/4 (1.33 links per node on
+ *   average) and each node is allocated at its exact size from FramePool,
+ *   so an 8-byte key and value with a short tower fit in one 64-byte line
+ * - Keys are unique; a value never changes after insertion (erase and
+ *   re-insert to replace it)
+ * - forEachInRange() is weakly consistent: keys come in ascending order,
+ *   every key present for the whole scan is visited, and keys inserted or
+ *   erased during the scan may or may not be
+ *
+ * Requirements:
+ * - Method: bool insert(const K& key, const V& value) - false if present
+ * - Method: bool erase(const K& key)
+ * - Method: bool find(const K& key, V& value) const
+ * - Method: void forEachInRange(lo, hi, f) - f(key, value) for lo <= key < hi
+ */
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class ConcurrentSkipList {
+ public:
+  static constexpr int MAX_HEIGHT = 16;  // 4^16 keys before towers saturate
+
+  explicit ConcurrentSkipList(Compare less = Compare()) : less_(std::move(less)) {
+    head_ = Node::create(MAX_HEIGHT);
+  }
+
+  // No other thread may be using the list.
+  ~ConcurrentSkipList() {
+    Node* node = pointer(head_->next(0).load(std::memory_order_relaxed));
+    while (node != nullptr) {
+      Node* next = pointer(node->next(0).load(std::memory_order_relaxed));
+      Node::destroy(node);
+      node = next;
+    }
+    Node::release(head_);
+  }
+
+  ConcurrentSkipList(const ConcurrentSkipList&) = delete;
+  ConcurrentSkipList& operator=(const ConcurrentSkipList&) = delete;
+
+  bool insert(const K& key, const V& value) {
+    EpochGuard guard(localEpochParticipant());
+    const int height = randomHeight();
+    Node* preds[MAX_HEIGHT];
+    Node* succs[MAX_HEIGHT];
+    Node* node = nullptr;
+    while (true) {
+      if (search(key, preds, succs)) {
+        if (node != nullptr) Node::destroy(node);  // Never published
+        return false;
+      }
+      if (node == nullptr) node = Node::create(height, key, value);
+      for (int level = 0; level < height; ++level) {
+        node->next(level).store(bits(succs[level]), std::memory_order_relaxed);
+      }
+      uintptr_t expected = bits(succs[0]);
+      if (preds[0]->next(0).compare_exchange_strong(expected, bits(node),
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    size_.fetch_add(1, std::memory_order_relaxed);
+    linkUpperLevels(node, key, height, preds, succs);
+    return true;
+  }
+
+  bool erase(const K& key) {
+    EpochGuard guard(localEpochParticipant());
+    Node* preds[MAX_HEIGHT];
+    Node* succs[MAX_HEIGHT];
+    if (!search(key, preds, succs)) return false;
+    Node* node = succs[0];
+    for (int level = node->height - 1; level > 0; --level) mark(node, level);
+    // Level 0 decides which remover wins.
+    uintptr_t next = node->next(0).load(std::memory_order_acquire);
+    while (true) {
+      if (isMarked(next)) return false;
+      if (node->next(0).compare_exchange_weak(next, next | MARK, std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+        break;
+      }
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    search(key, preds, succs);  // Physically unlinks every level
+    finish(node, UNLINKED);
+    return true;
+  }
+
+  bool find(const K& key, V& value) const {
+    EpochGuard guard(localEpochParticipant());
+    const Node* node = lowerBound(key);
+    if (node == nullptr || less_(key, node->key())) return false;
+    value = node->value();
+    return true;
+  }
+
+  bool contains(const K& key) const {
+    EpochGuard guard(localEpochParticipant());
+    const Node* node = lowerBound(key);
+    return node != nullptr && !less_(key, node->key());
+  }
+
+  // f(const K&, const V&) for every key in [lo, hi), ascending.
+  template <typename F>
+  void forEachInRange(const K& lo, const K& hi, F&& f) const {
+    EpochGuard guard(localEpochParticipant());
+    for (const Node* node = lowerBound(lo); node != nullptr && less_(node->key(), hi);) {
+      const uintptr_t next = node->next(0).load(std::memory_order_acquire);
+      if (!isMarked(next)) f(node->key(), node->value());
+      node = pointer(next);
+    }
+  }
+
+  // Racy snapshot.
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+ private:
+  static constexpr uintptr_t MARK = 1;
+  static constexpr uint8_t LINKED = 1;    // Inserter finished with the node
+  static constexpr uint8_t UNLINKED = 2;  // Remover finished with the node
+
+  using Link = std::atomic<uintptr_t>;
+
+  // Header, then `height` links, then (except for the head) key and value
+  // in one block sized to its FramePool class.
+  struct Node {
+    std::atomic<uint8_t> done{0};
+    int height;
+
+    Link& next(int level) { return reinterpret_cast<Link*>(this + 1)[level]; }
+    const Link& next(int level) const { return reinterpret_cast<const Link*>(this + 1)[level]; }
+
+    static size_t entryOffset(int height) {
+      const size_t links = sizeof(Node) + static_cast<size_t>(height) * sizeof(Link);
+      const size_t align = alignof(std::pair<K, V>);
+      return (links + align - 1) / align * align;
+    }
+    static size_t allocSize(int height) { return entryOffset(height) + sizeof(std::pair<K, V>); }
+
+    std::pair<K, V>* entry() const {
+      auto* base = reinterpret_cast<unsigned char*>(const_cast<Node*>(this));
+      return std::launder(reinterpret_cast<std::pair<K, V>*>(base + entryOffset(height)));
+    }
+    const K& key() const { return entry()->first; }
+    const V& value() const { return entry()->second; }
+
+    static Node* create(int height) {
+      void* memory = FramePool::allocate(allocSize(height));
+      Node* node = ::new (memory) Node;
+      node->height = height;
+      for (int level = 0; level < height; ++level) ::new (&node->next(level)) Link(0);
+      return node;
+    }
+    static Node* create(int height, const K& key, const V& value) {
+      Node* node = create(height);
+      auto* base = reinterpret_cast<unsigned char*>(node);
+      ::new (base + entryOffset(height)) std::pair<K, V>(key, value);
+      return node;
+    }
+    static void destroy(Node* node) {
+      node->entry()->~pair();
+      release(node);
+    }
+    static void release(Node* node) {
+      const int height = node->height;
+      node->~Node();
+      FramePool::deallocate(node, allocSize(height));
+    }
+    static void retired(void* p) { destroy(static_cast<Node*>(p)); }
+  };
+
+  static bool isMarked(uintptr_t link) { return (link & MARK) != 0; }
+  static Node* pointer(uintptr_t link) { return reinterpret_cast<Node*>(link & ~MARK); }
+  static uintptr_t bits(Node* node) { return reinterpret_cast<uintptr_t>(node); }
+
+  static int randomHeight() {
+    thread_local uint64_t state = 0x9E3779B97F4A7C15ULL ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    // Two zero bits per extra level: P(height > h) = 4^-h.
+    const int zeros = __builtin_ctzll(state | (uint64_t{1} << 62));
+    const int height = 1 + zeros / 2;
+    return height < MAX_HEIGHT ? height : MAX_HEIGHT;
+  }
+
+  bool equal(const K& a, const K& b) const { return !less_(a, b) && !less_(b, a); }
+
+  // Fills preds/succs around key on every level, snipping marked nodes on
+  // the way. True if an unmarked node with key is in the list.
+  bool search(const K& key, Node** preds, Node** succs) const {
+  retry:
+    Node* pred = head_;
+    for (int level = MAX_HEIGHT - 1; level >= 0; --level) {
+      Node* curr = pointer(pred->next(level).load(std::memory_order_acquire));
+      while (curr != nullptr) {
+        uintptr_t succ = curr->next(level).load(std::memory_order_acquire);
+        while (isMarked(succ)) {
+          uintptr_t expected = bits(curr);
+          if (!pred->next(level).compare_exchange_strong(expected, succ & ~MARK,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_relaxed)) {
+            goto retry;  // pred changed or was marked itself
+          }
+          curr = pointer(succ);
+          if (curr == nullptr) break;
+          succ = curr->next(level).load(std::memory_order_acquire);
+        }
+        if (curr == nullptr || !less_(curr->key(), key)) break;
+        pred = curr;
+        curr = pointer(succ);
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+    return succs[0] != nullptr && equal(succs[0]->key(), key);
+  }
+
+  // First unmarked node with key >= `key`, without snipping (read-only).
+  const Node* lowerBound(const K& key) const {
+    const Node* pred = head_;
+    const Node* curr = nullptr;
+    for (int level = MAX_HEIGHT - 1; level >= 0; --level) {
+      curr = pointer(pred->next(level).load(std::memory_order_acquire));
+      while (curr != nullptr) {
+        const uintptr_t succ = curr->next(level).load(std::memory_order_acquire);
+        if (isMarked(succ)) {
+          curr = pointer(succ);  // Skip deleted nodes
+        } else if (less_(curr->key(), key)) {
+          pred = curr;
+          curr = pointer(succ);
+        } else {
+          break;
+        }
+      }
+    }
+    return curr;
+  }
+
+  void mark(Node* node, int level) {
+    uintptr_t next = node->next(level).load(std::memory_order_acquire);
+    while (!isMarked(next) &&
+           !node->next(level).compare_exchange_weak(next, next | MARK, std::memory_order_acq_rel,
+                                                    std::memory_order_acquire)) {
+    }
+  }
+
+  void linkUpperLevels(Node* node, const K& key, int height, Node** preds, Node** succs) {
+    for (int level = 1; level < height; ++level) {
+      while (true) {
+        // Point the new node at the current successor, unless a remover has
+        // already marked this level: then stop linking.
+        uintptr_t next = node->next(level).load(std::memory_order_acquire);
+        if (isMarked(next)) goto linked;
+        if (next != bits(succs[level]) &&
+            !node->next(level).compare_exchange_strong(next, bits(succs[level]),
+                                                       std::memory_order_release,
+                                                       std::memory_order_acquire)) {
+          continue;  // Marked meanwhile
+        }
+        uintptr_t expected = bits(succs[level]);
+        if (preds[level]->next(level).compare_exchange_strong(expected, bits(node),
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed)) {
+          break;
+        }
+        search(key, preds, succs);
+        if (succs[0] != node) goto linked;  // Already erased (and unlinked at level 0)
+      }
+    }
+  linked:
+    // A remover may have unlinked before some of our links landed.
+    if (isMarked(node->next(0).load(std::memory_order_acquire))) search(key, preds, succs);
+    finish(node, LINKED);
+  }
+
+  // The second of inserter and remover to finish retires the node.
+  void finish(Node* node, uint8_t role) {
+    if ((node->done.fetch_or(role, std::memory_order_acq_rel) | role) == (LINKED | UNLINKED)) {
+      localEpochParticipant().retire(node, &Node::retired);
+    }
+  }
+
+  Node* head_;
+  Compare less_;
+  alignas(64) std::atomic<size_t> size_{0};
+};
@@ -1,47 +1,291 @@
 #pragma once
 
-#include <vector>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <string>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
-#include <functional>
+#include <vector>
+
+#include "cpu_topology.h"
+#include "delay_histogram.h"
+#include "future.h"
+#include "inline_task.h"
+#include "work_stealing_deque.h"
 
 /**
- * TODO: Implement a Thread Pool
+ * Work-Stealing Thread Pool
  * 
  * Requirements:
  * - Constructor: ThreadPool(size_t num_threads)
- * - Method: void enqueue(std::function<void()> task)
+ * - Method: void enqueue(Task task)
+ * - Method: Future<R> submit(F&& f) - see future.h for then/whenAll/whenAny
+ * - Method: co_await schedule() - resume a coroutine on a worker (coro_task.h)
  * - Method: void wait() - wait for all tasks to complete
  * - Destructor: Join all threads
  * 
- * Implementation hints:
- * - Use std::vector<std::thread> for worker threads
- * - Use std::queue<std::function<void()>> for task queue
- * - Use std::mutex and std::condition_variable for synchronization
- * - Each worker thread should loop, waiting for tasks
+ * Scheduling:
+ * - Every worker owns a Chase-Lev deque (see work_stealing_deque.h)
+ * - enqueue() from a worker thread pushes onto that worker's deque; from
+ *   any other thread it goes to a shared injection queue
+ * - A worker runs its own tasks LIFO (cache-hot), then drains the
+ *   injection queue, then steals FIFO from victims chosen at random
+ * - Idle workers spin briefly ("searching"), then sleep on a condition
+ *   variable; enqueue() only wakes a sleeper when no worker is searching,
+ *   and a searcher that finds work wakes the next one if more is queued
+ * - wait() called from a worker runs queued tasks until none are left
+ *   instead of blocking (tasks already running elsewhere may still be busy)
+ * - Tasks are InlineTask (small-buffer, move-only): a typical lambda is
+ *   stored in the task itself. Deques and queues hold pointers to 64-byte
+ *   task nodes, and nodes (like submit()'s future states) come from
+ *   FramePool, so tasks spawned by workers reuse nodes their thread freed
+ *   instead of calling malloc. Tasks enqueued from outside the pool still
+ *   allocate: their nodes are freed into the workers' caches
+ *
+ * Placement (ThreadPoolOptions, see cpu_topology.h):
+ * - Workers can be pinned COMPACT, SCATTER or to an EXPLICIT CPU list;
+ *   each pinned worker knows its NUMA node
+ * - enqueue(task, node) puts the task on that node's queue, which only
+ *   that node's workers drain (falls back to the shared queue when the
+ *   node has no pinned workers)
+ * - Thieves try victims on their own node before remote ones
+ * - localScratch() hands a worker memory it allocated and touched itself
+ *   after pinning, so first-touch places the pages on its node
+ *
+ * Priority lanes:
+ * - enqueue(task, priority[, deadline]) puts the task on the HIGH, NORMAL
+ *   or LOW lane; plain enqueue() keeps the work-stealing fast path
+ * - Workers take HIGH first, then their own deque and node queue, then
+ *   NORMAL, the injection queue, stealing, and LOW last
+ * - Lanes are FIFO, or earliest-deadline-first with deadline_ordering
+ *   (tasks without a deadline are due at enqueue time)
+ * - Starvation protection: a worker runs at most HIGH_STREAK_LIMIT HIGH
+ *   tasks in a row before looking elsewhere, and a NORMAL or LOW lane that
+ *   has waited max_lane_wait since it was last served jumps the order
+ * - reserved_high_workers workers run only HIGH tasks (and tasks those
+ *   spawn), so a burst of bulk work cannot occupy every thread
+ * - laneDelay() reports each lane's enqueue-to-start delay histogram
  */
 
+enum class TaskPriority { HIGH, NORMAL, LOW };
+
+constexpr size_t PRIORITY_LANES = 3;
+
+const char* taskPriorityName(TaskPriority priority);
+
+struct ThreadPoolOptions {
+  size_t num_threads = std::thread::hardware_concurrency();
+  AffinityPolicy affinity = AffinityPolicy::NONE;
+  std::vector<int> cpus;       // For AffinityPolicy::EXPLICIT
+  size_t scratch_bytes = 0;    // Per-worker scratch preallocated at start
+  std::string sysfs_root = CpuTopology::DEFAULT_SYSFS_ROOT;
+  // Workers that only serve the HIGH lane; at least one worker stays general.
+  size_t reserved_high_workers = 0;
+  bool deadline_ordering = false;  // EDF within each lane instead of FIFO
+  std::chrono::microseconds max_lane_wait{10000};
+};
+
 class ThreadPool {
  public:
-  // TODO: Implement constructor
-  // ThreadPool(size_t num_threads);
-  
-  // TODO: Implement destructor
-  // ~ThreadPool();
-  
-  // TODO: Implement enqueue method
-  // void enqueue(std::function<void()> task);
-  
-  // TODO: Implement wait method
-  // void wait();
-  
+  using Task = InlineTask;
+  using Clock = std::chrono::steady_clock;
+
+  explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency());
+  explicit ThreadPool(const ThreadPoolOptions& options);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void enqueue(Task task);
+
+  // Runs task on a worker of NUMA node `node` (dense index, see
+  // CpuTopology). Unknown nodes or nodes without pinned workers fall back
+  // to enqueue(task).
+  void enqueue(Task task, int node);
+
+  // Queues task on a priority lane. The deadline only affects ordering
+  // when the pool was built with deadline_ordering.
+  void enqueue(Task task, TaskPriority priority);
+  void enqueue(Task task, TaskPriority priority, Clock::time_point deadline);
+
+  // Runs f() on the pool; the future carries its result or exception.
+  template <typename F>
+  Future<std::invoke_result_t<std::decay_t<F>>> submit(F&& f);
+  template <typename F>
+  Future<std::invoke_result_t<std::decay_t<F>>> submit(F&& f, TaskPriority priority);
+
+  // `co_await pool.schedule()` suspends the coroutine and resumes it on a
+  // worker (the caller's own deque if it already is one).
+  struct ScheduleAwaiter {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const {
+      pool->enqueue([handle] { handle.resume(); });
+    }
+    void await_resume() const noexcept {}
+
+    ThreadPool* pool;
+  };
+
+  ScheduleAwaiter schedule() { return ScheduleAwaiter{this}; }
+
+  void wait();
+
+  // From a worker of this pool: runs one queued task, false if none was
+  // found. From any other thread: does nothing and returns false.
+  bool tryRunPendingTask();
+
+  size_t size() const { return workers_.size(); }
+
+  // Index of the calling worker in this pool, or -1 for other threads.
+  int currentWorkerIndex() const;
+
+  // Tasks waiting in the calling worker's own deque (0 for other threads).
+  // Racy snapshot; used by parallelFor to decide when to split.
+  size_t localQueueSize() const;
+
+  // Placement of worker i: OS CPU and dense NUMA node, -1 when unpinned.
+  int workerCpu(size_t i) const { return workers_[i]->cpu; }
+  int workerNode(size_t i) const { return workers_[i]->node; }
+  size_t nodeCount() const { return node_queues_.size(); }
+  const CpuTopology& topology() const { return topology_; }
+
+  // From a worker: at least `bytes` of page-aligned, zeroed memory owned
+  // by that worker, allocated and first touched on its own thread; valid
+  // until the next larger request. nullptr from other threads.
+  void* localScratch(size_t bytes);
+
+  size_t reservedWorkers() const { return reserved_workers_; }
+
+  // Queueing delay (enqueue to start, ns) of tasks taken from a lane.
+  const DelayHistogram& laneDelay(TaskPriority priority) const {
+    return lanes_[static_cast<size_t>(priority)].delay;
+  }
+  void resetLaneStats();
+
  private:
-  // TODO: Add member variables:
-  // - std::vector<std::thread> workers_;
-  // - std::queue<std::function<void()>> tasks_;
-  // - std::mutex queue_mutex_;
-  // - std::condition_variable condition_;
-  // - bool stop_;
+  struct AlignedFree {
+    void operator()(void* p) const;
+  };
+
+  struct alignas(64) Worker {
+    WorkStealingDeque<Task*> deque;
+    uint64_t rng_state = 0;
+    int cpu = -1;
+    int node = -1;
+    std::vector<size_t> near_victims;  // Same node first...
+    std::vector<size_t> far_victims;   // ...then everyone else
+    std::unique_ptr<void, AlignedFree> scratch;
+    size_t scratch_size = 0;
+    bool reserved = false;  // Serves only the HIGH lane
+    int high_streak = 0;    // HIGH tasks taken in a row
+  };
+
+  struct alignas(64) NodeQueue {
+    std::mutex mutex;
+    std::queue<Task*> tasks;
+    std::atomic<size_t> queued{0};
+    size_t workers = 0;  // Pinned workers on this node
+  };
+
+  struct alignas(64) Lane {
+    struct Entry {
+      int64_t key;  // Deadline (ns) under EDF, 0 for FIFO
+      uint64_t seq;
+      int64_t enqueued_ns;
+      Task* task;
+    };
+    struct Later {
+      bool operator()(const Entry& a, const Entry& b) const {
+        return a.key != b.key ? a.key > b.key : a.seq > b.seq;
+      }
+    };
+
+    std::mutex mutex;
+    std::priority_queue<Entry, std::vector<Entry>, Later> tasks;
+    uint64_t next_seq = 0;
+    std::atomic<size_t> queued{0};
+    std::atomic<int64_t> last_served_ns{0};
+    DelayHistogram delay;
+  };
+
+  void start(const ThreadPoolOptions& options);
+  void workerLoop(size_t index, size_t scratch_bytes);
+  void reservedLoop(size_t index);
+  Task* findTask(size_t index);
+  Task* popInjected();
+  Task* popNode(int node);
+  void pushLane(Task task, TaskPriority priority, int64_t deadline_ns, bool has_deadline);
+  Task* popLane(TaskPriority priority);
+  Task* popStarvedLane();
+  size_t laneBacklog() const;
+  size_t nodeBacklog() const;
+  Task* stealFrom(size_t index, const std::vector<size_t>& victims);
+  Task* stealFromOthers(size_t index);
+  bool hasWorkFor(size_t index) const;
+  void runTask(Task* task);
+  static Task* newTask(Task&& task);
+  static void deleteTask(Task* task);
+  void notifyWorkers();
+
+  CpuTopology topology_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::vector<std::unique_ptr<NodeQueue>> node_queues_;
+
+  std::mutex inject_mutex_;
+  std::queue<Task*> injected_;
+
+  std::array<Lane, PRIORITY_LANES> lanes_;
+  size_t reserved_workers_ = 0;
+  bool deadline_ordering_ = false;
+  int64_t max_lane_wait_ns_ = 0;
+
+  // Tasks pushed but not yet taken by a worker; drives sleeping/waking.
+  std::atomic<size_t> queued_{0};
+  // Tasks enqueued but not yet finished; drives wait().
+  std::atomic<size_t> pending_{0};
+  // Workers awake but without a task; enqueue() skips the wake if any.
+  std::atomic<size_t> searching_{0};
+  std::atomic<size_t> sleepers_{0};
+  std::atomic<bool> stop_{false};
+
+  // Workers wait here until the constructor has placed all of them.
+  std::latch placed_{1};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable reserved_wake_;  // Reserved workers sleep here
+  std::mutex done_mutex_;
+  std::condition_variable done_;
 };
+
+template <typename F>
+Future<std::invoke_result_t<std::decay_t<F>>> ThreadPool::submit(F&& f) {
+  using R = std::invoke_result_t<std::decay_t<F>>;
+  auto state = future_detail::makeState<R>(this);
+  enqueue([state, fn = std::decay_t<F>(std::forward<F>(f))]() mutable {
+    future_detail::fulfill(*state, fn);
+  });
+  return future_detail::FutureAccess::make(std::move(state));
+}
+
+template <typename F>
+Future<std::invoke_result_t<std::decay_t<F>>> ThreadPool::submit(F&& f, TaskPriority priority) {
+  using R = std::invoke_result_t<std::decay_t<F>>;
+  auto state = future_detail::makeState<R>(this);
+  enqueue(
+      [state, fn = std::decay_t<F>(std::forward<F>(f))]() mutable {
+        future_detail::fulfill(*state, fn);
+      },
+      priority);
+  return future_detail::FutureAccess::make(std::move(state));
+}
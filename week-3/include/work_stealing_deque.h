@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Chase-Lev Work-Stealing Deque
+ *
+ * - One owner thread pushes and pops at the bottom (LIFO: hot in cache)
+ * - Any number of thieves steal from the top (FIFO: oldest, usually the
+ *   biggest chunk of remaining work)
+ * - Lock-free; the owner's push/pop only touch shared state when the deque
+ *   is nearly empty
+ * - Grows by doubling; old buffers are kept until the deque is destroyed
+ *   because a thief may still be reading from them
+ *
+ * Memory orderings follow Le, Pop, Cohen & Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+ *
+ * T must be trivially copyable (typically a pointer): a thief reads a slot
+ * before it knows whether its steal will win.
+ */
+
+template <typename T>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque stores trivially copyable T");
+
+ public:
+  explicit WorkStealingDeque(size_t capacity = 1024) : top_(0), bottom_(0) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+    auto initial = std::make_unique<Buffer>(cap);
+    buffer_.store(initial.get(), std::memory_order_relaxed);
+    buffers_.push_back(std::move(initial));
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Owner only.
+  void push(T item) {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_acquire);
+    Buffer* buf = buffer_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(buf->capacity) - 1) buf = grow(buf, t, b);
+    buf->put(b, item);
+    // The paper's release fence + relaxed store, folded into one release
+    // store (same code on x86, and visible to ThreadSanitizer).
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  // Owner only. Most recently pushed item, or nullopt when empty.
+  std::optional<T> pop() {
+    const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer* buf = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+
+    if (t > b) {  // Empty.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    T item = buf->get(b);
+    if (t == b) {  // Last item: race thieves for it.
+      const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                    std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      if (!won) return std::nullopt;
+    }
+    return item;
+  }
+
+  // Any thread. Oldest item, or nullopt when empty or a race was lost.
+  std::optional<T> steal() {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) return std::nullopt;
+
+    Buffer* buf = buffer_.load(std::memory_order_acquire);
+    T item = buf->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+    return item;
+  }
+
+  // Snapshot; may be stale by the time it returns.
+  size_t size() const {
+    const int64_t b = bottom_.load(std::memory_order_relaxed);
+    const int64_t t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+ private:
+  struct Buffer {
+    explicit Buffer(size_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+    T get(int64_t i) const {
+      return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+    }
+    void put(int64_t i, T item) {
+      slots[static_cast<size_t>(i) & mask].store(item, std::memory_order_relaxed);
+    }
+
+    const size_t capacity;
+    const size_t mask;
+    std::unique_ptr<std::atomic<T>[]> slots;
+  };
+
+  Buffer* grow(Buffer* old, int64_t t, int64_t b) {
+    auto bigger = std::make_unique<Buffer>(old->capacity * 2);
+    for (int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+    Buffer* raw = bigger.get();
+    buffers_.push_back(std::move(bigger));
+    buffer_.store(raw, std::memory_order_release);
+    return raw;
+  }
+
+  alignas(64) std::atomic<int64_t> top_;
+  alignas(64) std::atomic<int64_t> bottom_;
+  alignas(64) std::atomic<Buffer*> buffer_;
+  std::vector<std::unique_ptr<Buffer>> buffers_;  // Owner only; retired + current.
+};
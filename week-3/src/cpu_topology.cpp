@@ -0,0 +1,231 @@
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+bool readFile(const std::string& path, std::string& out) {
+  std::ifstream in(path);
+  if (!in) return false;
+  std::stringstream ss;
+  ss << in.rdbuf();
+  out = ss.str();
+  while (!out.empty() && std::isspace(static_cast<unsigned char>(out.back()))) out.pop_back();
+  return true;
+}
+
+bool readInt(const std::string& path, int& out) {
+  std::string text;
+  if (!readFile(path, text) || text.empty()) return false;
+  char* end = nullptr;
+  const long value = std::strtol(text.c_str(), &end, 10);
+  if (end == text.c_str() || *end != '\0') return false;
+  out = static_cast<int>(value);
+  return true;
+}
+
+// Numeric suffixes of "<prefix>N" entries in dir, ascending.
+std::vector<int> listNumbered(const std::string& dir, const std::string& prefix) {
+  std::vector<int> ids;
+#if defined(__linux__)
+  DIR* d = opendir(dir.c_str());
+  if (d == nullptr) return ids;
+  while (dirent* entry = readdir(d)) {
+    const std::string name = entry->d_name;
+    if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+    const std::string digits = name.substr(prefix.size());
+    if (!std::all_of(digits.begin(), digits.end(), [](char c) { return std::isdigit(c); })) {
+      continue;
+    }
+    ids.push_back(std::stoi(digits));
+  }
+  closedir(d);
+  std::sort(ids.begin(), ids.end());
+#else
+  (void)dir;
+  (void)prefix;
+#endif
+  return ids;
+}
+
+}  // namespace
+
+bool parseCpuList(const std::string& text, std::vector<int>& out) {
+  out.clear();
+  std::stringstream ss(text);
+  std::string part;
+  while (std::getline(ss, part, ',')) {
+    if (part.empty()) continue;
+    const size_t dash = part.find('-');
+    char* end = nullptr;
+    const long first = std::strtol(part.c_str(), &end, 10);
+    if (end == part.c_str() || first < 0) return false;
+    long last = first;
+    if (dash != std::string::npos) {
+      const char* rest = part.c_str() + dash + 1;
+      last = std::strtol(rest, &end, 10);
+      if (end == rest || last < first) return false;
+    }
+    if (*end != '\0') return false;
+    for (long cpu = first; cpu <= last; ++cpu) out.push_back(static_cast<int>(cpu));
+  }
+  return !out.empty();
+}
+
+CpuTopology CpuTopology::uniform(size_t cpu_count) {
+  CpuTopology topology;
+  if (cpu_count == 0) cpu_count = 1;
+  for (size_t i = 0; i < cpu_count; ++i) {
+    LogicalCpu cpu;
+    cpu.id = static_cast<int>(i);
+    cpu.core_id = static_cast<int>(i);
+    topology.cpus_.push_back(cpu);
+  }
+  return topology;
+}
+
+CpuTopology CpuTopology::detect(const std::string& sysfs_root) {
+  std::string online;
+  std::vector<int> ids;
+  if (!readFile(sysfs_root + "/cpu/online", online) || !parseCpuList(online, ids)) {
+    return uniform(std::thread::hardware_concurrency());
+  }
+
+  CpuTopology topology;
+  topology.from_sysfs_ = true;
+  for (int id : ids) {
+    LogicalCpu cpu;
+    cpu.id = id;
+    const std::string base = sysfs_root + "/cpu/cpu" + std::to_string(id) + "/topology/";
+    if (!readInt(base + "physical_package_id", cpu.package_id)) cpu.package_id = 0;
+    if (!readInt(base + "core_id", cpu.core_id)) cpu.core_id = id;
+    topology.cpus_.push_back(cpu);
+  }
+
+  const std::vector<int> nodes = listNumbered(sysfs_root + "/node", "node");
+  size_t dense = 0;
+  for (int node : nodes) {
+    std::string list;
+    std::vector<int> members;
+    if (!readFile(sysfs_root + "/node/node" + std::to_string(node) + "/cpulist", list) ||
+        !parseCpuList(list, members)) {
+      continue;  // Memory-only node (no CPUs).
+    }
+    for (LogicalCpu& cpu : topology.cpus_) {
+      if (std::find(members.begin(), members.end(), cpu.id) != members.end()) {
+        cpu.node = static_cast<int>(dense);
+      }
+    }
+    ++dense;
+  }
+  topology.node_count_ = std::max<size_t>(dense, 1);
+  return topology;
+}
+
+int CpuTopology::nodeOf(int cpu) const {
+  for (const LogicalCpu& c : cpus_) {
+    if (c.id == cpu) return c.node;
+  }
+  return -1;
+}
+
+std::vector<int> planPlacement(const CpuTopology& topology, AffinityPolicy policy,
+                               size_t workers, const std::vector<int>& explicit_cpus) {
+  std::vector<int> order;
+  switch (policy) {
+    case AffinityPolicy::NONE:
+      return {};
+    case AffinityPolicy::EXPLICIT:
+      order = explicit_cpus;
+      break;
+    case AffinityPolicy::COMPACT: {
+      std::vector<LogicalCpu> cpus = topology.cpus();
+      std::sort(cpus.begin(), cpus.end(), [](const LogicalCpu& a, const LogicalCpu& b) {
+        return std::tie(a.node, a.package_id, a.core_id, a.id) <
+               std::tie(b.node, b.package_id, b.core_id, b.id);
+      });
+      for (const LogicalCpu& cpu : cpus) order.push_back(cpu.id);
+      break;
+    }
+    case AffinityPolicy::SCATTER: {
+      // Rank each CPU by (sibling index within its core, core index within
+      // its node, node): first threads of every core, spread over nodes.
+      std::map<std::tuple<int, int, int>, int> siblings_seen;       // (node, package, core)
+      std::map<int, std::map<std::pair<int, int>, int>> core_rank;  // node -> core -> rank
+      std::vector<std::tuple<int, int, int, int>> keyed;
+      for (const LogicalCpu& cpu : topology.cpus()) {
+        auto& cores = core_rank[cpu.node];
+        const auto core_key = std::make_pair(cpu.package_id, cpu.core_id);
+        if (cores.find(core_key) == cores.end()) {
+          const int next = static_cast<int>(cores.size());
+          cores[core_key] = next;
+        }
+        const int sibling = siblings_seen[{cpu.node, cpu.package_id, cpu.core_id}]++;
+        keyed.emplace_back(sibling, cores[core_key], cpu.node, cpu.id);
+      }
+      std::sort(keyed.begin(), keyed.end());
+      for (const auto& key : keyed) order.push_back(std::get<3>(key));
+      break;
+    }
+  }
+  if (order.empty()) return {};
+  std::vector<int> plan(workers);
+  for (size_t i = 0; i < workers; ++i) plan[i] = order[i % order.size()];
+  return plan;
+}
+
+#if defined(__linux__)
+static bool pinNativeThread(pthread_t thread, int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+}
+#endif
+
+bool pinCurrentThreadToCpu(int cpu) {
+#if defined(__linux__)
+  return pinNativeThread(pthread_self(), cpu);
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+bool pinThreadToCpu(std::thread& thread, int cpu) {
+#if defined(__linux__)
+  return pinNativeThread(thread.native_handle(), cpu);
+#else
+  (void)thread;
+  (void)cpu;
+  return false;
+#endif
+}
+
+const char* affinityPolicyName(AffinityPolicy policy) {
+  switch (policy) {
+    case AffinityPolicy::NONE:
+      return "none";
+    case AffinityPolicy::COMPACT:
+      return "compact";
+    case AffinityPolicy::SCATTER:
+      return "scatter";
+    case AffinityPolicy::EXPLICIT:
+      return "explicit";
+  }
+  return "unknown";
+}
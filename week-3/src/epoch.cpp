@@ -0,0 +1,182 @@
+#include "epoch.h"
+
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(__linux__) && !defined(__SANITIZE_THREAD__)
+constexpr bool MEMBARRIER_SUPPORTED = true;
+
+long membarrier(int cmd) { return syscall(SYS_membarrier, cmd, 0, 0); }
+#else
+constexpr bool MEMBARRIER_SUPPORTED = false;
+
+long membarrier(int) { return -1; }
+#endif
+
+bool registerAsymmetricFence() {
+  if (!MEMBARRIER_SUPPORTED) return false;
+#if defined(__linux__)
+  const long commands = membarrier(MEMBARRIER_CMD_QUERY);
+  if (commands < 0 || (commands & MEMBARRIER_CMD_PRIVATE_EXPEDITED) == 0) return false;
+  return membarrier(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED) == 0;
+#else
+  return false;
+#endif
+}
+
+// Full barrier on every thread of this process that is running right now.
+void heavyFence() {
+#if defined(__linux__)
+  membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED);
+#endif
+}
+
+// Runs every deleter in items. Deleters may retire more objects, so the
+// list is moved out first.
+template <typename Item, typename Get>
+size_t runDeleters(std::vector<Item>& items, Get&& get) {
+  std::vector<Item> batch;
+  batch.swap(items);
+  for (Item& item : batch) {
+    auto& retired = get(item);
+    retired.deleter(retired.pointer);
+  }
+  return batch.size();
+}
+
+}  // namespace
+
+EpochParticipant::EpochParticipant(EpochDomain& domain)
+    : domain_(domain), record_(domain.acquireRecord()) {}
+
+EpochParticipant::~EpochParticipant() {
+  record_->state.store(0, std::memory_order_release);
+  collect();
+  domain_.adoptOrphans(limbo_, 3);
+  record_->in_use.store(false, std::memory_order_release);
+}
+
+void EpochParticipant::retire(void* p, void (*deleter)(void*)) {
+  const uint64_t epoch = domain_.epoch_.load(std::memory_order_seq_cst);
+  Limbo& limbo = limbo_[epoch % 3];
+  if (limbo.epoch != epoch) {
+    // Same slot, three or more epochs ago: safe to free.
+    runDeleters(limbo.items, [](Retired& r) -> Retired& { return r; });
+    limbo.epoch = epoch;
+  }
+  limbo.items.push_back(Retired{p, deleter});
+  if (++since_collect_ >= COLLECT_INTERVAL) {
+    since_collect_ = 0;
+    collect();
+  }
+}
+
+size_t EpochParticipant::collect() {
+  const uint64_t epoch = domain_.tryAdvance();
+  return freeSafe(epoch) + domain_.freeOrphans(epoch);
+}
+
+size_t EpochParticipant::freeSafe(uint64_t epoch) {
+  size_t freed = 0;
+  for (Limbo& limbo : limbo_) {
+    if (!limbo.items.empty() && limbo.epoch + 2 <= epoch) {
+      freed += runDeleters(limbo.items, [](Retired& r) -> Retired& { return r; });
+    }
+  }
+  return freed;
+}
+
+size_t EpochParticipant::pending() const {
+  size_t total = 0;
+  for (const Limbo& limbo : limbo_) total += limbo.items.size();
+  return total;
+}
+
+EpochDomain::EpochDomain() : asymmetric_fence_(registerAsymmetricFence()) {}
+
+EpochDomain::~EpochDomain() {
+  runDeleters(orphans_, [](Orphan& o) -> Retired& { return o.item; });
+  Record* r = records_.load(std::memory_order_acquire);
+  while (r != nullptr) {
+    Record* next = r->next;
+    delete r;
+    r = next;
+  }
+}
+
+uint64_t EpochDomain::tryAdvance() {
+  // Pairs with the plain stores in EpochParticipant::publish: afterwards
+  // every reader's announcement is visible here, or its later reads see
+  // whatever was unlinked before this call.
+  if (asymmetric_fence_) heavyFence();
+  uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+  for (Record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+    const uint64_t state = r->state.load(std::memory_order_seq_cst);
+    if ((state & 1) != 0 && (state >> 1) != epoch) return epoch;
+  }
+  // A failed CAS means someone else advanced: epoch now holds the new value.
+  if (epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst)) ++epoch;
+  return epoch;
+}
+
+EpochDomain::Record* EpochDomain::acquireRecord() {
+  for (Record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+    bool expected = false;
+    if (!r->in_use.load(std::memory_order_relaxed) &&
+        r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+      return r;
+    }
+  }
+  auto* r = new Record;
+  r->in_use.store(true, std::memory_order_relaxed);
+  Record* head = records_.load(std::memory_order_relaxed);
+  do {
+    r->next = head;
+  } while (!records_.compare_exchange_weak(head, r, std::memory_order_release,
+                                           std::memory_order_relaxed));
+  return r;
+}
+
+void EpochDomain::adoptOrphans(const EpochParticipant::Limbo* limbo, size_t count) {
+  std::lock_guard<std::mutex> lock(orphan_mutex_);
+  for (size_t i = 0; i < count; ++i) {
+    for (const Retired& item : limbo[i].items) orphans_.push_back(Orphan{limbo[i].epoch, item});
+  }
+  has_orphans_.store(!orphans_.empty(), std::memory_order_release);
+}
+
+size_t EpochDomain::freeOrphans(uint64_t epoch) {
+  if (!has_orphans_.load(std::memory_order_acquire)) return 0;
+  std::vector<Orphan> safe;
+  {
+    std::lock_guard<std::mutex> lock(orphan_mutex_);
+    size_t kept = 0;
+    for (Orphan& o : orphans_) {
+      if (o.epoch + 2 <= epoch) {
+        safe.push_back(o);
+      } else {
+        orphans_[kept++] = o;
+      }
+    }
+    orphans_.resize(kept);
+    has_orphans_.store(kept > 0, std::memory_order_release);
+  }
+  return runDeleters(safe, [](Orphan& o) -> Retired& { return o.item; });
+}
+
+EpochDomain& defaultEpochDomain() {
+  static EpochDomain domain;
+  return domain;
+}
+
+EpochParticipant& localEpochParticipant() {
+  thread_local EpochParticipant participant(defaultEpochDomain());
+  return participant;
+}
@@ -0,0 +1,171 @@
+#include "hazard_pointer.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+struct Record {
+  std::atomic<const void*> slots[HazardPointer::SLOTS_PER_THREAD] = {};
+  std::atomic<bool> active{false};
+  Record* next = nullptr;  // Immutable once published
+};
+
+struct Retired {
+  void* pointer;
+  void (*deleter)(void*);
+};
+
+// Process-wide record list and orphaned garbage. Records are never freed
+// while the process runs: a scanning thread may be reading any of them.
+class Domain {
+ public:
+  ~Domain() {
+    for (const Retired& r : orphans_) r.deleter(r.pointer);
+    Record* r = head_.load(std::memory_order_acquire);
+    while (r != nullptr) {
+      Record* next = r->next;
+      delete r;
+      r = next;
+    }
+  }
+
+  Record* acquire() {
+    for (Record* r = head_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+      bool expected = false;
+      if (!r->active.load(std::memory_order_relaxed) &&
+          r->active.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return r;
+      }
+    }
+    auto* r = new Record;
+    r->active.store(true, std::memory_order_relaxed);
+    Record* head = head_.load(std::memory_order_relaxed);
+    do {
+      r->next = head;
+    } while (!head_.compare_exchange_weak(head, r, std::memory_order_release,
+                                          std::memory_order_relaxed));
+    records_.fetch_add(1, std::memory_order_relaxed);
+    return r;
+  }
+
+  void release(Record* r) {
+    for (auto& slot : r->slots) slot.store(nullptr, std::memory_order_relaxed);
+    r->active.store(false, std::memory_order_release);
+  }
+
+  size_t slotCount() const {
+    return records_.load(std::memory_order_relaxed) * HazardPointer::SLOTS_PER_THREAD;
+  }
+
+  void collectHazards(std::vector<const void*>& out) const {
+    out.clear();
+    for (Record* r = head_.load(std::memory_order_acquire); r != nullptr; r = r->next) {
+      for (const auto& slot : r->slots) {
+        if (const void* p = slot.load(std::memory_order_seq_cst)) out.push_back(p);
+      }
+    }
+    std::sort(out.begin(), out.end());
+  }
+
+  void addOrphans(std::vector<Retired>& retired) {
+    std::lock_guard<std::mutex> lock(orphan_mutex_);
+    orphans_.insert(orphans_.end(), retired.begin(), retired.end());
+    has_orphans_.store(true, std::memory_order_release);
+    retired.clear();
+  }
+
+  void adoptOrphans(std::vector<Retired>& into) {
+    if (!has_orphans_.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> lock(orphan_mutex_);
+    into.insert(into.end(), orphans_.begin(), orphans_.end());
+    orphans_.clear();
+    has_orphans_.store(false, std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<Record*> head_{nullptr};
+  std::atomic<size_t> records_{0};
+  std::mutex orphan_mutex_;
+  std::vector<Retired> orphans_;
+  std::atomic<bool> has_orphans_{false};
+};
+
+Domain& domain() {
+  static Domain d;
+  return d;
+}
+
+size_t scan(std::vector<Retired>& retired, std::vector<const void*>& hazards);
+
+struct ThreadState {
+  Record* record = nullptr;
+  unsigned used = 0;  // Bit i: slot i held by a live HazardPointer
+  std::vector<Retired> retired;
+  std::vector<const void*> hazards;  // Scan scratch, reused
+
+  ~ThreadState() {
+    if (!retired.empty()) scan(retired, hazards);
+    if (!retired.empty()) domain().addOrphans(retired);
+    if (record != nullptr) domain().release(record);
+  }
+};
+
+ThreadState& threadState() {
+  thread_local ThreadState state;
+  return state;
+}
+
+size_t scan(std::vector<Retired>& retired, std::vector<const void*>& hazards) {
+  domain().adoptOrphans(retired);
+  domain().collectHazards(hazards);
+  // Deleters may retire more nodes; work on a private list.
+  std::vector<Retired> candidates;
+  candidates.swap(retired);
+  size_t freed = 0;
+  for (const Retired& r : candidates) {
+    if (std::binary_search(hazards.begin(), hazards.end(), r.pointer)) {
+      retired.push_back(r);
+    } else {
+      r.deleter(r.pointer);
+      ++freed;
+    }
+  }
+  return freed;
+}
+
+}  // namespace
+
+HazardPointer::HazardPointer() {
+  ThreadState& state = threadState();
+  if (state.record == nullptr) state.record = domain().acquire();
+  for (index_ = 0; index_ < SLOTS_PER_THREAD; ++index_) {
+    if ((state.used & (1u << index_)) == 0) break;
+  }
+  if (index_ == SLOTS_PER_THREAD) {
+    throw std::runtime_error("HazardPointer: every slot of this thread is in use");
+  }
+  state.used |= 1u << index_;
+  slot_ = &state.record->slots[index_];
+}
+
+HazardPointer::~HazardPointer() {
+  reset();
+  threadState().used &= ~(1u << index_);
+}
+
+void retireHazardous(void* p, void (*deleter)(void*)) {
+  ThreadState& state = threadState();
+  state.retired.push_back(Retired{p, deleter});
+  const size_t threshold = std::max(HazardPointer::SCAN_THRESHOLD, 2 * domain().slotCount());
+  if (state.retired.size() >= threshold) scan(state.retired, state.hazards);
+}
+
+size_t scanHazards() {
+  ThreadState& state = threadState();
+  return scan(state.retired, state.hazards);
+}
+
+size_t pendingHazardous() { return threadState().retired.size(); }
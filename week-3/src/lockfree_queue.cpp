@@ -1 +1,7 @@
-// TODO: Implement lockfree_queue
+#include "lockfree_queue.h"
+
+#include <string>
+
+// Explicit instantiations: compile every member once in the library.
+template class LockFreeQueue<int>;
+template class LockFreeQueue<std::string>;
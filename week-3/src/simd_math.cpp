@@ -0,0 +1,165 @@
+#include <cstdint>
+#include <cstring>
+
+#include "lane_kernels.h"
+#include "simd_ops.h"
+
+/**
+ * Vectorized exp / log / erf / normal CDF (double precision)
+ *
+ * Each function is written once as a template over its lane type: plain
+ * double for the scalar fallback, or a GCC vector type of 2, 4 or 8
+ * doubles (one SSE2, AVX2 or AVX-512 register). The exp, log and erfc
+ * kernels and their helpers live in the repo-level include/lane_kernels.h
+ * (shared with quant-interview/medium); they are always_inline and carry
+ * no target attribute, so they compile to whatever ISA the kernel that
+ * inlines them was built for. Iterations are independent, so out-of-order
+ * execution overlaps the polynomial chains of consecutive vectors
+ * (doubling the vector width in software instead made GCC spill and ran
+ * 2-3x slower).
+ *
+ * - exp, log: expLanes / logLanes (see lane_kernels.h)
+ * - erf: |x| < 1 uses x P(x^2), above 1 - erfc(|x|) from erfcTail
+ * - normal CDF: 0.5 erfc(-x/sqrt(2)), with exp(-x^2/2) computed from x
+ *   itself, so the lower tail keeps its relative accuracy down to
+ *   subnormal results
+ */
+
+namespace {
+
+using namespace lane_math;
+
+template <typename D>
+LANE_INLINE D erfLanes(D x) {
+  const D a = copySign(x, splat<D>(1.0));
+  D sq_hi, sq_lo;
+  squareExact(a, sq_hi, sq_lo);
+  const D small = a * horner(ERF_SMALL, sq_hi);
+  const D large = 1.0 - erfcTail(a, sq_hi, sq_lo);
+  // Past ~5.9 erfc is below half an ulp of 1 (and exp(-y^2) may underflow).
+  const D magnitude = a < 1.0 ? small : (a < 6.0 ? large : splat<D>(1.0));
+  return copySign(a == a ? magnitude : x, x);  // NaN passes through
+}
+
+template <typename D>
+LANE_INLINE D normalCdfLanes(D x) {
+  constexpr double FRAC_1_SQRT2 = 0.70710678118654752;
+  // Past |x| = 40 the lower tail is below the smallest subnormal.
+  const D abs_x = copySign(x, splat<D>(1.0));
+  const D clamped = abs_x < 40.0 ? abs_x : splat<D>(40.0);
+  const D a = clamped * FRAC_1_SQRT2;
+  D sq_hi, sq_lo;
+  squareExact(clamped, sq_hi, sq_lo);  // a^2 = x^2 / 2, halved exactly below
+  const D erf_small = a * horner(ERF_SMALL, a * a);
+  const D tail = 0.5 * erfcTail(a, 0.5 * sq_hi, 0.5 * sq_lo);  // Phi(-|x|)
+  const D outer = x < 0.0 ? tail : 1.0 - tail;
+  // erfc directly from 0.5 on: 0.5 - erf(a) / 2 would cancel below x = -0.7.
+  const D central = 0.5 + 0.5 * copySign(erf_small, x);
+  return a < 0.5 ? central : (x == x ? outer : x);  // NaN passes through
+}
+
+struct ExpFn {
+  template <typename D>
+  LANE_INLINE static D apply(D x) {
+    return expLanes(x);
+  }
+};
+struct LogFn {
+  template <typename D>
+  LANE_INLINE static D apply(D x) {
+    return logLanes(x);
+  }
+};
+struct ErfFn {
+  template <typename D>
+  LANE_INLINE static D apply(D x) {
+    return erfLanes(x);
+  }
+};
+struct NormalCdfFn {
+  template <typename D>
+  LANE_INLINE static D apply(D x) {
+    return normalCdfLanes(x);
+  }
+};
+
+// Whole vectors, then the tail through a padded vector (never touches
+// memory past size).
+template <typename D, typename Fn>
+LANE_INLINE void mapLanes(const double* x, double* result, size_t size) {
+  constexpr size_t LANES = sizeof(D) / sizeof(double);
+  size_t i = 0;
+  for (; i + LANES <= size; i += LANES) {
+    D v;
+    std::memcpy(&v, x + i, sizeof(D));
+    v = Fn::apply(v);
+    std::memcpy(result + i, &v, sizeof(D));
+  }
+  if (i < size) {
+    D v = splat<D>(1.0);
+    std::memcpy(&v, x + i, (size - i) * sizeof(double));
+    v = Fn::apply(v);
+    std::memcpy(result + i, &v, (size - i) * sizeof(double));
+  }
+}
+
+template <typename Fn>
+void mathScalar(const double* x, double* result, size_t size) {
+  mapLanes<double, Fn>(x, result, size);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_MATH_X86 1
+
+template <typename Fn>
+__attribute__((target("sse2"))) void mathSse2(const double* x, double* result, size_t size) {
+  mapLanes<Double2, Fn>(x, result, size);
+}
+
+template <typename Fn>
+__attribute__((target("avx2,fma"))) void mathAvx2(const double* x, double* result, size_t size) {
+  mapLanes<Double4, Fn>(x, result, size);
+}
+
+template <typename Fn>
+__attribute__((target("avx512f"))) void mathAvx512(const double* x, double* result,
+                                                   size_t size) {
+  mapLanes<Double8, Fn>(x, result, size);
+}
+#endif
+
+using MathKernel = void (*)(const double*, double*, size_t);
+
+template <typename Fn>
+MathKernel mathKernel() {
+  switch (activeSimdLevel()) {
+#ifdef SIMD_MATH_X86
+    case SimdLevel::AVX512:
+      return &mathAvx512<Fn>;
+    case SimdLevel::AVX2:
+      return &mathAvx2<Fn>;
+    case SimdLevel::SSE2:
+      return &mathSse2<Fn>;
+#endif
+    default:
+      return &mathScalar<Fn>;
+  }
+}
+
+}  // namespace
+
+void vectorExp(const double* x, double* result, size_t size) {
+  mathKernel<ExpFn>()(x, result, size);
+}
+
+void vectorLog(const double* x, double* result, size_t size) {
+  mathKernel<LogFn>()(x, result, size);
+}
+
+void vectorErf(const double* x, double* result, size_t size) {
+  mathKernel<ErfFn>()(x, result, size);
+}
+
+void vectorNormalCdf(const double* x, double* result, size_t size) {
+  mathKernel<NormalCdfFn>()(x, result, size);
+}
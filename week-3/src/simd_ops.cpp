@@ -1 +1,454 @@
-// TODO: Implement simd_ops
+#include "simd_ops.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_OPS_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define SSE2_TARGET __attribute__((target("sse2")))
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_TARGET __attribute__((target("avx512f")))
+#endif
+
+// Keeps the scalar fallbacks scalar at -O3, so they remain an honest
+// baseline (and the reference the tests compare against).
+#if defined(__GNUC__) && !defined(__clang__)
+#define SCALAR_KERNEL __attribute__((optimize("no-tree-vectorize")))
+#else
+#define SCALAR_KERNEL
+#endif
+
+namespace {
+
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+// Element-wise operations: apply(a, b, c) for each vector width. Binary
+// operations ignore c.
+struct AddOp {
+  static constexpr bool TERNARY = false;
+  static float apply(float a, float b, float) { return a + b; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 apply(__m128 a, __m128 b, __m128) { return _mm_add_ps(a, b); }
+  AVX2_TARGET static __m256 apply(__m256 a, __m256 b, __m256) { return _mm256_add_ps(a, b); }
+  AVX512_TARGET static __m512 apply(__m512 a, __m512 b, __m512) { return _mm512_add_ps(a, b); }
+#endif
+};
+
+struct MultiplyOp {
+  static constexpr bool TERNARY = false;
+  static float apply(float a, float b, float) { return a * b; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 apply(__m128 a, __m128 b, __m128) { return _mm_mul_ps(a, b); }
+  AVX2_TARGET static __m256 apply(__m256 a, __m256 b, __m256) { return _mm256_mul_ps(a, b); }
+  AVX512_TARGET static __m512 apply(__m512 a, __m512 b, __m512) { return _mm512_mul_ps(a, b); }
+#endif
+};
+
+struct FmaOp {
+  static constexpr bool TERNARY = true;
+  static float apply(float a, float b, float c) { return a * b + c; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 apply(__m128 a, __m128 b, __m128 c) {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+  AVX2_TARGET static __m256 apply(__m256 a, __m256 b, __m256 c) {
+    return _mm256_fmadd_ps(a, b, c);
+  }
+  AVX512_TARGET static __m512 apply(__m512 a, __m512 b, __m512 c) {
+    return _mm512_fmadd_ps(a, b, c);
+  }
+#endif
+};
+
+// Reductions: combine() merges two partial results, IDENTITY fills masked
+// lanes. DotOp also multiplies its two inputs into the accumulator.
+struct SumOp {
+  static constexpr bool BINARY = false;
+  static constexpr float IDENTITY = 0.0f;
+  static float combine(float x, float y) { return x + y; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 combine(__m128 x, __m128 y) { return _mm_add_ps(x, y); }
+  AVX2_TARGET static __m256 combine(__m256 x, __m256 y) { return _mm256_add_ps(x, y); }
+  AVX512_TARGET static __m512 combine(__m512 x, __m512 y) { return _mm512_add_ps(x, y); }
+  AVX512_TARGET static float finish(__m512 x) { return _mm512_reduce_add_ps(x); }
+#endif
+};
+
+struct DotOp : SumOp {
+  static constexpr bool BINARY = true;
+  static float step(float acc, float a, float b) { return acc + a * b; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 step(__m128 acc, __m128 a, __m128 b) {
+    return _mm_add_ps(acc, _mm_mul_ps(a, b));
+  }
+  AVX2_TARGET static __m256 step(__m256 acc, __m256 a, __m256 b) {
+    return _mm256_fmadd_ps(a, b, acc);
+  }
+  AVX512_TARGET static __m512 step(__m512 acc, __m512 a, __m512 b) {
+    return _mm512_fmadd_ps(a, b, acc);
+  }
+#endif
+};
+
+struct MinOp {
+  static constexpr bool BINARY = false;
+  static constexpr float IDENTITY = INF;
+  // Keeps x unless y is smaller, so NaN elements (y) are skipped. minps
+  // computes first < second ? first : second, hence the swapped operands.
+  static float combine(float x, float y) { return y < x ? y : x; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 combine(__m128 x, __m128 y) { return _mm_min_ps(y, x); }
+  AVX2_TARGET static __m256 combine(__m256 x, __m256 y) { return _mm256_min_ps(y, x); }
+  AVX512_TARGET static __m512 combine(__m512 x, __m512 y) { return _mm512_min_ps(y, x); }
+  AVX512_TARGET static float finish(__m512 x) { return _mm512_reduce_min_ps(x); }
+#endif
+};
+
+struct MaxOp {
+  static constexpr bool BINARY = false;
+  static constexpr float IDENTITY = -INF;
+  // As MinOp: NaN elements are skipped.
+  static float combine(float x, float y) { return y > x ? y : x; }
+#ifdef SIMD_OPS_X86
+  SSE2_TARGET static __m128 combine(__m128 x, __m128 y) { return _mm_max_ps(y, x); }
+  AVX2_TARGET static __m256 combine(__m256 x, __m256 y) { return _mm256_max_ps(y, x); }
+  AVX512_TARGET static __m512 combine(__m512 x, __m512 y) { return _mm512_max_ps(y, x); }
+  AVX512_TARGET static float finish(__m512 x) { return _mm512_reduce_max_ps(x); }
+#endif
+};
+
+// Accumulates one element (or vector) of a reduction. One overload per
+// width, so each inlines into kernels of its own target.
+#define SIMD_ACCUMULATE(TARGET, V)              \
+  template <typename Op>                        \
+  TARGET inline V accumulate(V acc, V a, V b) { \
+    if constexpr (Op::BINARY) {                 \
+      return Op::step(acc, a, b);               \
+    } else {                                    \
+      return Op::combine(acc, a);               \
+    }                                           \
+  }
+
+SIMD_ACCUMULATE(, float)
+#ifdef SIMD_OPS_X86
+SIMD_ACCUMULATE(SSE2_TARGET, __m128)
+SIMD_ACCUMULATE(AVX2_TARGET, __m256)
+SIMD_ACCUMULATE(AVX512_TARGET, __m512)
+#endif
+
+#undef SIMD_ACCUMULATE
+
+// ---------------------------------------------------------------- Scalar
+
+template <typename Op>
+SCALAR_KERNEL void mapScalar(const float* a, const float* b, const float* c, float* result,
+                             size_t size) {
+  for (size_t i = 0; i < size; ++i) result[i] = Op::apply(a[i], b[i], Op::TERNARY ? c[i] : 0.0f);
+}
+
+template <typename Op>
+SCALAR_KERNEL float reduceScalar(const float* a, const float* b, size_t size) {
+  float acc = Op::IDENTITY;
+  for (size_t i = 0; i < size; ++i) acc = accumulate<Op>(acc, a[i], Op::BINARY ? b[i] : 0.0f);
+  return acc;
+}
+
+#ifdef SIMD_OPS_X86
+
+// Elements before the first `bytes`-aligned address at or after p.
+inline size_t headToAlign(const float* p, size_t bytes, size_t size) {
+  const size_t misaligned = reinterpret_cast<uintptr_t>(p) % bytes;
+  const size_t head = misaligned == 0 ? 0 : (bytes - misaligned) / sizeof(float);
+  return std::min(head, size);
+}
+
+// ------------------------------------------------------------------ SSE2
+
+template <typename Op>
+SSE2_TARGET void mapSse2(const float* a, const float* b, const float* c, float* result,
+                         size_t size) {
+  size_t i = headToAlign(result, 16, size);
+  mapScalar<Op>(a, b, c, result, i);
+  const __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= size; i += 4) {
+    const __m128 vc = Op::TERNARY ? _mm_loadu_ps(c + i) : zero;
+    _mm_store_ps(result + i, Op::apply(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i), vc));
+  }
+  mapScalar<Op>(a + i, b + i, Op::TERNARY ? c + i : c, result + i, size - i);
+}
+
+template <typename Op>
+SSE2_TARGET float horizontal(__m128 v) {
+  v = Op::combine(v, _mm_movehl_ps(v, v));
+  v = Op::combine(v, _mm_shuffle_ps(v, v, 1));
+  return _mm_cvtss_f32(v);
+}
+
+template <typename Op>
+SSE2_TARGET float reduceSse2(const float* a, const float* b, size_t size) {
+  const __m128 identity = _mm_set1_ps(Op::IDENTITY);
+  __m128 acc0 = identity, acc1 = identity, acc2 = identity, acc3 = identity;
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const float* pb = Op::BINARY ? b + i : a + i;
+    acc0 = accumulate<Op>(acc0, _mm_loadu_ps(a + i), _mm_loadu_ps(pb));
+    acc1 = accumulate<Op>(acc1, _mm_loadu_ps(a + i + 4), _mm_loadu_ps(pb + 4));
+    acc2 = accumulate<Op>(acc2, _mm_loadu_ps(a + i + 8), _mm_loadu_ps(pb + 8));
+    acc3 = accumulate<Op>(acc3, _mm_loadu_ps(a + i + 12), _mm_loadu_ps(pb + 12));
+  }
+  for (; i + 4 <= size; i += 4) {
+    acc0 = accumulate<Op>(acc0, _mm_loadu_ps(a + i), _mm_loadu_ps(Op::BINARY ? b + i : a + i));
+  }
+  const __m128 acc = Op::combine(Op::combine(acc0, acc1), Op::combine(acc2, acc3));
+  const float tail = reduceScalar<Op>(a + i, Op::BINARY ? b + i : b, size - i);
+  return Op::combine(horizontal<Op>(acc), tail);
+}
+
+// ------------------------------------------------------------------ AVX2
+
+// maskload/maskstore lanes: the first k lanes of MASKS + 8 - k are set.
+alignas(32) constexpr int32_t MASKS[16] = {-1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0};
+
+AVX2_TARGET inline __m256i firstLanes(size_t k) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(MASKS + 8 - k));
+}
+
+template <typename Op>
+AVX2_TARGET void mapAvx2Masked(const float* a, const float* b, const float* c, float* result,
+                               size_t k) {
+  const __m256i mask = firstLanes(k);
+  const __m256 vc = Op::TERNARY ? _mm256_maskload_ps(c, mask) : _mm256_setzero_ps();
+  const __m256 value = Op::apply(_mm256_maskload_ps(a, mask), _mm256_maskload_ps(b, mask), vc);
+  _mm256_maskstore_ps(result, mask, value);
+}
+
+template <typename Op>
+AVX2_TARGET void mapAvx2(const float* a, const float* b, const float* c, float* result,
+                         size_t size) {
+  size_t i = headToAlign(result, 32, size);
+  if (i > 0) mapAvx2Masked<Op>(a, b, c, result, i);
+  const __m256 zero = _mm256_setzero_ps();
+  for (; i + 8 <= size; i += 8) {
+    const __m256 vc = Op::TERNARY ? _mm256_loadu_ps(c + i) : zero;
+    _mm256_store_ps(result + i, Op::apply(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), vc));
+  }
+  if (i < size) mapAvx2Masked<Op>(a + i, b + i, Op::TERNARY ? c + i : c, result + i, size - i);
+}
+
+template <typename Op>
+AVX2_TARGET float reduceAvx2(const float* a, const float* b, size_t size) {
+  const __m256 identity = _mm256_set1_ps(Op::IDENTITY);
+  __m256 acc0 = identity, acc1 = identity, acc2 = identity, acc3 = identity;
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const float* pb = Op::BINARY ? b + i : a + i;
+    acc0 = accumulate<Op>(acc0, _mm256_loadu_ps(a + i), _mm256_loadu_ps(pb));
+    acc1 = accumulate<Op>(acc1, _mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(pb + 8));
+    acc2 = accumulate<Op>(acc2, _mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(pb + 16));
+    acc3 = accumulate<Op>(acc3, _mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(pb + 24));
+  }
+  for (; i + 8 <= size; i += 8) {
+    const float* pb = Op::BINARY ? b + i : a + i;
+    acc0 = accumulate<Op>(acc0, _mm256_loadu_ps(a + i), _mm256_loadu_ps(pb));
+  }
+  if (i < size) {
+    // Masked-off lanes read as IDENTITY (dot: 0 * 0).
+    const __m256i mask = firstLanes(size - i);
+    const __m256 lanes = _mm256_castsi256_ps(mask);
+    const float* pb = Op::BINARY ? b + i : a + i;
+    const __m256 va = _mm256_blendv_ps(identity, _mm256_maskload_ps(a + i, mask), lanes);
+    const __m256 vb = _mm256_blendv_ps(identity, _mm256_maskload_ps(pb, mask), lanes);
+    acc1 = accumulate<Op>(acc1, va, vb);
+  }
+  const __m256 acc = Op::combine(Op::combine(acc0, acc1), Op::combine(acc2, acc3));
+  const __m128 half = Op::combine(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+  return horizontal<Op>(half);
+}
+
+// --------------------------------------------------------------- AVX-512
+
+AVX512_TARGET inline __mmask16 firstLanes16(size_t k) {
+  return static_cast<__mmask16>((1u << k) - 1);
+}
+
+template <typename Op>
+AVX512_TARGET void mapAvx512Masked(const float* a, const float* b, const float* c, float* result,
+                                   size_t k) {
+  const __mmask16 mask = firstLanes16(k);
+  const __m512 vc = Op::TERNARY ? _mm512_maskz_loadu_ps(mask, c) : _mm512_setzero_ps();
+  const __m512 value =
+      Op::apply(_mm512_maskz_loadu_ps(mask, a), _mm512_maskz_loadu_ps(mask, b), vc);
+  _mm512_mask_storeu_ps(result, mask, value);
+}
+
+template <typename Op>
+AVX512_TARGET void mapAvx512(const float* a, const float* b, const float* c, float* result,
+                             size_t size) {
+  size_t i = headToAlign(result, 64, size);
+  if (i > 0) mapAvx512Masked<Op>(a, b, c, result, i);
+  const __m512 zero = _mm512_setzero_ps();
+  for (; i + 16 <= size; i += 16) {
+    const __m512 vc = Op::TERNARY ? _mm512_loadu_ps(c + i) : zero;
+    _mm512_store_ps(result + i, Op::apply(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), vc));
+  }
+  if (i < size) mapAvx512Masked<Op>(a + i, b + i, Op::TERNARY ? c + i : c, result + i, size - i);
+}
+
+template <typename Op>
+AVX512_TARGET float reduceAvx512(const float* a, const float* b, size_t size) {
+  const __m512 identity = _mm512_set1_ps(Op::IDENTITY);
+  __m512 acc0 = identity, acc1 = identity, acc2 = identity, acc3 = identity;
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    const float* pb = Op::BINARY ? b + i : a + i;
+    acc0 = accumulate<Op>(acc0, _mm512_loadu_ps(a + i), _mm512_loadu_ps(pb));
+    acc1 = accumulate<Op>(acc1, _mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(pb + 16));
+    acc2 = accumulate<Op>(acc2, _mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(pb + 32));
+    acc3 = accumulate<Op>(acc3, _mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(pb + 48));
+  }
+  for (; i + 16 <= size; i += 16) {
+    const float* pb = Op::BINARY ? b + i : a + i;
+    acc0 = accumulate<Op>(acc0, _mm512_loadu_ps(a + i), _mm512_loadu_ps(pb));
+  }
+  if (i < size) {
+    // Masked-off lanes read as IDENTITY (dot: 0 * 0).
+    const __mmask16 mask = firstLanes16(size - i);
+    const float* pb = Op::BINARY ? b + i : a + i;
+    acc1 = accumulate<Op>(acc1, _mm512_mask_loadu_ps(identity, mask, a + i),
+                          _mm512_mask_loadu_ps(identity, mask, pb));
+  }
+  return Op::finish(Op::combine(Op::combine(acc0, acc1), Op::combine(acc2, acc3)));
+}
+
+uint64_t readXcr0() {
+  uint32_t low, high;
+  __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+#endif  // SIMD_OPS_X86
+
+// ------------------------------------------------------------- Dispatch
+
+using MapKernel = void (*)(const float*, const float*, const float*, float*, size_t);
+using ReduceKernel = float (*)(const float*, const float*, size_t);
+
+struct Kernels {
+  SimdLevel level;
+  MapKernel add, multiply, fma;
+  ReduceKernel dot, sum, min, max;
+};
+
+#define SIMD_KERNELS(LEVEL, MAP, REDUCE)                                                       \
+  Kernels {                                                                                    \
+    LEVEL, &MAP<AddOp>, &MAP<MultiplyOp>, &MAP<FmaOp>, &REDUCE<DotOp>, &REDUCE<SumOp>,         \
+        &REDUCE<MinOp>, &REDUCE<MaxOp>                                                         \
+  }
+
+const Kernels SCALAR_KERNELS = SIMD_KERNELS(SimdLevel::SCALAR, mapScalar, reduceScalar);
+#ifdef SIMD_OPS_X86
+const Kernels SSE2_KERNELS = SIMD_KERNELS(SimdLevel::SSE2, mapSse2, reduceSse2);
+const Kernels AVX2_KERNELS = SIMD_KERNELS(SimdLevel::AVX2, mapAvx2, reduceAvx2);
+const Kernels AVX512_KERNELS = SIMD_KERNELS(SimdLevel::AVX512, mapAvx512, reduceAvx512);
+#endif
+
+#undef SIMD_KERNELS
+
+const Kernels* kernelsFor(SimdLevel level) {
+  switch (level) {
+#ifdef SIMD_OPS_X86
+    case SimdLevel::AVX512:
+      return &AVX512_KERNELS;
+    case SimdLevel::AVX2:
+      return &AVX2_KERNELS;
+    case SimdLevel::SSE2:
+      return &SSE2_KERNELS;
+#endif
+    default:
+      return &SCALAR_KERNELS;
+  }
+}
+
+SimdLevel probeSimdLevel() {
+#ifdef SIMD_OPS_X86
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(edx & bit_SSE2)) return SimdLevel::SCALAR;
+  // AVX state is only usable if the OS saves it: XCR0 bits 1-2 (SSE, YMM)
+  // for AVX2, plus bits 5-7 (opmask, ZMM) for AVX-512.
+  if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !(ecx & bit_FMA)) return SimdLevel::SSE2;
+  const uint64_t xcr0 = readXcr0();
+  if ((xcr0 & 0x6) != 0x6 || __get_cpuid_max(0, nullptr) < 7) return SimdLevel::SSE2;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  if (!(ebx & bit_AVX2)) return SimdLevel::SSE2;
+  if (!(ebx & bit_AVX512F) || (xcr0 & 0xE6) != 0xE6) return SimdLevel::AVX2;
+  return SimdLevel::AVX512;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+std::atomic<const Kernels*> active_kernels{nullptr};
+
+const Kernels& kernels() {
+  const Kernels* k = active_kernels.load(std::memory_order_acquire);
+  if (k == nullptr) {
+    // Racing first calls all store the same table.
+    k = kernelsFor(detectSimdLevel());
+    active_kernels.store(k, std::memory_order_release);
+  }
+  return *k;
+}
+
+}  // namespace
+
+const char* simdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::SCALAR:
+      return "scalar";
+    case SimdLevel::SSE2:
+      return "sse2";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+SimdLevel detectSimdLevel() {
+  static const SimdLevel detected = probeSimdLevel();
+  return detected;
+}
+
+SimdLevel activeSimdLevel() { return kernels().level; }
+
+bool setSimdLevel(SimdLevel level) {
+  if (level > detectSimdLevel()) return false;
+  active_kernels.store(kernelsFor(level), std::memory_order_release);
+  return true;
+}
+
+void vectorAdd(const float* a, const float* b, float* result, size_t size) {
+  kernels().add(a, b, nullptr, result, size);
+}
+
+void vectorMultiply(const float* a, const float* b, float* result, size_t size) {
+  kernels().multiply(a, b, nullptr, result, size);
+}
+
+void vectorFma(const float* a, const float* b, const float* c, float* result, size_t size) {
+  kernels().fma(a, b, c, result, size);
+}
+
+float dotProduct(const float* a, const float* b, size_t size) { return kernels().dot(a, b, size); }
+
+float vectorSum(const float* a, size_t size) { return kernels().sum(a, nullptr, size); }
+
+float vectorMin(const float* a, size_t size) { return kernels().min(a, nullptr, size); }
+
+float vectorMax(const float* a, size_t size) { return kernels().max(a, nullptr, size); }
@@ -1 +1,492 @@
-// TODO: Implement thread_pool
+#include "thread_pool.h"
+
+#include "frame_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// Which pool (if any) the current thread works for, and its index there.
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local size_t tls_index = 0;
+
+// Rounds of looking for work before a worker goes to sleep.
+constexpr int SPIN_ROUNDS = 64;
+
+constexpr size_t PAGE_SIZE = 4096;
+
+// HIGH-lane tasks a worker takes in a row before it looks at other work.
+constexpr int HIGH_STREAK_LIMIT = 32;
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+size_t laneIndex(TaskPriority priority) { return static_cast<size_t>(priority); }
+
+uint64_t nextRandom(uint64_t& state) {
+  // xorshift64*
+  state ^= state >> 12;
+  state ^= state << 25;
+  state ^= state >> 27;
+  return state * 0x2545F4914F6CDD1DULL;
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  ThreadPoolOptions options;
+  options.num_threads = num_threads;
+  start(options);
+}
+
+ThreadPool::ThreadPool(const ThreadPoolOptions& options) { start(options); }
+
+void ThreadPool::start(const ThreadPoolOptions& options) {
+  const size_t num_threads = options.num_threads == 0 ? 1 : options.num_threads;
+  if (options.affinity != AffinityPolicy::NONE) topology_ = CpuTopology::detect(options.sysfs_root);
+  const std::vector<int> plan =
+      planPlacement(topology_, options.affinity, num_threads, options.cpus);
+  reserved_workers_ = std::min(options.reserved_high_workers, num_threads - 1);
+  deadline_ordering_ = options.deadline_ordering;
+  max_lane_wait_ns_ =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(options.max_lane_wait).count();
+
+  for (size_t n = 0; n < topology_.nodeCount(); ++n) {
+    node_queues_.push_back(std::make_unique<NodeQueue>());
+  }
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    workers_.back()->rng_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+    workers_.back()->reserved = i < reserved_workers_;
+  }
+  threads_.reserve(num_threads);
+  const size_t scratch_bytes = options.scratch_bytes;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this, i, scratch_bytes] { workerLoop(i, scratch_bytes); });
+  }
+
+  // Pin from here while the workers wait on placed_, so every worker's
+  // node and victim order is final before any of them runs.
+  for (size_t i = 0; i < num_threads && !plan.empty(); ++i) {
+    Worker& w = *workers_[i];
+    if (!pinThreadToCpu(threads_[i], plan[i])) continue;
+    w.cpu = plan[i];
+    w.node = topology_.nodeOf(w.cpu);
+    if (w.node >= 0 && static_cast<size_t>(w.node) < node_queues_.size()) {
+      // Reserved workers never drain node queues.
+      if (!w.reserved) ++node_queues_[w.node]->workers;
+    } else {
+      w.node = -1;
+    }
+  }
+  for (size_t i = 0; i < num_threads; ++i) {
+    Worker& w = *workers_[i];
+    for (size_t j = 0; j < num_threads; ++j) {
+      if (j == i) continue;
+      const bool near = w.node >= 0 && workers_[j]->node == w.node;
+      (near ? w.near_victims : w.far_victims).push_back(j);
+    }
+  }
+  placed_.count_down();
+}
+
+void ThreadPool::AlignedFree::operator()(void* p) const { std::free(p); }
+
+ThreadPool::~ThreadPool() {
+  wait();
+  stop_.store(true);
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  wake_.notify_all();
+  reserved_wake_.notify_all();
+  for (auto& t : threads_) t.join();
+}
+
+int ThreadPool::currentWorkerIndex() const {
+  return tls_pool == this ? static_cast<int>(tls_index) : -1;
+}
+
+size_t ThreadPool::localQueueSize() const {
+  return tls_pool == this ? workers_[tls_index]->deque.size() : 0;
+}
+
+void ThreadPool::enqueue(Task task) {
+  Task* node = newTask(std::move(task));
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  // Count before publishing so a thief can never drive queued_ below zero.
+  queued_.fetch_add(1, std::memory_order_seq_cst);
+  if (tls_pool == this) {
+    workers_[tls_index]->deque.push(node);
+  } else {
+    std::lock_guard<std::mutex> lock(inject_mutex_);
+    injected_.push(node);
+  }
+  notifyWorkers();
+}
+
+void ThreadPool::enqueue(Task task, int node) {
+  if (node < 0 || static_cast<size_t>(node) >= node_queues_.size() ||
+      node_queues_[node]->workers == 0) {
+    enqueue(std::move(task));
+    return;
+  }
+  NodeQueue& queue = *node_queues_[node];
+  Task* item = newTask(std::move(task));
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  queue.queued.fetch_add(1, std::memory_order_seq_cst);
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push(item);
+  }
+  // Only this node's workers may take it, and a single notify could land on
+  // a remote sleeper that goes straight back to sleep: wake them all.
+  if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+  }
+}
+
+void ThreadPool::enqueue(Task task, TaskPriority priority) {
+  pushLane(std::move(task), priority, 0, false);
+}
+
+void ThreadPool::enqueue(Task task, TaskPriority priority, Clock::time_point deadline) {
+  const int64_t deadline_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+  pushLane(std::move(task), priority, deadline_ns, true);
+}
+
+void ThreadPool::pushLane(Task task, TaskPriority priority, int64_t deadline_ns,
+                          bool has_deadline) {
+  Lane& lane = lanes_[laneIndex(priority)];
+  Task* item = newTask(std::move(task));
+  const int64_t now = nowNs();
+  pending_.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    // Starvation is measured from when the lane last became non-empty.
+    if (lane.tasks.empty()) lane.last_served_ns.store(now, std::memory_order_relaxed);
+    const int64_t key = !deadline_ordering_ ? 0 : has_deadline ? deadline_ns : now;
+    lane.tasks.push(Lane::Entry{key, lane.next_seq++, now, item});
+    lane.queued.fetch_add(1, std::memory_order_seq_cst);
+  }
+  if (priority == TaskPriority::HIGH && reserved_workers_ > 0 &&
+      sleepers_.load(std::memory_order_seq_cst) > 0) {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    reserved_wake_.notify_one();
+  }
+  notifyWorkers();
+}
+
+void ThreadPool::resetLaneStats() {
+  for (Lane& lane : lanes_) lane.delay.reset();
+}
+
+void ThreadPool::notifyWorkers() {
+  // A worker that is already searching will find the task (or see queued_ > 0
+  // before it sleeps), so only pay for a futex wake when nobody is looking.
+  // Pairs with the searching_/sleepers_ updates in workerLoop.
+  if (searching_.load(std::memory_order_seq_cst) == 0 &&
+      sleepers_.load(std::memory_order_seq_cst) > 0) {
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    wake_.notify_one();
+  }
+}
+
+void ThreadPool::wait() {
+  if (tls_pool == this) {
+    // Blocking a worker could deadlock the pool (and the caller's own task
+    // is still pending), so help drain the queues instead. Node and lane
+    // queues are not counted in queued_. Tasks hinted to another node wait
+    // for that node's workers.
+    while (queued_.load(std::memory_order_acquire) > 0 || laneBacklog() > 0 ||
+           nodeBacklog() > 0) {
+      if (!tryRunPendingTask()) std::this_thread::yield();
+    }
+    return;
+  }
+  std::unique_lock<std::mutex> lock(done_mutex_);
+  done_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+}
+
+bool ThreadPool::tryRunPendingTask() {
+  if (tls_pool != this) return false;
+  Task* task = findTask(tls_index);
+  if (task == nullptr) return false;
+  runTask(task);
+  return true;
+}
+
+ThreadPool::Task* ThreadPool::popInjected() {
+  std::lock_guard<std::mutex> lock(inject_mutex_);
+  if (injected_.empty()) return nullptr;
+  Task* task = injected_.front();
+  injected_.pop();
+  return task;
+}
+
+ThreadPool::Task* ThreadPool::popNode(int node) {
+  NodeQueue& queue = *node_queues_[node];
+  if (queue.queued.load(std::memory_order_relaxed) == 0) return nullptr;
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) return nullptr;
+  Task* task = queue.tasks.front();
+  queue.tasks.pop();
+  queue.queued.fetch_sub(1, std::memory_order_relaxed);
+  return task;
+}
+
+ThreadPool::Task* ThreadPool::popLane(TaskPriority priority) {
+  Lane& lane = lanes_[laneIndex(priority)];
+  if (lane.queued.load(std::memory_order_relaxed) == 0) return nullptr;
+  Lane::Entry entry;
+  {
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    if (lane.tasks.empty()) return nullptr;
+    entry = lane.tasks.top();
+    lane.tasks.pop();
+    lane.queued.fetch_sub(1, std::memory_order_relaxed);
+  }
+  const int64_t now = nowNs();
+  lane.last_served_ns.store(now, std::memory_order_relaxed);
+  lane.delay.record(static_cast<uint64_t>(std::max<int64_t>(now - entry.enqueued_ns, 0)));
+  return entry.task;
+}
+
+ThreadPool::Task* ThreadPool::popStarvedLane() {
+  // Lowest lane first: it is the one most likely to be starving. Serving one
+  // task resets last_served_ns, so each lane gets at least one task per
+  // max_lane_wait however busy the lanes above it are.
+  int64_t now = 0;
+  for (size_t i = PRIORITY_LANES - 1; i > laneIndex(TaskPriority::HIGH); --i) {
+    const Lane& lane = lanes_[i];
+    if (lane.queued.load(std::memory_order_relaxed) == 0) continue;
+    if (now == 0) now = nowNs();
+    if (now - lane.last_served_ns.load(std::memory_order_relaxed) < max_lane_wait_ns_) continue;
+    if (Task* task = popLane(static_cast<TaskPriority>(i))) return task;
+  }
+  return nullptr;
+}
+
+size_t ThreadPool::laneBacklog() const {
+  size_t total = 0;
+  for (const Lane& lane : lanes_) total += lane.queued.load(std::memory_order_seq_cst);
+  return total;
+}
+
+size_t ThreadPool::nodeBacklog() const {
+  size_t total = 0;
+  for (const auto& queue : node_queues_) total += queue->queued.load(std::memory_order_seq_cst);
+  return total;
+}
+
+ThreadPool::Task* ThreadPool::stealFrom(size_t index, const std::vector<size_t>& victims) {
+  const size_t n = victims.size();
+  if (n == 0) return nullptr;
+  // Random starting victim, then sweep the rest once.
+  const size_t start = static_cast<size_t>(nextRandom(workers_[index]->rng_state) % n);
+  for (size_t k = 0; k < n; ++k) {
+    if (auto task = workers_[victims[(start + k) % n]]->deque.steal()) return *task;
+  }
+  return nullptr;
+}
+
+ThreadPool::Task* ThreadPool::stealFromOthers(size_t index) {
+  const Worker& w = *workers_[index];
+  if (Task* task = stealFrom(index, w.near_victims)) return task;
+  return stealFrom(index, w.far_victims);
+}
+
+ThreadPool::Task* ThreadPool::findTask(size_t index) {
+  Worker& w = *workers_[index];
+  if (w.reserved) {
+    // The own deque only ever holds tasks spawned by HIGH tasks.
+    if (auto local = w.deque.pop()) {
+      queued_.fetch_sub(1, std::memory_order_relaxed);
+      return *local;
+    }
+    return popLane(TaskPriority::HIGH);
+  }
+  if (Task* task = popStarvedLane()) return task;
+  if (w.high_streak < HIGH_STREAK_LIMIT) {
+    if (Task* task = popLane(TaskPriority::HIGH)) {
+      ++w.high_streak;
+      return task;
+    }
+  }
+  w.high_streak = 0;
+  // Node and lane queues keep their own counts, not queued_.
+  Task* task = nullptr;
+  if (auto local = w.deque.pop()) {
+    task = *local;
+  } else if (w.node >= 0 && (task = popNode(w.node)) != nullptr) {
+    return task;
+  } else if ((task = popLane(TaskPriority::NORMAL)) != nullptr) {
+    return task;
+  } else if (queued_.load(std::memory_order_relaxed) > 0) {
+    task = popInjected();
+    if (task == nullptr) task = stealFromOthers(index);
+  }
+  if (task != nullptr) {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+  if ((task = popLane(TaskPriority::LOW)) != nullptr) return task;
+  // Reached after a full HIGH streak when nothing else was runnable.
+  return popLane(TaskPriority::HIGH);
+}
+
+bool ThreadPool::hasWorkFor(size_t index) const {
+  const Worker& w = *workers_[index];
+  if (w.reserved) {
+    return lanes_[laneIndex(TaskPriority::HIGH)].queued.load(std::memory_order_seq_cst) > 0;
+  }
+  return queued_.load(std::memory_order_seq_cst) > 0 || laneBacklog() > 0 ||
+         (w.node >= 0 && node_queues_[w.node]->queued.load(std::memory_order_seq_cst) > 0);
+}
+
+void* ThreadPool::localScratch(size_t bytes) {
+  if (tls_pool != this) return nullptr;
+  Worker& w = *workers_[tls_index];
+  if (bytes > w.scratch_size || w.scratch == nullptr) {
+    const size_t size = (std::max<size_t>(bytes, 1) + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+    w.scratch.reset(std::aligned_alloc(PAGE_SIZE, size));
+    w.scratch_size = w.scratch != nullptr ? size : 0;
+    // First touch from the owning (pinned) thread puts the pages on its node.
+    if (w.scratch != nullptr) std::memset(w.scratch.get(), 0, size);
+  }
+  return w.scratch.get();
+}
+
+ThreadPool::Task* ThreadPool::newTask(Task&& task) {
+  return ::new (FramePool::allocate(sizeof(Task))) Task(std::move(task));
+}
+
+void ThreadPool::deleteTask(Task* task) {
+  task->~Task();
+  FramePool::deallocate(task, sizeof(Task));
+}
+
+void ThreadPool::runTask(Task* task) {
+  (*task)();
+  deleteTask(task);
+  if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    {
+      std::lock_guard<std::mutex> lock(done_mutex_);
+    }
+    done_.notify_all();
+  }
+}
+
+void ThreadPool::workerLoop(size_t index, size_t scratch_bytes) {
+  placed_.wait();
+  tls_pool = this;
+  tls_index = index;
+  if (scratch_bytes > 0) localScratch(scratch_bytes);
+  if (workers_[index]->reserved) {
+    reservedLoop(index);
+    tls_pool = nullptr;
+    return;
+  }
+  bool searching = false;
+  int idle_rounds = 0;
+  while (true) {
+    if (Task* task = findTask(index)) {
+      if (searching) {
+        searching = false;
+        // Last searcher found work: hand the search on if more is queued.
+        if (searching_.fetch_sub(1, std::memory_order_seq_cst) == 1 &&
+            queued_.load(std::memory_order_seq_cst) > 0) {
+          notifyWorkers();
+        }
+      }
+      runTask(task);
+      idle_rounds = 0;
+      continue;
+    }
+    if (!searching) {
+      searching = true;
+      searching_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    if (++idle_rounds < SPIN_ROUNDS) {
+      std::this_thread::yield();
+      continue;
+    }
+    idle_rounds = 0;
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    searching = false;
+    searching_.fetch_sub(1, std::memory_order_seq_cst);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    wake_.wait(lock, [this, index] { return stop_.load() || hasWorkFor(index); });
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    if (stop_.load() && !hasWorkFor(index)) break;
+    searching = true;
+    searching_.fetch_add(1, std::memory_order_seq_cst);
+  }
+  tls_pool = nullptr;
+}
+
+void ThreadPool::reservedLoop(size_t index) {
+  // Not counted in searching_: a reserved worker cannot pick up the plain
+  // tasks whose wake-ups that count suppresses.
+  int idle_rounds = 0;
+  while (true) {
+    if (Task* task = findTask(index)) {
+      runTask(task);
+      idle_rounds = 0;
+      continue;
+    }
+    if (++idle_rounds < SPIN_ROUNDS) {
+      std::this_thread::yield();
+      continue;
+    }
+    idle_rounds = 0;
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    reserved_wake_.wait(lock, [this, index] { return stop_.load() || hasWorkFor(index); });
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    if (stop_.load() && !hasWorkFor(index)) break;
+  }
+}
+
+const char* taskPriorityName(TaskPriority priority) {
+  switch (priority) {
+    case TaskPriority::HIGH:
+      return "high";
+    case TaskPriority::NORMAL:
+      return "normal";
+    case TaskPriority::LOW:
+      return "low";
+  }
+  return "unknown";
+}
+
+namespace future_detail {
+
+void schedule(ThreadPool* pool, InlineTask&& task) {
+  if (pool == nullptr) {
+    task();
+  } else {
+    pool->enqueue(std::move(task));
+  }
+}
+
+bool onWorkerOf(ThreadPool* pool) { return pool != nullptr && pool->currentWorkerIndex() >= 0; }
+
+bool tryRunPendingTask(ThreadPool* pool) { return pool != nullptr && pool->tryRunPendingTask(); }
+
+}  // namespace future_detail
@@ -1,10 +1,735 @@
 #include "thread_pool.h"
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "coro_task.h"
+#include "cpu_topology.h"
+#include "delay_histogram.h"
+#include "parallel_for.h"
+#include "work_stealing_deque.h"
+
 TEST(Day1ThreadPoolTest, Placeholder) { 
   EXPECT_TRUE(true); 
 }
 
+TEST(Day1ThreadPoolTest, DequeOwnerPopIsLifo) {
+  WorkStealingDeque<int> deque(4);
+  for (int i = 0; i < 10; ++i) deque.push(i);  // forces two grows
+  EXPECT_EQ(deque.size(), 10u);
+  for (int i = 9; i >= 0; --i) {
+    auto value = deque.pop();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_FALSE(deque.pop().has_value());
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST(Day1ThreadPoolTest, DequeStealIsFifo) {
+  WorkStealingDeque<int> deque;
+  for (int i = 0; i < 5; ++i) deque.push(i);
+  EXPECT_EQ(*deque.steal(), 0);
+  EXPECT_EQ(*deque.steal(), 1);
+  EXPECT_EQ(*deque.pop(), 4);
+  EXPECT_EQ(deque.size(), 2u);
+}
+
+TEST(Day1ThreadPoolTest, DequeConcurrentStealsTakeEachItemOnce) {
+  constexpr int ITEMS = 100000;
+  constexpr int THIEVES = 3;
+  WorkStealingDeque<int> deque(16);
+  std::atomic<bool> done{false};
+  std::vector<std::vector<int>> stolen(THIEVES);
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < THIEVES; ++t) {
+    thieves.emplace_back([&, t] {
+      while (!done.load() || !deque.empty()) {
+        if (auto value = deque.steal()) stolen[t].push_back(*value);
+      }
+    });
+  }
+  std::vector<int> popped;
+  for (int i = 0; i < ITEMS; ++i) {
+    deque.push(i);
+    if (i % 3 == 0) {
+      if (auto value = deque.pop()) popped.push_back(*value);
+    }
+  }
+  while (auto value = deque.pop()) popped.push_back(*value);
+  done.store(true);
+  for (auto& t : thieves) t.join();
+
+  std::set<int> seen(popped.begin(), popped.end());
+  size_t total = popped.size();
+  for (const auto& s : stolen) {
+    seen.insert(s.begin(), s.end());
+    total += s.size();
+  }
+  EXPECT_EQ(total, static_cast<size_t>(ITEMS));
+  EXPECT_EQ(seen.size(), static_cast<size_t>(ITEMS));
+}
+
+TEST(Day1ThreadPoolTest, RunsAllExternalTasks) {
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.size(), 4u);
+  std::atomic<int> counter{0};
+  for (int i = 0; i < 10000; ++i) pool.enqueue([&] { counter.fetch_add(1); });
+  pool.wait();
+  EXPECT_EQ(counter.load(), 10000);
+}
+
+TEST(Day1ThreadPoolTest, TasksSpawnedByWorkersRunLocally) {
+  ThreadPool pool(4);
+  std::atomic<int> counter{0};
+  std::atomic<int> wrong_pool{0};
+  for (int i = 0; i < 64; ++i) {
+    pool.enqueue([&] {
+      if (pool.currentWorkerIndex() < 0) wrong_pool.fetch_add(1);
+      for (int j = 0; j < 64; ++j) pool.enqueue([&] { counter.fetch_add(1); });
+    });
+  }
+  pool.wait();
+  EXPECT_EQ(counter.load(), 64 * 64);
+  EXPECT_EQ(wrong_pool.load(), 0);
+  EXPECT_EQ(pool.currentWorkerIndex(), -1);
+}
+
+TEST(Day1ThreadPoolTest, RecursiveSplittingSpreadsAcrossWorkers) {
+  ThreadPool pool(4);
+  std::atomic<long> sum{0};
+  std::vector<std::atomic<int>> per_worker(4);
+  std::function<void(int, int)> split = [&](int lo, int hi) {
+    if (hi - lo <= 16) {
+      long local = 0;
+      for (int i = lo; i < hi; ++i) local += i;
+      sum.fetch_add(local);
+      per_worker[pool.currentWorkerIndex()].fetch_add(1);
+      return;
+    }
+    int mid = lo + (hi - lo) / 2;
+    pool.enqueue([&, lo, mid] { split(lo, mid); });
+    pool.enqueue([&, mid, hi] { split(mid, hi); });
+  };
+  pool.enqueue([&] { split(0, 1 << 16); });
+  pool.wait();
+  EXPECT_EQ(sum.load(), (1L << 16) * ((1L << 16) - 1) / 2);
+  int total = 0;
+  for (auto& c : per_worker) total += c.load();
+  EXPECT_EQ(total, (1 << 16) / 16);
+}
+
+TEST(Day1ThreadPoolTest, WaitFromWorkerHelpsInsteadOfDeadlocking) {
+  ThreadPool pool(1);
+  std::atomic<int> counter{0};
+  pool.enqueue([&] {
+    for (int i = 0; i < 100; ++i) pool.enqueue([&] { counter.fetch_add(1); });
+    pool.wait();  // single worker: must run the children itself
+    EXPECT_EQ(counter.load(), 100);
+  });
+  pool.wait();
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(Day1ThreadPoolTest, WakesAfterIdleAndDestructorDrains) {
+  std::atomic<int> counter{0};
+  {
+    ThreadPool pool(2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));  // let workers sleep
+    for (int i = 0; i < 100; ++i) pool.enqueue([&] { counter.fetch_add(1); });
+  }
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(Day1ThreadPoolTest, InlineTaskStoresSmallCallablesInline) {
+  static_assert(sizeof(InlineTask) == 64);
+  int hits = 0;
+  InlineTask small([&hits] { ++hits; });
+  EXPECT_TRUE(small.isInline());
+  small();
+
+  std::array<char, 128> big_capture{};
+  InlineTask big([&hits, big_capture] { hits += big_capture[0] + 1; });
+  EXPECT_FALSE(big.isInline());
+  InlineTask moved(std::move(big));
+  EXPECT_FALSE(static_cast<bool>(big));
+  moved();
+
+  auto owned = std::make_unique<int>(40);
+  InlineTask move_only([&hits, p = std::move(owned)] { hits += *p; });
+  move_only();
+  EXPECT_EQ(hits, 42);
+}
+
+TEST(Day1ThreadPoolTest, SubmitReturnsValue) {
+  ThreadPool pool(2);
+  Future<int> answer = pool.submit([] { return 6 * 7; });
+  Future<std::string> text = pool.submit([] { return std::string("pool"); });
+  EXPECT_EQ(answer.get(), 42);
+  EXPECT_EQ(text.get(), "pool");
+  EXPECT_FALSE(answer.valid());
+
+  std::atomic<bool> ran{false};
+  Future<void> done = pool.submit([&] { ran = true; });
+  done.get();
+  EXPECT_TRUE(ran.load());
+}
+
+TEST(Day1ThreadPoolTest, SubmitPropagatesExceptions) {
+  ThreadPool pool(2);
+  Future<int> failing = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+  EXPECT_THROW(failing.get(), std::runtime_error);
+
+  std::atomic<bool> continued{false};
+  Future<int> chained = pool.submit([]() -> int { throw std::runtime_error("boom"); })
+                            .then([&](int v) {
+                              continued = true;
+                              return v + 1;
+                            });
+  EXPECT_THROW(chained.get(), std::runtime_error);
+  EXPECT_FALSE(continued.load());
+}
+
+TEST(Day1ThreadPoolTest, ThenChainsRunOnThePool) {
+  ThreadPool pool(2);
+  std::atomic<int> off_pool{0};
+  auto check = [&] {
+    if (pool.currentWorkerIndex() < 0) off_pool.fetch_add(1);
+  };
+  Future<std::string> result = pool.submit([] { return 20; })
+                                   .then([&](int v) {
+                                     check();
+                                     return v + 1;
+                                   })
+                                   .then([&](int v) {
+                                     check();
+                                     return std::to_string(v * 2);
+                                   });
+  EXPECT_EQ(result.get(), "42");
+
+  // Attaching to an already-ready future still schedules on the pool.
+  Future<int> ready = pool.submit([] { return 1; });
+  ready.wait();
+  EXPECT_TRUE(ready.isReady());
+  Future<void> tail = ready.then([&](int) { check(); });
+  tail.get();
+  EXPECT_EQ(off_pool.load(), 0);
+}
+
+TEST(Day1ThreadPoolTest, GetInsideWorkerDoesNotDeadlock) {
+  ThreadPool pool(1);
+  Future<int> outer = pool.submit([&] {
+    Future<int> inner = pool.submit([] { return 41; });
+    return inner.get() + 1;  // the only worker must run `inner` itself
+  });
+  EXPECT_EQ(outer.get(), 42);
+}
+
+TEST(Day1ThreadPoolTest, WhenAllCollectsInOrder) {
+  ThreadPool pool(4);
+  std::vector<Future<int>> futures;
+  for (int i = 0; i < 100; ++i) futures.push_back(pool.submit([i] { return i * i; }));
+  std::vector<int> squares = whenAll(std::move(futures)).get();
+  ASSERT_EQ(squares.size(), 100u);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(squares[i], i * i);
+
+  std::atomic<int> count{0};
+  std::vector<Future<void>> voids;
+  for (int i = 0; i < 10; ++i) voids.push_back(pool.submit([&] { count.fetch_add(1); }));
+  whenAll(std::move(voids)).get();
+  EXPECT_EQ(count.load(), 10);
+
+  EXPECT_TRUE(whenAll(std::vector<Future<int>>{}).get().empty());
+
+  std::vector<Future<int>> with_error;
+  with_error.push_back(pool.submit([] { return 1; }));
+  with_error.push_back(pool.submit([]() -> int { throw std::logic_error("bad"); }));
+  EXPECT_THROW(whenAll(std::move(with_error)).get(), std::logic_error);
+}
+
+TEST(Day1ThreadPoolTest, WhenAnyReturnsFirstFinished) {
+  ThreadPool pool(2);
+  std::atomic<bool> release{false};
+  std::vector<Future<int>> futures;
+  futures.push_back(pool.submit([&] {
+    while (!release.load()) std::this_thread::yield();
+    return 1;
+  }));
+  futures.push_back(pool.submit([] { return 2; }));
+  WhenAnyResult<int> first = whenAny(std::move(futures)).get();
+  EXPECT_EQ(first.index, 1u);
+  EXPECT_EQ(first.value, 2);
+  release = true;
+  pool.wait();
+
+  EXPECT_FALSE(whenAny(std::vector<Future<int>>{}).valid());
+}
+
+TEST(Day1ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool(4);
+  constexpr size_t N = 100000;
+  std::vector<std::atomic<int>> visits(N);
+  parallelFor(pool, 0, N, [&](size_t i) { visits[i].fetch_add(1, std::memory_order_relaxed); });
+  for (size_t i = 0; i < N; ++i) ASSERT_EQ(visits[i].load(), 1) << "index " << i;
+
+  // Chunked body, offset range.
+  std::vector<int> out(N, 0);
+  parallelFor(pool, 10, N, [&](size_t lo, size_t hi) {
+    for (size_t i = lo; i < hi; ++i) out[i] = static_cast<int>(i);
+  });
+  EXPECT_EQ(out[9], 0);
+  EXPECT_EQ(out[10], 10);
+  EXPECT_EQ(out[N - 1], static_cast<int>(N - 1));
+
+  bool touched = false;
+  parallelFor(pool, 5, 5, [&](size_t) { touched = true; });
+  EXPECT_FALSE(touched);
+}
+
+TEST(Day1ThreadPoolTest, ParallelForHandlesIrregularWork) {
+  ThreadPool pool(4);
+  constexpr size_t N = 2000;
+  std::atomic<uint64_t> total{0};
+  // Cost grows with i: a static split would leave the last thread busiest.
+  parallelFor(pool, 0, N, [&](size_t i) {
+    uint64_t local = 0;
+    for (size_t k = 0; k < i; ++k) local += k & 1;
+    total.fetch_add(local, std::memory_order_relaxed);
+  });
+  uint64_t expected = 0;
+  for (size_t i = 0; i < N; ++i) expected += i / 2;
+  EXPECT_EQ(total.load(), expected);
+}
+
+TEST(Day1ThreadPoolTest, ParallelReduceMatchesSerial) {
+  ThreadPool pool(4);
+  constexpr size_t N = 1 << 20;
+  const uint64_t sum = parallelReduce(
+      pool, 0, N, uint64_t{0}, [](size_t i) { return static_cast<uint64_t>(i); },
+      [](uint64_t a, uint64_t b) { return a + b; });
+  EXPECT_EQ(sum, static_cast<uint64_t>(N) * (N - 1) / 2);
+
+  const size_t max_mod = parallelReduce(
+      pool, 0, N, size_t{0}, [](size_t i) { return (i * 7919) % 1000003; },
+      [](size_t a, size_t b) { return std::max(a, b); });
+  EXPECT_EQ(max_mod, 1000002u);
+
+  EXPECT_EQ(parallelReduce(pool, 3, 3, 17, [](size_t) { return 1; }, std::plus<int>()), 17);
+}
+
+TEST(Day1ThreadPoolTest, NestedParallelForInsideWorker) {
+  ThreadPool pool(2);
+  std::atomic<int> cells{0};
+  parallelFor(pool, 0, 16, [&](size_t) {
+    parallelFor(pool, 0, 64, [&](size_t) { cells.fetch_add(1, std::memory_order_relaxed); });
+  });
+  EXPECT_EQ(cells.load(), 16 * 64);
+
+  ThreadPool single(1);
+  const int total = single.submit([&] {
+    return parallelReduce(single, 0, 1000, 0, [](size_t) { return 1; }, std::plus<int>());
+  }).get();
+  EXPECT_EQ(total, 1000);
+}
+
+namespace {
+
+Task<int> answerTask() { co_return 42; }
+
+Task<int> addOne(Task<int> inner) { co_return co_await std::move(inner) + 1; }
+
+Task<int> onPool(ThreadPool& pool, std::atomic<int>& off_pool) {
+  co_await pool.schedule();
+  if (pool.currentWorkerIndex() < 0) off_pool.fetch_add(1);
+  co_return co_await addOne(answerTask());
+}
+
+Task<int> throwingTask() {
+  throw std::runtime_error("coroutine failed");
+  co_return 0;
+}
+
+Task<long> sumSynchronousTasks(int count) {
+  long total = 0;
+  // Each awaited task completes without suspending; without symmetric
+  // transfer every iteration would leave frames on the stack.
+  for (int i = 0; i < count; ++i) total += co_await answerTask();
+  co_return total;
+}
+
+Task<void> hopAndCount(ThreadPool& pool, std::atomic<int>& hops, int n) {
+  for (int i = 0; i < n; ++i) {
+    co_await pool.schedule();
+    hops.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace
+
+TEST(Day1ThreadPoolTest, CoroutineTaskReturnsValues) {
+  EXPECT_EQ(syncWait(answerTask()), 42);
+  EXPECT_EQ(syncWait(addOne(addOne(answerTask()))), 44);
+  EXPECT_THROW(syncWait(throwingTask()), std::runtime_error);
+  EXPECT_THROW(syncWait(addOne(throwingTask())), std::runtime_error);
+
+  Task<int> lazy = answerTask();
+  EXPECT_TRUE(lazy.valid());
+  // Never awaited: destroying it must just free the frame.
+}
+
+TEST(Day1ThreadPoolTest, CoroutineAwaitingEmptyTaskThrows) {
+  EXPECT_THROW(syncWait(Task<int>{}), std::logic_error);
+  EXPECT_THROW(syncWait(addOne(Task<int>{})), std::logic_error);
+
+  Task<int> moved_from = answerTask();
+  Task<int> owner = std::move(moved_from);
+  EXPECT_FALSE(moved_from.valid());  // NOLINT(bugprone-use-after-move)
+  EXPECT_THROW(syncWait(std::move(moved_from)), std::logic_error);
+  EXPECT_EQ(syncWait(std::move(owner)), 42);
+}
+
+TEST(Day1ThreadPoolTest, CoroutineScheduleResumesOnWorker) {
+  ThreadPool pool(2);
+  std::atomic<int> off_pool{0};
+  EXPECT_EQ(syncWait(onPool(pool, off_pool)), 43);
+  EXPECT_EQ(off_pool.load(), 0);
+
+  std::atomic<int> hops{0};
+  std::vector<std::thread> drivers;
+  for (int t = 0; t < 4; ++t) {
+    drivers.emplace_back([&] { syncWait(hopAndCount(pool, hops, 250)); });
+  }
+  for (auto& d : drivers) d.join();
+  EXPECT_EQ(hops.load(), 1000);
+}
+
+TEST(Day1ThreadPoolTest, CoroutineSymmetricTransferKeepsStackFlat) {
+#if defined(__clang__) || \
+    (defined(__OPTIMIZE__) && !defined(__SANITIZE_THREAD__) && !defined(__SANITIZE_ADDRESS__))
+  constexpr int DEPTH = 1000000;
+#elif defined(__SANITIZE_THREAD__) || defined(__SANITIZE_ADDRESS__)
+  // No tail calls (see below), and sanitizer frames carry redzones.
+  constexpr int DEPTH = 1000;
+#else
+  // GCC only emits symmetric transfer as a tail call in optimized,
+  // uninstrumented builds.
+  constexpr int DEPTH = 10000;
+#endif
+  EXPECT_EQ(syncWait(sumSynchronousTasks(DEPTH)), 42L * DEPTH);
+}
+
+TEST(Day1ThreadPoolTest, CoroutineSyncWaitInsideWorker) {
+  ThreadPool pool(1);
+  std::atomic<int> hops{0};
+  pool.submit([&] { syncWait(hopAndCount(pool, hops, 10), &pool); }).get();
+  EXPECT_EQ(hops.load(), 10);
+}
+
+TEST(Day1ThreadPoolTest, FramePoolReusesFrames) {
+  EXPECT_EQ(FramePool::sizeClass(1), 0u);
+  EXPECT_EQ(FramePool::sizeClass(64), 0u);
+  EXPECT_EQ(FramePool::sizeClass(65), 1u);
+  EXPECT_EQ(FramePool::sizeClass(4096), 6u);
+  EXPECT_EQ(FramePool::sizeClass(4097), FramePool::SIZE_CLASSES);
+
+  void* first = FramePool::allocate(100);
+  FramePool::deallocate(first, 100);
+  void* second = FramePool::allocate(120);  // same 128-byte class
+  EXPECT_EQ(first, second);
+  FramePool::deallocate(second, 120);
+
+  void* big = FramePool::allocate(10000);
+  FramePool::deallocate(big, 10000);
+
+  // Control block and value share one block, recycled like any other.
+  using Payload = std::array<char, 100>;
+  auto shared = std::allocate_shared<Payload>(FramePoolAllocator<Payload>());
+  const void* block = shared.get();
+  shared.reset();
+  shared = std::allocate_shared<Payload>(FramePoolAllocator<Payload>());
+  EXPECT_EQ(shared.get(), block);
+}
+
+namespace {
+
+void writeSysfsFile(const std::filesystem::path& path, const std::string& text) {
+  std::filesystem::create_directories(path.parent_path());
+  std::ofstream(path) << text << "\n";
+}
+
+// Two sockets, one node each, two cores per socket, two threads per core,
+// numbered the way Linux usually does: siblings are N and N + 4.
+std::filesystem::path makeFakeSysfs() {
+  const auto root = std::filesystem::path(testing::TempDir()) / "fake_sysfs";
+  std::filesystem::remove_all(root);
+  writeSysfsFile(root / "cpu/online", "0-7");
+  for (int cpu = 0; cpu < 8; ++cpu) {
+    const auto topo = root / ("cpu/cpu" + std::to_string(cpu)) / "topology";
+    writeSysfsFile(topo / "physical_package_id", std::to_string((cpu / 2) % 2));
+    writeSysfsFile(topo / "core_id", std::to_string(cpu % 2));
+  }
+  writeSysfsFile(root / "node/node0/cpulist", "0-1,4-5");
+  writeSysfsFile(root / "node/node1/cpulist", "2-3,6-7");
+  return root;
+}
+
+}  // namespace
+
+TEST(Day1ThreadPoolTest, ParseCpuList) {
+  std::vector<int> cpus;
+  EXPECT_TRUE(parseCpuList("0-3,8,10-11", cpus));
+  EXPECT_EQ(cpus, (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_TRUE(parseCpuList("5", cpus));
+  EXPECT_EQ(cpus, std::vector<int>{5});
+  EXPECT_FALSE(parseCpuList("", cpus));
+  EXPECT_FALSE(parseCpuList("3-1", cpus));
+  EXPECT_FALSE(parseCpuList("a-b", cpus));
+  EXPECT_FALSE(parseCpuList("1-2x", cpus));
+}
+
+TEST(Day1ThreadPoolTest, TopologyFromFakeSysfs) {
+  const CpuTopology topo = CpuTopology::detect(makeFakeSysfs().string());
+  EXPECT_TRUE(topo.fromSysfs());
+  ASSERT_EQ(topo.cpus().size(), 8u);
+  EXPECT_EQ(topo.nodeCount(), 2u);
+  EXPECT_EQ(topo.nodeOf(0), 0);
+  EXPECT_EQ(topo.nodeOf(6), 1);
+  EXPECT_EQ(topo.nodeOf(42), -1);
+  EXPECT_EQ(topo.cpus()[3].package_id, 1);
+
+  EXPECT_EQ(planPlacement(topo, AffinityPolicy::COMPACT, 8),
+            (std::vector<int>{0, 4, 1, 5, 2, 6, 3, 7}));
+  EXPECT_EQ(planPlacement(topo, AffinityPolicy::SCATTER, 8),
+            (std::vector<int>{0, 2, 1, 3, 4, 6, 5, 7}));
+  EXPECT_EQ(planPlacement(topo, AffinityPolicy::EXPLICIT, 3, {7, 2}),
+            (std::vector<int>{7, 2, 7}));
+  EXPECT_TRUE(planPlacement(topo, AffinityPolicy::NONE, 4).empty());
+
+  const CpuTopology missing = CpuTopology::detect("/nonexistent");
+  EXPECT_FALSE(missing.fromSysfs());
+  EXPECT_GE(missing.cpus().size(), 1u);
+  EXPECT_EQ(missing.nodeCount(), 1u);
+
+  EXPECT_GE(CpuTopology::detect().cpus().size(), 1u);
+}
+
+TEST(Day1ThreadPoolTest, PinnedPoolHonoursNodeHints) {
+  ThreadPoolOptions options;
+  options.num_threads = 2;
+  options.affinity = AffinityPolicy::EXPLICIT;
+  options.cpus = {0};
+  ThreadPool pool(options);
+  if (pool.workerCpu(0) < 0) GTEST_SKIP() << "thread affinity not available";
+  EXPECT_EQ(pool.workerCpu(1), 0);
+  EXPECT_EQ(pool.workerNode(0), pool.topology().nodeOf(0));
+
+  const int node = pool.workerNode(0);
+  std::atomic<int> wrong_node{0};
+  std::atomic<int> ran{0};
+  for (int i = 0; i < 100; ++i) {
+    pool.enqueue([&] {
+      const int self = pool.currentWorkerIndex();
+      if (pool.workerNode(static_cast<size_t>(self)) != node) wrong_node.fetch_add(1);
+      ran.fetch_add(1);
+    }, node);
+  }
+  pool.enqueue([&] { ran.fetch_add(1); }, 99);  // unknown node: shared queue
+  pool.wait();
+  EXPECT_EQ(ran.load(), 101);
+  EXPECT_EQ(wrong_node.load(), 0);
+}
+
+TEST(Day1ThreadPoolTest, WaitFromWorkerDrainsNodeQueue) {
+  ThreadPoolOptions options;
+  options.num_threads = 1;
+  options.affinity = AffinityPolicy::EXPLICIT;
+  options.cpus = {0};
+  ThreadPool pool(options);
+  if (pool.workerCpu(0) < 0) GTEST_SKIP() << "thread affinity not available";
+  const int node = pool.workerNode(0);
+  std::atomic<int> counter{0};
+  pool.enqueue([&] {
+    for (int i = 0; i < 100; ++i) pool.enqueue([&] { counter.fetch_add(1); }, node);
+    pool.wait();  // Only this worker serves the node queue
+    EXPECT_EQ(counter.load(), 100);
+  });
+  pool.wait();
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(Day1ThreadPoolTest, WorkerScratchIsLocalAndZeroed) {
+  ThreadPoolOptions options;
+  options.num_threads = 2;
+  options.scratch_bytes = 10000;
+  ThreadPool pool(options);
+  EXPECT_EQ(pool.localScratch(64), nullptr);
+
+  auto check = pool.submit([&] {
+    auto* first = static_cast<unsigned char*>(pool.localScratch(5000));
+    bool ok = first != nullptr && reinterpret_cast<uintptr_t>(first) % 4096 == 0;
+    for (size_t i = 0; ok && i < 5000; ++i) ok = first[i] == 0;
+    first[0] = 7;
+    ok = ok && pool.localScratch(100) == first;  // preallocated 10000 covers it
+    auto* bigger = static_cast<unsigned char*>(pool.localScratch(1 << 20));
+    ok = ok && bigger != nullptr && bigger[0] == 0;
+    return ok;
+  });
+  EXPECT_TRUE(check.get());
+}
+
+namespace {
+
+// Holds `count` workers inside a task until release() so that lane tasks
+// queue up behind them.
+class WorkerGate {
+ public:
+  WorkerGate(ThreadPool& pool, int count) : count_(count) {
+    for (int i = 0; i < count; ++i) {
+      pool.enqueue([this] {
+        entered_.fetch_add(1);
+        while (!open_.load()) std::this_thread::yield();
+      });
+    }
+    while (entered_.load() < count_) std::this_thread::yield();
+  }
+  void release() { open_.store(true); }
+
+ private:
+  int count_;
+  std::atomic<int> entered_{0};
+  std::atomic<bool> open_{false};
+};
+
+ThreadPoolOptions laneOptions(size_t threads) {
+  ThreadPoolOptions options;
+  options.num_threads = threads;
+  options.max_lane_wait = std::chrono::seconds(60);  // Keep aging out of ordering tests
+  return options;
+}
+
+}  // namespace
+
+TEST(Day1ThreadPoolTest, DelayHistogramPercentiles) {
+  DelayHistogram histogram;
+  EXPECT_EQ(histogram.percentile(50), 0u);
+  for (uint64_t v = 1; v <= 1000; ++v) histogram.record(v * 1000);
+  EXPECT_EQ(histogram.count(), 1000u);
+  EXPECT_EQ(histogram.max(), 1000000u);
+  EXPECT_NEAR(histogram.mean(), 500500.0, 1.0);
+  const uint64_t p50 = histogram.percentile(50);
+  const uint64_t p99 = histogram.percentile(99);
+  EXPECT_GE(p50, 500000u);
+  EXPECT_LE(p50, 500000u * 9 / 8);
+  EXPECT_GE(p99, 990000u);
+  EXPECT_LE(p99, 1000000u);
+  EXPECT_EQ(DelayHistogram::bucketOf(7), 7u);
+  EXPECT_GE(DelayHistogram::bucketUpperBound(DelayHistogram::bucketOf(12345)), 12345u);
+  histogram.reset();
+  EXPECT_EQ(histogram.count(), 0u);
+}
+
+TEST(Day1ThreadPoolTest, PriorityLanesRunHighBeforeNormalBeforeLow) {
+  ThreadPool pool(laneOptions(1));
+  std::vector<TaskPriority> order;
+  {
+    WorkerGate gate(pool, 1);
+    for (int i = 0; i < 10; ++i) {
+      pool.enqueue([&] { order.push_back(TaskPriority::LOW); }, TaskPriority::LOW);
+      pool.enqueue([&] { order.push_back(TaskPriority::NORMAL); }, TaskPriority::NORMAL);
+      pool.enqueue([&] { order.push_back(TaskPriority::HIGH); }, TaskPriority::HIGH);
+    }
+    gate.release();
+    pool.wait();
+  }
+  ASSERT_EQ(order.size(), 30u);
+  for (size_t i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(order[i], static_cast<TaskPriority>(i / 10)) << "position " << i;
+  }
+  EXPECT_EQ(pool.laneDelay(TaskPriority::HIGH).count(), 10u);
+  EXPECT_EQ(pool.laneDelay(TaskPriority::LOW).count(), 10u);
+  EXPECT_LE(pool.laneDelay(TaskPriority::HIGH).percentile(50),
+            pool.laneDelay(TaskPriority::LOW).percentile(50));
+  pool.resetLaneStats();
+  EXPECT_EQ(pool.laneDelay(TaskPriority::LOW).count(), 0u);
+}
+
+TEST(Day1ThreadPoolTest, DeadlineOrderingIsEarliestFirst) {
+  ThreadPoolOptions options = laneOptions(1);
+  options.deadline_ordering = true;
+  ThreadPool pool(options);
+  std::vector<int> order;
+  {
+    WorkerGate gate(pool, 1);
+    const auto now = ThreadPool::Clock::now();
+    for (int i = 0; i < 8; ++i) {
+      pool.enqueue([&, i] { order.push_back(i); }, TaskPriority::NORMAL,
+                   now + std::chrono::milliseconds(100 - i));
+    }
+    // No deadline: due at enqueue time, so ahead of every future deadline.
+    pool.enqueue([&] { order.push_back(-1); }, TaskPriority::NORMAL);
+    gate.release();
+    pool.wait();
+  }
+  EXPECT_EQ(order, (std::vector<int>{-1, 7, 6, 5, 4, 3, 2, 1, 0}));
+}
+
+TEST(Day1ThreadPoolTest, LowLaneIsNotStarvedByHighStream) {
+  ThreadPoolOptions options = laneOptions(1);
+  options.max_lane_wait = std::chrono::milliseconds(1);
+  ThreadPool pool(options);
+  std::atomic<bool> low_ran{false};
+  std::atomic<int> high_ran{0};
+  // A HIGH task that keeps re-enqueueing itself: the HIGH lane never drains.
+  std::function<void()> high = [&] {
+    if (low_ran.load() || high_ran.fetch_add(1) > 100000) return;
+    pool.enqueue([&] { high(); }, TaskPriority::HIGH);
+  };
+  pool.enqueue([&] { low_ran.store(true); }, TaskPriority::LOW);
+  pool.enqueue([&] { high(); }, TaskPriority::HIGH);
+  pool.wait();
+  EXPECT_TRUE(low_ran.load());
+  EXPECT_LT(high_ran.load(), 100);
+}
+
+TEST(Day1ThreadPoolTest, ReservedWorkersServeOnlyHighLane) {
+  ThreadPoolOptions options = laneOptions(3);
+  options.reserved_high_workers = 1;
+  ThreadPool pool(options);
+  EXPECT_EQ(pool.reservedWorkers(), 1u);
+
+  // Both general workers busy: a HIGH task still starts, on the reserved one.
+  WorkerGate gate(pool, 2);
+  auto high = pool.submit([&] { return pool.currentWorkerIndex(); }, TaskPriority::HIGH);
+  EXPECT_EQ(high.get(), 0);
+  gate.release();
+
+  std::atomic<int> on_reserved{0};
+  for (int i = 0; i < 2000; ++i) {
+    auto record = [&] {
+      if (pool.currentWorkerIndex() == 0) on_reserved.fetch_add(1);
+    };
+    pool.enqueue(record);
+    pool.enqueue(record, i % 2 == 0 ? TaskPriority::NORMAL : TaskPriority::LOW);
+  }
+  pool.wait();
+  EXPECT_EQ(on_reserved.load(), 0);
+
+  ThreadPoolOptions single = laneOptions(1);
+  single.reserved_high_workers = 4;
+  EXPECT_EQ(ThreadPool(single).reservedWorkers(), 0u);  // One worker stays general
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,10 +1,613 @@
 #include "lockfree_queue.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "epoch.h"
+#include "hazard_pointer.h"
+#include "ms_queue.h"
+#include "seqlock.h"
+#include "skip_list.h"
+
 TEST(Day2LockFreeTest, Placeholder) { 
   EXPECT_TRUE(true); 
 }
 
+TEST(Day2LockFreeTest, QueueIsFifoAndBounded) {
+  LockFreeQueue<int> queue(1000);
+  EXPECT_EQ(queue.capacity(), 1024u);
+  int value = 0;
+  EXPECT_FALSE(queue.tryPop(value));
+  // Several laps so cells are reused.
+  for (int lap = 0; lap < 3; ++lap) {
+    for (int i = 0; i < 1024; ++i) EXPECT_TRUE(queue.tryPush(lap * 10000 + i));
+    EXPECT_FALSE(queue.tryPush(-1));
+    EXPECT_EQ(queue.size(), 1024u);
+    for (int i = 0; i < 1024; ++i) {
+      ASSERT_TRUE(queue.tryPop(value));
+      EXPECT_EQ(value, lap * 10000 + i);
+    }
+    EXPECT_TRUE(queue.empty());
+  }
+}
+
+TEST(Day2LockFreeTest, QueueHoldsMoveOnlyAndDestroysLeftovers) {
+  auto tracked = std::make_shared<int>(7);
+  {
+    LockFreeQueue<std::unique_ptr<int>> owned(4);
+    EXPECT_TRUE(owned.tryPush(std::make_unique<int>(1)));
+    std::unique_ptr<int> out;
+    ASSERT_TRUE(owned.tryPop(out));
+    EXPECT_EQ(*out, 1);
+
+    LockFreeQueue<std::shared_ptr<int>> shared(4);
+    EXPECT_TRUE(shared.tryPush(tracked));
+    EXPECT_TRUE(shared.tryPush(tracked));
+    EXPECT_EQ(tracked.use_count(), 3);
+  }
+  EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(Day2LockFreeTest, QueueBatchesStopAtFullAndEmpty) {
+  LockFreeQueue<std::string> queue(8);
+  const std::vector<std::string> items = {"a", "b", "c", "d", "e", "f"};
+  EXPECT_EQ(queue.tryPushBatch(items.data(), items.size()), 6u);
+  EXPECT_EQ(queue.tryPushBatch(items.data(), items.size()), 2u);  // Only 2 cells left
+  EXPECT_EQ(queue.tryPushBatch(items.data(), 1), 0u);
+
+  std::vector<std::string> out(16);
+  EXPECT_EQ(queue.tryPopBatch(out.data(), 5), 5u);
+  EXPECT_EQ(out[0], "a");
+  EXPECT_EQ(out[4], "e");
+  EXPECT_EQ(queue.tryPopBatch(out.data(), out.size()), 3u);
+  EXPECT_EQ(out[0], "f");
+  EXPECT_EQ(out[2], "b");
+  EXPECT_EQ(queue.tryPopBatch(out.data(), out.size()), 0u);
+}
+
+namespace {
+
+// Copies throw once the budget runs out; moves never throw.
+struct ThrowingCopy {
+  static inline int copies_left = 0;
+  int value = 0;
+
+  ThrowingCopy() = default;
+  explicit ThrowingCopy(int v) : value(v) {}
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left-- <= 0) throw std::runtime_error("copy failed");
+  }
+  ThrowingCopy(ThrowingCopy&&) noexcept = default;
+  ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+};
+
+}  // namespace
+
+TEST(Day2LockFreeTest, QueueBatchPushThatThrowsClaimsNothing) {
+  LockFreeQueue<ThrowingCopy> queue(8);
+  ThrowingCopy::copies_left = 100;
+  const std::vector<ThrowingCopy> items = {ThrowingCopy(1), ThrowingCopy(2), ThrowingCopy(3),
+                                           ThrowingCopy(4)};
+  ThrowingCopy::copies_left = 2;
+  EXPECT_THROW(queue.tryPushBatch(items.data(), items.size()), std::runtime_error);
+  EXPECT_TRUE(queue.empty());
+
+  ThrowingCopy::copies_left = 100;
+  EXPECT_EQ(queue.tryPushBatch(items.data(), items.size()), 4u);
+  ThrowingCopy out;
+  for (int i = 1; i <= 4; ++i) {
+    ASSERT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out.value, i);
+  }
+  EXPECT_FALSE(queue.tryPop(out));
+}
+
+TEST(Day2LockFreeTest, QueueMpmcDeliversEveryItemOnce) {
+  constexpr int PRODUCERS = 4;
+  constexpr int CONSUMERS = 4;
+  constexpr int PER_PRODUCER = 20000;
+  constexpr int BATCH = 8;
+  LockFreeQueue<int> queue(64);  // Small, so full/empty paths are hit
+  std::vector<std::atomic<int>> seen(PRODUCERS * PER_PRODUCER);
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < PRODUCERS; ++p) {
+    threads.emplace_back([&, p] {
+      const int base = p * PER_PRODUCER;
+      for (int i = 0; i < PER_PRODUCER;) {
+        if (p % 2 == 0) {
+          if (queue.tryPush(base + i)) ++i;
+        } else {
+          int batch[BATCH];
+          const int n = std::min(BATCH, PER_PRODUCER - i);
+          for (int k = 0; k < n; ++k) batch[k] = base + i + k;
+          i += static_cast<int>(queue.tryPushBatch(batch, static_cast<size_t>(n)));
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (int c = 0; c < CONSUMERS; ++c) {
+    threads.emplace_back([&, c] {
+      int batch[BATCH];
+      while (consumed.load() < PRODUCERS * PER_PRODUCER) {
+        size_t n = 0;
+        if (c % 2 == 0) {
+          n = queue.tryPop(batch[0]) ? 1 : 0;
+        } else {
+          n = queue.tryPopBatch(batch, BATCH);
+        }
+        for (size_t k = 0; k < n; ++k) seen[batch[k]].fetch_add(1);
+        consumed.fetch_add(static_cast<int>(n));
+        if (n == 0) std::this_thread::yield();
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  EXPECT_EQ(consumed.load(), PRODUCERS * PER_PRODUCER);
+  int wrong = 0;
+  for (auto& s : seen) wrong += s.load() != 1;
+  EXPECT_EQ(wrong, 0);
+  EXPECT_TRUE(queue.empty());
+}
+
+namespace {
+
+struct Tracked {
+  explicit Tracked(std::atomic<int>* live) : live(live) { live->fetch_add(1); }
+  ~Tracked() { live->fetch_sub(1); }
+  std::atomic<int>* live;
+};
+
+}  // namespace
+
+TEST(Day2LockFreeTest, HazardPointerDefersFreeWhileProtected) {
+  std::atomic<int> live{0};
+  std::atomic<Tracked*> shared{new Tracked(&live)};
+  scanHazards();
+  {
+    HazardPointer hp;
+    Tracked* seen = hp.protect(shared);
+    shared.store(nullptr);
+    retireHazardous(seen);
+    EXPECT_EQ(scanHazards(), 0u);  // Still protected
+    EXPECT_EQ(live.load(), 1);
+    EXPECT_EQ(pendingHazardous(), 1u);
+  }
+  EXPECT_EQ(scanHazards(), 1u);
+  EXPECT_EQ(live.load(), 0);
+  EXPECT_EQ(pendingHazardous(), 0u);
+}
+
+TEST(Day2LockFreeTest, HazardPointerSlotsAreLimitedAndReused) {
+  {
+    HazardPointer a, b, c, d;
+    EXPECT_THROW(HazardPointer e, std::runtime_error);
+  }
+  HazardPointer again;  // Slots returned on destruction
+  SUCCEED();
+}
+
+TEST(Day2LockFreeTest, HazardPointerAdoptsGarbageOfExitedThreads) {
+  std::atomic<int> live{0};
+  std::atomic<Tracked*> shared{new Tracked(&live)};
+  HazardPointer hp;
+  Tracked* mine = hp.protect(shared);
+  std::thread([&] {
+    retireHazardous(shared.exchange(nullptr));  // Protected by this thread
+  }).join();
+  EXPECT_EQ(live.load(), 1);
+  EXPECT_EQ(mine->live, &live);
+  hp.reset();
+  scanHazards();
+  EXPECT_EQ(live.load(), 0);
+}
+
+TEST(Day2LockFreeTest, MichaelScottQueueIsFifoAndUnbounded) {
+  MichaelScottQueue<std::string> queue;
+  std::string value;
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.tryPop(value));
+  for (int i = 0; i < 10000; ++i) queue.push(std::to_string(i));
+  EXPECT_FALSE(queue.empty());
+  for (int i = 0; i < 10000; ++i) {
+    ASSERT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, std::to_string(i));
+  }
+  EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(Day2LockFreeTest, MichaelScottQueueDestroysLeftovers) {
+  std::atomic<int> live{0};
+  {
+    MichaelScottQueue<std::unique_ptr<Tracked>> queue;
+    for (int i = 0; i < 10; ++i) queue.push(std::make_unique<Tracked>(&live));
+    std::unique_ptr<Tracked> out;
+    ASSERT_TRUE(queue.tryPop(out));
+    out.reset();
+    EXPECT_EQ(live.load(), 9);
+  }
+  EXPECT_EQ(live.load(), 0);
+}
+
+TEST(Day2LockFreeTest, MichaelScottQueueMpmcDeliversEveryItemOnce) {
+  constexpr int PRODUCERS = 4;
+  constexpr int CONSUMERS = 4;
+  constexpr int PER_PRODUCER = 20000;
+  MichaelScottQueue<int> queue;
+  std::vector<std::atomic<int>> seen(PRODUCERS * PER_PRODUCER);
+  std::vector<std::vector<int>> order(CONSUMERS);
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < PRODUCERS; ++p) {
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < PER_PRODUCER; ++i) queue.push(p * PER_PRODUCER + i);
+    });
+  }
+  for (int c = 0; c < CONSUMERS; ++c) {
+    threads.emplace_back([&, c] {
+      int value;
+      while (consumed.load() < PRODUCERS * PER_PRODUCER) {
+        if (queue.tryPop(value)) {
+          seen[value].fetch_add(1);
+          order[c].push_back(value);
+          consumed.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  int wrong = 0;
+  for (auto& s : seen) wrong += s.load() != 1;
+  EXPECT_EQ(wrong, 0);
+  // Per-producer FIFO: each consumer sees any one producer's items in order.
+  int reordered = 0;
+  for (const auto& values : order) {
+    std::vector<int> last(PRODUCERS, -1);
+    for (int v : values) {
+      reordered += v <= last[v / PER_PRODUCER];
+      last[v / PER_PRODUCER] = v;
+    }
+  }
+  EXPECT_EQ(reordered, 0);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(Day2LockFreeTest, EpochDefersFreeWhileAnyReaderIsPinned) {
+  std::atomic<int> live{0};
+  EpochDomain domain;
+  EpochParticipant writer(domain);
+  std::atomic<bool> pinned{false};
+  std::atomic<bool> done{false};
+  std::thread reader([&] {
+    EpochParticipant self(domain);
+    EpochGuard guard(self);
+    pinned.store(true);
+    while (!done.load()) std::this_thread::yield();
+  });
+  while (!pinned.load()) std::this_thread::yield();
+
+  writer.retire(new Tracked(&live));
+  for (int i = 0; i < 10; ++i) writer.collect();
+  EXPECT_EQ(live.load(), 1);  // The reader may still hold it
+  EXPECT_EQ(writer.pending(), 1u);
+
+  done.store(true);
+  reader.join();
+  writer.collect();
+  writer.collect();
+  EXPECT_EQ(live.load(), 0);
+  EXPECT_EQ(writer.pending(), 0u);
+}
+
+TEST(Day2LockFreeTest, EpochQsbrWaitsForQuiescentStates) {
+  std::atomic<int> live{0};
+  EpochDomain domain;
+  EpochParticipant writer(domain);
+  EpochParticipant reader(domain);  // Same thread is fine for the protocol
+  reader.online();
+
+  writer.retire(new Tracked(&live));
+  for (int i = 0; i < 10; ++i) writer.collect();
+  EXPECT_EQ(live.load(), 1);  // Online reader has not passed a quiescent state
+
+  for (int i = 0; i < 3; ++i) {
+    reader.quiescent();
+    writer.collect();
+  }
+  EXPECT_EQ(live.load(), 0);
+
+  writer.retire(new Tracked(&live));
+  reader.offline();  // Offline readers never hold references
+  writer.collect();
+  writer.collect();
+  EXPECT_EQ(live.load(), 0);
+}
+
+TEST(Day2LockFreeTest, EpochHandsGarbageOfExitedThreadsToDomain) {
+  std::atomic<int> live{0};
+  {
+    EpochDomain domain;
+    EpochParticipant survivor(domain);
+    {
+      EpochGuard guard(survivor);  // Blocks reclamation while the other exits
+      std::thread([&] {
+        EpochParticipant self(domain);
+        self.retire(new Tracked(&live));
+      }).join();
+      EXPECT_EQ(live.load(), 1);
+    }
+    survivor.collect();
+    survivor.collect();
+    EXPECT_EQ(live.load(), 0);
+
+    EpochGuard guard(survivor);
+    std::thread([&] {
+      EpochParticipant self(domain);
+      self.retire(new Tracked(&live));
+    }).join();
+  }  // The domain frees what is left
+  EXPECT_EQ(live.load(), 0);
+}
+
+TEST(Day2LockFreeTest, EpochReadersNeverSeeFreedNodes) {
+  constexpr int READERS = 3;
+  constexpr int UPDATES = 20000;
+  constexpr int MAGIC = 0x5eed;
+  struct Payload {
+    explicit Payload(std::atomic<int>* live) : tracked(live) {}
+    Tracked tracked;
+    int magic = MAGIC;
+  };
+  std::atomic<int> live{0};
+  std::atomic<int> corrupt{0};
+  {
+    EpochDomain domain;
+    std::atomic<Payload*> current{new Payload(&live)};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+      readers.emplace_back([&, r] {
+        EpochParticipant self(domain);
+        if (r == 0) self.online();  // One QSBR reader, the rest EBR
+        while (!done.load(std::memory_order_relaxed)) {
+          if (r == 0) {
+            corrupt.fetch_add(current.load(std::memory_order_acquire)->magic != MAGIC);
+            self.quiescent();
+          } else {
+            EpochGuard guard(self);
+            corrupt.fetch_add(current.load(std::memory_order_acquire)->magic != MAGIC);
+          }
+        }
+        self.offline();
+      });
+    }
+    EpochParticipant writer(domain);
+    for (int i = 0; i < UPDATES; ++i) {
+      Payload* old = current.exchange(new Payload(&live), std::memory_order_acq_rel);
+      writer.retire(old);
+      // Lets an online QSBR reader run even on a single core; otherwise
+      // it can stay descheduled (and block reclamation) for the whole loop.
+      if (i % 256 == 0) std::this_thread::yield();
+    }
+    done.store(true);
+    for (auto& t : readers) t.join();
+    EXPECT_LT(writer.pending(), static_cast<size_t>(UPDATES));  // Reclaimed as it went
+    delete current.load();
+  }
+  EXPECT_EQ(corrupt.load(), 0);
+  EXPECT_EQ(live.load(), 0);
+}
+
+TEST(Day2LockFreeTest, SkipListBasicOperations) {
+  ConcurrentSkipList<int, std::string> list;
+  EXPECT_TRUE(list.insert(5, "five"));
+  EXPECT_TRUE(list.insert(1, "one"));
+  EXPECT_TRUE(list.insert(9, "nine"));
+  EXPECT_FALSE(list.insert(5, "again"));
+  EXPECT_EQ(list.size(), 3u);
+
+  std::string value;
+  ASSERT_TRUE(list.find(5, value));
+  EXPECT_EQ(value, "five");
+  EXPECT_FALSE(list.find(4, value));
+  EXPECT_TRUE(list.contains(9));
+
+  EXPECT_TRUE(list.erase(5));
+  EXPECT_FALSE(list.erase(5));
+  EXPECT_FALSE(list.contains(5));
+  EXPECT_TRUE(list.insert(5, "new five"));
+  ASSERT_TRUE(list.find(5, value));
+  EXPECT_EQ(value, "new five");
+  EXPECT_EQ(list.size(), 3u);
+}
+
+TEST(Day2LockFreeTest, SkipListRangesAreOrdered) {
+  ConcurrentSkipList<int, int, std::greater<int>> descending;
+  for (int i = 0; i < 1000; ++i) descending.insert((i * 7919) % 1000, i);
+  std::vector<int> keys;
+  descending.forEachInRange(600, 500, [&](int key, int) { keys.push_back(key); });
+  ASSERT_EQ(keys.size(), 100u);
+  for (size_t i = 0; i < keys.size(); ++i) EXPECT_EQ(keys[i], 600 - static_cast<int>(i));
+}
+
+TEST(Day2LockFreeTest, SkipListReclaimsErasedNodes) {
+  std::atomic<int> live{0};
+  {
+    ConcurrentSkipList<int, std::shared_ptr<Tracked>> list;
+    for (int i = 0; i < 100; ++i) list.insert(i, std::make_shared<Tracked>(&live));
+    for (int i = 0; i < 100; i += 2) list.erase(i);
+    for (int i = 0; i < 3; ++i) localEpochParticipant().collect();
+    EXPECT_EQ(live.load(), 50);
+  }
+  EXPECT_EQ(live.load(), 0);
+}
+
+TEST(Day2LockFreeTest, SkipListConcurrentUpdatesAndScans) {
+  constexpr int THREADS = 4;
+  constexpr int PER_THREAD = 5000;
+  constexpr int STABLE = 1000;  // Keys [0, STABLE) are never erased
+  ConcurrentSkipList<int, int> list;
+  for (int k = 0; k < STABLE; ++k) list.insert(k, k);
+
+  std::atomic<bool> done{false};
+  std::atomic<int> bad_scans{0};
+  std::thread scanner([&] {
+    while (!done.load()) {
+      int previous = -1;
+      int stable_seen = 0;
+      bool ordered = true;
+      list.forEachInRange(0, 1 << 30, [&](int key, int value) {
+        ordered = ordered && key > previous && value == key;
+        previous = key;
+        stable_seen += key < STABLE;
+      });
+      if (!ordered || stable_seen != STABLE) bad_scans.fetch_add(1);
+    }
+  });
+
+  std::vector<std::thread> writers;
+  for (int t = 0; t < THREADS; ++t) {
+    writers.emplace_back([&, t] {
+      // Interleaved keys so threads contend on neighbouring nodes.
+      for (int i = 0; i < PER_THREAD; ++i) {
+        const int key = STABLE + i * THREADS + t;
+        EXPECT_TRUE(list.insert(key, key));
+        if (i % 2 == 1) {
+          EXPECT_TRUE(list.erase(key - THREADS));
+        }
+      }
+    });
+  }
+  for (auto& w : writers) w.join();
+  done.store(true);
+  scanner.join();
+
+  EXPECT_EQ(bad_scans.load(), 0);
+  EXPECT_EQ(list.size(), static_cast<size_t>(STABLE + THREADS * PER_THREAD / 2));
+  for (int t = 0; t < THREADS; ++t) {
+    for (int i = 0; i < PER_THREAD; ++i) {
+      const int key = STABLE + i * THREADS + t;
+      EXPECT_EQ(list.contains(key), i % 2 == 1) << key;
+    }
+  }
+}
+
+// Every field carries the same stamp, so a torn copy is easy to spot.
+template <size_t N>
+struct Stamped {
+  uint64_t fields[N];
+  explicit Stamped(uint64_t stamp = 0) {
+    for (auto& f : fields) f = stamp;
+  }
+  bool consistent() const {
+    for (auto f : fields) {
+      if (f != fields[0]) return false;
+    }
+    return true;
+  }
+};
+
+template <typename Lock>
+void expectNoTornSnapshots(Lock& lock) {
+  constexpr uint64_t WRITES = 20000;
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+  std::atomic<int> backwards{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      uint64_t last = 0;
+      while (!done.load()) {
+        const auto snapshot = lock.load();
+        if (!snapshot.consistent()) torn.fetch_add(1);
+        if (snapshot.fields[0] < last) backwards.fetch_add(1);
+        last = snapshot.fields[0];
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= WRITES; ++i) {
+    lock.store(decltype(lock.load())(i));
+    if (i % 256 == 0) std::this_thread::yield();
+  }
+  done.store(true);
+  for (auto& r : readers) r.join();
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(backwards.load(), 0);
+  EXPECT_EQ(lock.load().fields[0], WRITES);
+  EXPECT_EQ(lock.version(), WRITES);
+}
+
+TEST(Day2LockFreeTest, SeqLockStoresAndLoads) {
+  struct Odd {
+    char tag[11];
+    int8_t value;
+  };
+  static_assert(sizeof(Odd) % 8 != 0);
+  SeqLock<Odd> lock(Odd{"initial", 7});
+  EXPECT_EQ(lock.version(), 0u);
+  EXPECT_EQ(lock.load().value, 7);
+  lock.store(Odd{"updated", 42});
+  Odd out{};
+  ASSERT_TRUE(lock.tryLoad(out));
+  EXPECT_STREQ(out.tag, "updated");
+  EXPECT_EQ(out.value, 42);
+  EXPECT_EQ(lock.version(), 1u);
+}
+
+TEST(Day2LockFreeTest, SeqLockReadersNeverSeeTornValues) {
+  SeqLock<Stamped<8>> lock;
+  expectNoTornSnapshots(lock);
+}
+
+TEST(Day2LockFreeTest, DoubleBufferReportsVersionOfValue) {
+  VersionedDoubleBuffer<Stamped<4>> buffer(Stamped<4>(100));
+  uint64_t version = 99;
+  EXPECT_EQ(buffer.load(&version).fields[0], 100u);
+  EXPECT_EQ(version, 0u);
+  for (uint64_t i = 1; i <= 5; ++i) buffer.store(Stamped<4>(100 + i));
+  EXPECT_EQ(buffer.load(&version).fields[0], 105u);
+  EXPECT_EQ(version, 5u);
+}
+
+TEST(Day2LockFreeTest, DoubleBufferVersionMatchesValueUnderWrites) {
+  constexpr uint64_t WRITES = 50000;
+  VersionedDoubleBuffer<Stamped<2>> buffer;  // Version v holds stamp v
+  std::atomic<bool> done{false};
+  std::atomic<int> mismatched{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        uint64_t version = 0;
+        if (buffer.load(&version).fields[0] != version) mismatched.fetch_add(1);
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= WRITES; ++i) buffer.store(Stamped<2>(i));
+  done.store(true);
+  for (auto& r : readers) r.join();
+  EXPECT_EQ(mismatched.load(), 0);
+}
+
+TEST(Day2LockFreeTest, DoubleBufferReadersNeverSeeTornValues) {
+  VersionedDoubleBuffer<Stamped<64>> buffer;
+  expectNoTornSnapshots(buffer);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,10 +1,274 @@
 #include "simd_ops.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
 TEST(Day5OptimizationTest, Placeholder) { 
   EXPECT_TRUE(true); 
 }
 
+// Restores the dispatched level when a test is done with it.
+class ScopedSimdLevel {
+ public:
+  ScopedSimdLevel() : saved_(activeSimdLevel()) {}
+  ~ScopedSimdLevel() { setSimdLevel(saved_); }
+
+ private:
+  SimdLevel saved_;
+};
+
+std::vector<SimdLevel> supportedLevels() {
+  std::vector<SimdLevel> levels;
+  for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (level <= detectSimdLevel()) levels.push_back(level);
+  }
+  return levels;
+}
+
+// Deterministic values in [-4, 4), varied enough to catch lane mix-ups.
+std::vector<float> testData(size_t size, uint32_t seed) {
+  std::vector<float> data(size);
+  for (auto& x : data) {
+    seed = seed * 1664525u + 1013904223u;
+    x = static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 8.0f - 4.0f;
+  }
+  return data;
+}
+
+TEST(Day5OptimizationTest, SimdDispatchSelectsSupportedLevels) {
+  ScopedSimdLevel restore;
+  EXPECT_EQ(activeSimdLevel(), detectSimdLevel());
+  EXPECT_TRUE(setSimdLevel(SimdLevel::SCALAR));
+  EXPECT_EQ(activeSimdLevel(), SimdLevel::SCALAR);
+  if (detectSimdLevel() < SimdLevel::AVX512) {
+    EXPECT_FALSE(setSimdLevel(SimdLevel::AVX512));
+    EXPECT_EQ(activeSimdLevel(), SimdLevel::SCALAR);
+  }
+  EXPECT_STREQ(simdLevelName(SimdLevel::AVX2), "avx2");
+}
+
+TEST(Day5OptimizationTest, SimdElementwiseMatchesScalarForAnyAlignment) {
+  ScopedSimdLevel restore;
+  constexpr size_t PAD = 4;
+  constexpr float GUARD = 12345.0f;
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    for (size_t size : {0u, 1u, 3u, 7u, 8u, 15u, 16u, 17u, 31u, 33u, 64u, 100u}) {
+      for (size_t offset = 0; offset < PAD; ++offset) {
+        // Inputs and output misaligned by different amounts.
+        const auto a = testData(size + PAD, 1);
+        const auto b = testData(size + PAD, 2);
+        const auto c = testData(size + PAD, 3);
+        const float* pa = a.data() + offset;
+        const float* pb = b.data() + (offset + 1) % PAD;
+        const float* pc = c.data() + (offset + 2) % PAD;
+        std::vector<float> out(size + 2 * PAD, GUARD);
+        float* result = out.data() + PAD + offset % 3;
+        const auto checkGuards = [&] {
+          for (const float* p = out.data(); p < result; ++p) ASSERT_EQ(*p, GUARD);
+          for (const float* p = result + size; p < out.data() + out.size(); ++p) {
+            ASSERT_EQ(*p, GUARD);
+          }
+        };
+
+        vectorAdd(pa, pb, result, size);
+        for (size_t i = 0; i < size; ++i) ASSERT_EQ(result[i], pa[i] + pb[i]) << i;
+        checkGuards();
+        vectorMultiply(pa, pb, result, size);
+        for (size_t i = 0; i < size; ++i) ASSERT_EQ(result[i], pa[i] * pb[i]) << i;
+        checkGuards();
+        vectorFma(pa, pb, pc, result, size);
+        for (size_t i = 0; i < size; ++i) {
+          ASSERT_NEAR(result[i], std::fma(pa[i], pb[i], pc[i]), 1e-5f) << simdLevelName(level);
+        }
+        checkGuards();
+      }
+    }
+  }
+}
+
+TEST(Day5OptimizationTest, SimdElementwiseAllowsInPlaceOutput) {
+  ScopedSimdLevel restore;
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    auto a = testData(37, 4);
+    const auto b = testData(37, 5);
+    const auto expected = [&] {
+      std::vector<float> sum(a.size());
+      for (size_t i = 0; i < a.size(); ++i) sum[i] = a[i] + b[i];
+      return sum;
+    }();
+    vectorAdd(a.data(), b.data(), a.data(), a.size());
+    EXPECT_EQ(a, expected) << simdLevelName(level);
+  }
+}
+
+TEST(Day5OptimizationTest, SimdReductionsMatchScalar) {
+  ScopedSimdLevel restore;
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    for (size_t size : {1u, 5u, 16u, 63u, 64u, 65u, 1000u}) {
+      for (size_t offset = 0; offset < 3; ++offset) {
+        const auto a = testData(size + offset, 6);
+        const auto b = testData(size + offset, 7);
+        const float* pa = a.data() + offset;
+        const float* pb = b.data();
+        double sum = 0.0, dot = 0.0, abs_sum = 0.0, abs_dot = 0.0;
+        float lo = pa[0], hi = pa[0];
+        for (size_t i = 0; i < size; ++i) {
+          sum += pa[i];
+          dot += static_cast<double>(pa[i]) * pb[i];
+          abs_sum += std::fabs(pa[i]);
+          abs_dot += std::fabs(pa[i] * pb[i]);
+          lo = std::min(lo, pa[i]);
+          hi = std::max(hi, pa[i]);
+        }
+        // Reassociation error grows with the sum of magnitudes.
+        EXPECT_NEAR(vectorSum(pa, size), sum, 1e-6 * abs_sum + 1e-6) << simdLevelName(level);
+        EXPECT_NEAR(dotProduct(pa, pb, size), dot, 1e-6 * abs_dot + 1e-6);
+        EXPECT_EQ(vectorMin(pa, size), lo) << size;
+        EXPECT_EQ(vectorMax(pa, size), hi) << size;
+      }
+    }
+    const float one = 1.0f;
+    EXPECT_EQ(vectorSum(&one, 0), 0.0f);
+    EXPECT_EQ(dotProduct(&one, &one, 0), 0.0f);
+    EXPECT_EQ(vectorMin(&one, 0), std::numeric_limits<float>::infinity());
+    EXPECT_EQ(vectorMax(&one, 0), -std::numeric_limits<float>::infinity());
+  }
+}
+
+TEST(Day5OptimizationTest, SimdMinMaxSkipNaN) {
+  ScopedSimdLevel restore;
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    for (size_t size : {1u, 5u, 16u, 63u, 64u, 65u, 1000u}) {
+      // NaN in every position class: first, vector lanes, masked tail, last.
+      for (size_t nan_at : {size_t{0}, size / 2, size - 1}) {
+        auto a = testData(size, 8);
+        a[nan_at] = nan;
+        if (size > 17) a[17] = nan;
+        float lo = inf, hi = -inf;
+        for (float x : a) {
+          if (std::isnan(x)) continue;
+          lo = std::min(lo, x);
+          hi = std::max(hi, x);
+        }
+        EXPECT_EQ(vectorMin(a.data(), size), lo) << simdLevelName(level) << " " << size;
+        EXPECT_EQ(vectorMax(a.data(), size), hi) << simdLevelName(level) << " " << size;
+      }
+    }
+    const std::vector<float> all_nan(37, nan);
+    EXPECT_EQ(vectorMin(all_nan.data(), all_nan.size()), inf) << simdLevelName(level);
+    EXPECT_EQ(vectorMax(all_nan.data(), all_nan.size()), -inf) << simdLevelName(level);
+  }
+}
+
+// |got - expected| in units of the last place of expected.
+double ulpError(double got, long double expected) {
+  const double rounded = static_cast<double>(expected);
+  if (got == rounded) return 0.0;
+  const double ulp = std::nextafter(std::fabs(rounded), std::numeric_limits<double>::infinity()) -
+                     std::fabs(rounded);
+  return static_cast<double>(std::fabs(static_cast<long double>(got) - expected) / ulp);
+}
+
+// Max ulp error of kernel over uniform samples from [lo, hi).
+double maxUlpError(void (*kernel)(const double*, double*, size_t),
+                   long double (*reference)(long double), double lo, double hi) {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(lo, hi);
+  std::vector<double> x(1 << 15), y(x.size());
+  for (auto& v : x) v = dist(rng);
+  kernel(x.data(), y.data(), x.size());
+  double worst = 0.0;
+  for (size_t i = 0; i < x.size(); ++i) worst = std::max(worst, ulpError(y[i], reference(x[i])));
+  return worst;
+}
+
+long double expReference(long double x) { return expl(x); }
+long double logReference(long double x) { return logl(x); }
+long double erfReference(long double x) { return erfl(x); }
+long double normalCdfReference(long double x) { return 0.5L * erfcl(-x / sqrtl(2.0L)); }
+
+TEST(Day5OptimizationTest, SimdMathStaysWithinDocumentedUlps) {
+  ScopedSimdLevel restore;
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    SCOPED_TRACE(simdLevelName(level));
+    EXPECT_LE(maxUlpError(vectorExp, expReference, -745.0, 709.0), 1.3);
+    EXPECT_LE(maxUlpError(vectorExp, expReference, -1.0, 1.0), 1.3);
+    EXPECT_LE(maxUlpError(vectorLog, logReference, 1e-300, 1e300), 1.0);
+    EXPECT_LE(maxUlpError(vectorLog, logReference, 0.5, 2.0), 1.0);
+    EXPECT_LE(maxUlpError(vectorErf, erfReference, -6.5, 6.5), 2.0);
+    EXPECT_LE(maxUlpError(vectorErf, erfReference, -1.5, 1.5), 2.0);
+    EXPECT_LE(maxUlpError(vectorNormalCdf, normalCdfReference, -37.5, 9.0), 6.0);
+    EXPECT_LE(maxUlpError(vectorNormalCdf, normalCdfReference, -2.0, 2.0), 6.0);
+  }
+}
+
+TEST(Day5OptimizationTest, SimdMathHandlesSpecialValues) {
+  ScopedSimdLevel restore;
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  constexpr double NAN_VALUE = std::numeric_limits<double>::quiet_NaN();
+  constexpr double SUBNORMAL = std::numeric_limits<double>::denorm_min();
+  const std::vector<double> x = {INF, -INF, NAN_VALUE, 0.0, -1.0, 709.79, -745.0, SUBNORMAL};
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    SCOPED_TRACE(simdLevelName(level));
+    std::vector<double> y(x.size());
+
+    vectorExp(x.data(), y.data(), x.size());
+    EXPECT_EQ(y[0], INF);
+    EXPECT_EQ(y[1], 0.0);
+    EXPECT_TRUE(std::isnan(y[2]));
+    EXPECT_EQ(y[3], 1.0);
+    EXPECT_EQ(y[5], INF);
+    EXPECT_EQ(y[6], SUBNORMAL);  // exp(-745) rounds to the smallest subnormal
+
+    vectorLog(x.data(), y.data(), x.size());
+    EXPECT_EQ(y[0], INF);
+    EXPECT_TRUE(std::isnan(y[1]));
+    EXPECT_TRUE(std::isnan(y[2]));
+    EXPECT_EQ(y[3], -INF);
+    EXPECT_TRUE(std::isnan(y[4]));
+    EXPECT_DOUBLE_EQ(y[7], std::log(SUBNORMAL));
+
+    vectorErf(x.data(), y.data(), x.size());
+    EXPECT_EQ(y[0], 1.0);
+    EXPECT_EQ(y[1], -1.0);
+    EXPECT_TRUE(std::isnan(y[2]));
+    EXPECT_EQ(y[3], 0.0);
+
+    vectorNormalCdf(x.data(), y.data(), x.size());
+    EXPECT_EQ(y[0], 1.0);
+    EXPECT_EQ(y[1], 0.0);
+    EXPECT_TRUE(std::isnan(y[2]));
+    EXPECT_EQ(y[3], 0.5);
+  }
+}
+
+TEST(Day5OptimizationTest, SimdMathCoversTailsAndAliasing) {
+  ScopedSimdLevel restore;
+  for (SimdLevel level : supportedLevels()) {
+    ASSERT_TRUE(setSimdLevel(level));
+    for (size_t size = 0; size <= 37; ++size) {
+      std::vector<double> x(size);
+      for (size_t i = 0; i < size; ++i) x[i] = 0.25 * static_cast<double>(i) - 3.0;
+      std::vector<double> expected(size);
+      for (size_t i = 0; i < size; ++i) expected[i] = std::exp(x[i]);
+      vectorExp(x.data(), x.data(), size);  // In place
+      for (size_t i = 0; i < size; ++i) ASSERT_NEAR(x[i], expected[i], 4e-16 * expected[i]) << i;
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();